@@ -10,6 +10,7 @@
 
 #include <fstream>
 #include "CGRA.h"
+#include "Log.h"
 #include "json.hpp"
 
 using json = nlohmann::json;
@@ -24,6 +25,13 @@ CGRA::CGRA(int t_rows, int t_columns, std::string t_vectorizationMode,
   m_supportDVFS = t_supportDVFS;
   m_DVFSIslandDim = t_DVFSIslandDim;
   m_supportInclusive = enableMultipleOps;
+  m_vectorizationMode = t_vectorizationMode;
+  m_fusionStrategy = t_fusionStrategy;
+  m_parameterizableCGRA = t_parameterizableCGRA;
+  m_additionalFunc = t_additionalFunc;
+  m_regConstraint = -1;
+  m_ctrlMemConstraint = -1;
+  m_bypassConstraint = -1;
   m_supportComplex = new list<string>();
   m_supportCall = new list<string>();
   nodes = new CGRANode**[t_rows];
@@ -95,9 +103,9 @@ CGRA::CGRA(int t_rows, int t_columns, std::string t_vectorizationMode,
         } else {
           id2Node[nodeID]->disableAllFUs();
           auto supportedFUs = param["tiles"][to_string(nodeID)]["supportedFUs"];
-          cout << "Node " << nodeID << " supports: ";
+          CGRA_LOG(LOG_MRRG, LOG_INFO) << "Node " << nodeID << " supports: ";
           for (const auto& fu : supportedFUs) {
-            cout << fu << " ";
+            CGRA_LOG(LOG_MRRG, LOG_INFO) << fu << " ";
             if (fu == "Add") {
               id2Node[nodeID]->enableAdd();
             } else if (fu == "Br") {
@@ -124,7 +132,7 @@ CGRA::CGRA(int t_rows, int t_columns, std::string t_vectorizationMode,
               id2Node[nodeID]->enableStore();
             }
           }
-          cout << " \n " << endl;
+          CGRA_LOG(LOG_MRRG, LOG_INFO) << " \n \n";
         }
 	if (param["tiles"][to_string(nodeID)].contains("accessMem")) {
 	  if (param["tiles"][to_string(nodeID)]["accessMem"]) {
@@ -200,13 +208,13 @@ CGRA::CGRA(int t_rows, int t_columns, std::string t_vectorizationMode,
       }
     }
     if (storeCount == 0) {
-      cout<<"Without customization in param.json, we enable store functionality on the left most column."<<endl;
+      CGRA_LOG(LOG_MRRG, LOG_INFO)<<"Without customization in param.json, we enable store functionality on the left most column.\n";
       for (int r=0; r<t_rows; ++r) {
         nodes[r][0]->enableStore();
       }
     }
     if (loadCount == 0) {
-      cout<<"Without customization in param.json, we enable load functionality on the left most column."<<endl;
+      CGRA_LOG(LOG_MRRG, LOG_INFO)<<"Without customization in param.json, we enable load functionality on the left most column.\n";
       for (int r=0; r<t_rows; ++r) {
         nodes[r][0]->enableLoad();
       }
@@ -237,7 +245,7 @@ CGRA::CGRA(int t_rows, int t_columns, std::string t_vectorizationMode,
       }
     } else {
       // "none" or else will be treated as none.
-      cout<<"No vectorization is enabled on the CGRA nodes."<<endl;
+      CGRA_LOG(LOG_MRRG, LOG_INFO)<<"No vectorization is enabled on the CGRA nodes.\n";
     }
 
     // Enable the heterogeneity.
@@ -294,6 +302,22 @@ CGRA::CGRA(int t_rows, int t_columns, std::string t_vectorizationMode,
     disableSpecificConnections();
   }
 
+  initCapabilityIndex();
+
+  m_undoLog = new UndoLog();
+  m_arena = new MRRGArena();
+  for (int i=0; i<t_rows; ++i) {
+    for (int j=0; j<t_columns; ++j) {
+      nodes[i][j]->initNeighbors();
+      nodes[i][j]->setUndoLog(m_undoLog);
+      nodes[i][j]->setArena(m_arena);
+    }
+  }
+  for (int i=0; i<m_LinkCount; ++i) {
+    links[i]->setUndoLog(m_undoLog);
+    links[i]->setArena(m_arena);
+  }
+
   if (t_supportDVFS) {
     for (int r=0; r<t_rows; ++r) {
       for (int c=0; c<t_columns; ++c) {
@@ -358,6 +382,97 @@ list<string>* CGRA::getSupportCall() {
     return m_supportCall;
 }
 
+void CGRA::initCapabilityIndex() {
+  int words = (m_rows * m_columns + 63) / 64;
+  m_capabilityIndex.clear();
+  for (int i=0; i<m_rows; ++i) {
+    for (int j=0; j<m_columns; ++j) {
+      CGRANode* tile = nodes[i][j];
+      if (tile->isDisabled())
+        continue;
+      list<string> capabilities;
+      // Every enabled tile has the "tile" capability.
+      capabilities.push_back("tile");
+      if (tile->canLoad()) capabilities.push_back("load");
+      if (tile->canStore()) capabilities.push_back("store");
+      if (tile->canReturn()) capabilities.push_back("return");
+      if (tile->supportVectorization()) capabilities.push_back("vectorization");
+      if (tile->canAdd()) capabilities.push_back("add");
+      if (tile->canMul()) capabilities.push_back("mul");
+      if (tile->canPhi()) capabilities.push_back("phi");
+      if (tile->canSel()) capabilities.push_back("sel");
+      if (tile->canMAC()) capabilities.push_back("mac");
+      if (tile->canLogic()) capabilities.push_back("logic");
+      if (tile->canBr()) capabilities.push_back("br");
+      if (tile->canCmp()) capabilities.push_back("cmp");
+      if (tile->canDiv()) capabilities.push_back("div");
+      for (string func: *(tile->getCallFuncs())) {
+        capabilities.push_back("call-" + func);
+      }
+      if (tile->supportComplex()) capabilities.push_back("complex-");
+      for (string type: *(tile->getComplexTypes())) {
+        capabilities.push_back("complex-" + type);
+      }
+      int position = i * m_columns + j;
+      for (string capability: capabilities) {
+        if (m_capabilityIndex.find(capability) == m_capabilityIndex.end()) {
+          m_capabilityIndex[capability] = vector<uint64_t>(words, 0);
+        }
+        m_capabilityIndex[capability][position / 64] |= (uint64_t)1 << (position % 64);
+      }
+    }
+  }
+}
+
+// Mirrors the checks of CGRANode::canSupport().
+void CGRA::getRequiredCapabilities(DFGNode* t_opt, vector<string>* t_capabilities) {
+  t_capabilities->push_back("tile");
+  string call_f = t_opt->isCall();
+  if (call_f.compare("None")) t_capabilities->push_back("call-" + call_f);
+  string complex_f = t_opt->getComplexType();
+  if (complex_f.compare("None")) t_capabilities->push_back("complex-" + complex_f);
+  if (t_opt->isLoad()) t_capabilities->push_back("load");
+  if (t_opt->isStore()) t_capabilities->push_back("store");
+  if (t_opt->isReturn()) t_capabilities->push_back("return");
+  if (t_opt->isVectorized()) t_capabilities->push_back("vectorization");
+  if (t_opt->isAddSub()) t_capabilities->push_back("add");
+  if (t_opt->isMul()) t_capabilities->push_back("mul");
+  if (t_opt->isPhi()) t_capabilities->push_back("phi");
+  if (t_opt->isSel()) t_capabilities->push_back("sel");
+  if (t_opt->isMAC()) t_capabilities->push_back("mac");
+  if (t_opt->isLogic()) t_capabilities->push_back("logic");
+  if (t_opt->isBranch()) t_capabilities->push_back("br");
+  if (t_opt->isCmp()) t_capabilities->push_back("cmp");
+  if (t_opt->isDiv()) t_capabilities->push_back("div");
+}
+
+void CGRA::getSupportingNodes(DFGNode* t_opt, vector<CGRANode*>* t_tiles) {
+  t_tiles->clear();
+  vector<string> capabilities;
+  getRequiredCapabilities(t_opt, &capabilities);
+  vector<uint64_t> mask;
+  for (string capability: capabilities) {
+    map<string, vector<uint64_t>>::iterator it = m_capabilityIndex.find(capability);
+    if (it == m_capabilityIndex.end())
+      return;
+    if (mask.empty()) {
+      mask = it->second;
+    } else {
+      for (int w=0; w<(int)mask.size(); ++w) {
+        mask[w] &= it->second[w];
+      }
+    }
+  }
+  for (int w=0; w<(int)mask.size(); ++w) {
+    uint64_t bits = mask[w];
+    while (bits != 0) {
+      int position = w * 64 + __builtin_ctzll(bits);
+      t_tiles->push_back(nodes[position / m_columns][position % m_columns]);
+      bits &= bits - 1;
+    }
+  }
+}
+
 void CGRA::disableSpecificConnections() {
 //  nodes[0][0]->disable();
 //  nodes[0][1]->disable();
@@ -386,18 +501,51 @@ void CGRA::disableSpecificConnections() {
 
 }
 
+CGRA::~CGRA() {
+  for (int i=0; i<m_rows; ++i) {
+    for (int j=0; j<m_columns; ++j)
+      delete nodes[i][j];
+    delete[] nodes[i];
+  }
+  delete[] nodes;
+  for (int i=0; i<m_LinkCount; ++i)
+    delete links[i];
+  delete[] links;
+  delete m_supportComplex;
+  delete m_supportCall;
+  delete m_undoLog;
+  delete m_arena;
+}
+
+CGRA* CGRA::clone() {
+  CGRA* cgra = new CGRA(m_rows, m_columns, m_vectorizationMode,
+                        m_fusionStrategy, m_parameterizableCGRA,
+                        m_additionalFunc, m_supportDVFS, m_DVFSIslandDim,
+                        m_supportInclusive);
+  if (m_regConstraint != -1)
+    cgra->setRegConstraint(m_regConstraint);
+  if (m_ctrlMemConstraint != -1)
+    cgra->setCtrlMemConstraint(m_ctrlMemConstraint);
+  if (m_bypassConstraint != -1)
+    cgra->setBypassConstraint(m_bypassConstraint);
+  return cgra;
+}
+
 void CGRA::setRegConstraint(int t_regConstraint) {
+  m_regConstraint = t_regConstraint;
   for (int i=0; i<m_rows; ++i)
     for (int j=0; j<m_columns; ++j)
       nodes[i][j]->setRegConstraint(t_regConstraint);
 }
 
 void CGRA::setBypassConstraint(int t_bypassConstraint) {
+  m_bypassConstraint = t_bypassConstraint;
   for (int i=0; i<m_LinkCount; ++i)
     links[i]->setBypassConstraint(t_bypassConstraint);
 }
 
 void CGRA::setCtrlMemConstraint(int t_ctrlMemConstraint) {
+  m_ctrlMemConstraint = t_ctrlMemConstraint;
   for (int i=0; i<m_rows; ++i)
     for (int j=0; j<m_columns; ++j)
       nodes[i][j]->setCtrlMemConstraint(t_ctrlMemConstraint);
@@ -411,6 +559,9 @@ int CGRA::getFUCount() {
 }
 
 void CGRA::constructMRRG(int t_II) {
+  m_undoLog->clear();
+  // Releases the MRRG of the previous II at once.
+  m_arena->reset();
   for (int i=0; i<m_rows; ++i)
     for (int j=0; j<m_columns; ++j)
       nodes[i][j]->constructMRRG(m_FUCount, t_II);
@@ -418,6 +569,14 @@ void CGRA::constructMRRG(int t_II) {
     links[i]->constructMRRG(m_FUCount, t_II);
 }
 
+UndoLog* CGRA::getUndoLog() {
+  return m_undoLog;
+}
+
+MRRGArena* CGRA::getArena() {
+  return m_arena;
+}
+
 CGRALink* CGRA::getLink(CGRANode* t_n1, CGRANode* t_n2) {
    for (int i=0; i<m_LinkCount; ++i) {
      if (links[i]->getSrc()==t_n1 and links[i]->getDst() == t_n2) {
@@ -442,7 +601,7 @@ void CGRA::syncDVFSIsland(CGRANode* t_node) {
   for (auto& nodeWithinIsland : m_DVFSIslands[islandID]) {
     nodeWithinIsland->setDVFSLatencyMultiple(t_node->getDVFSLatencyMultiple());
     nodeWithinIsland->syncDVFS();
-    cout << "[cheng] synced for node: " << nodeWithinIsland->getID() << "; check synced: " << nodeWithinIsland->isSynced() << "; addr: " << nodeWithinIsland << endl;
+    CGRA_LOG(LOG_DVFS, LOG_DEBUG) << "[cheng] synced for node: " << nodeWithinIsland->getID() << "; check synced: " << nodeWithinIsland->isSynced() << "; addr: " << nodeWithinIsland << "\n";
   }
 }
 
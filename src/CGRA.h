@@ -12,10 +12,9 @@
 #include "CGRANode.h"
 #include "CGRALink.h"
 #include <iostream>
+#include <cstdint>
 //#include <llvm/Support/raw_ostream.h>
 
-using namespace llvm;
-
 class CGRA {
   private:
     int m_FUCount;
@@ -28,16 +27,39 @@ class CGRA {
     map<int, vector<CGRANode*>> m_DVFSIslands;
     list<string>* m_supportComplex;
     list<string>* m_supportCall;
+    UndoLog* m_undoLog;
+    MRRGArena* m_arena;
+    // The architecture parameters and constraints, kept for clone().
+    string m_vectorizationMode;
+    list<string>* m_fusionStrategy;
+    bool m_parameterizableCGRA;
+    map<string, list<int>*>* m_additionalFunc;
+    int m_regConstraint;
+    int m_ctrlMemConstraint;
+    int m_bypassConstraint;
+    // Capability index, i.e., the tiles supporting each functionality
+    // (e.g., "load", "call-<func>", "complex-<pattern>") as a bitmask over
+    // the row-major tile positions, built once the tiles are configured.
+    map<string, vector<uint64_t>> m_capabilityIndex;
     void disableSpecificConnections();
+    void initCapabilityIndex();
+    void getRequiredCapabilities(DFGNode*, vector<string>*);
 
   public:
     CGRA(int, int, std::string, list<string>*, bool, map<string, list<int>*>*, bool, int, bool=true);
+    ~CGRA();
+    // Creates a CGRA of the same architecture and constraints with an
+    // idle MRRG, e.g., to map different IIs concurrently.
+    CGRA* clone();
     CGRANode ***nodes;
     CGRALink **links;
     int getFUCount();
     int getLinkCount();
     void getRoutingResource();
     void constructMRRG(int);
+    // The journal of the writes to the MRRG, see UndoLog.
+    UndoLog* getUndoLog();
+    MRRGArena* getArena();
     int getRows() { return m_rows; }
     int getColumns() { return m_columns; }
     CGRALink* getLink(CGRANode*, CGRANode*);
@@ -50,6 +72,9 @@ class CGRA {
     void syncDVFSIsland(CGRANode*);
     list<string>* getSupportComplex();
     list<string>* getSupportCall();
+    // Fills the caller's buffer with the tiles (in row-major order) that
+    // can support the DFG node, the same ones CGRANode::canSupport() accepts.
+    void getSupportingNodes(DFGNode*, vector<CGRANode*>*);
     bool getSupportInclusive();
 };
 
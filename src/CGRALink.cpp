@@ -9,18 +9,27 @@
  */
 
 #include "CGRALink.h"
+#include "Counters.h"
+#include "Log.h"
 #include <assert.h>
 
 CGRALink::CGRALink(int t_linkId) {
   setID(t_linkId);
   m_currentCtrlMemItems = 0;
-  m_occupied = new bool[1];
-  m_dfgNodes = new DFGNode*[1];
-  m_bypassed = new bool[1];
-  m_generatedOut = new bool[1];
-  m_arrived = new bool[1];
+  m_II = 1;
   m_disabled = false;
   m_mapped = false;
+  m_undoLog = NULL;
+  m_arena = NULL;
+  m_slots = NULL;
+}
+
+void CGRALink::setUndoLog(UndoLog* t_undoLog) {
+  m_undoLog = t_undoLog;
+}
+
+void CGRALink::setArena(MRRGArena* t_arena) {
+  m_arena = t_arena;
 }
 
 void CGRALink::setCtrlMemConstraint(int t_ctrlMemConstraint) {
@@ -59,27 +68,21 @@ bool CGRALink::isMapped() {
 
 void CGRALink::constructMRRG(int t_CGRANodeCount, int t_II) {
   m_II = t_II;
-  m_cycleBoundary = t_CGRANodeCount*t_II*t_II;
-  delete[] m_occupied;
-  m_occupied = new bool[m_cycleBoundary];
-  delete[] m_dfgNodes;
-  m_dfgNodes = new DFGNode*[m_cycleBoundary];
-  delete[] m_bypassed;
-  m_bypassed = new bool[m_cycleBoundary];
-  delete[] m_generatedOut;
-  m_generatedOut = new bool[m_cycleBoundary];
-  delete[] m_arrived;
-  m_arrived = new bool[m_cycleBoundary];
   m_currentCtrlMemItems = 0;
-  for(int i=0; i<m_cycleBoundary; ++i) {
-    m_occupied[i] = false;
-    m_dfgNodes[i] = NULL;
-    m_bypassed[i] = false;
-    m_generatedOut[i] = false;
-    m_arrived[i] = false;
+  m_slots = m_arena->allocate<LinkSlot>(t_II);
+  for (int slot=0; slot<t_II; ++slot) {
+    m_slots[slot].dfgNode = NULL;
+    m_slots[slot].occupied = false;
+    m_slots[slot].bypassed = false;
+    m_slots[slot].generatedOut = false;
+    m_slots[slot].arrived = false;
   }
 }
 
+LinkSlot& CGRALink::getSlot(int t_cycle) {
+  return m_slots[((t_cycle % m_II) + m_II) % m_II];
+}
+
 bool CGRALink::satisfyBypassConstraint(int t_cycle, int t_II) {
   CGRANode* outCGRANode = getDst();
   // If no DFG node is mapped onto the outCGRANode.
@@ -115,11 +118,12 @@ bool CGRALink::satisfyBypassConstraint(int t_cycle, int t_II) {
 // can only support one bypass and one computation. So at most two bypass.
 bool CGRALink::canOccupy(int t_cycle, int t_II) {
   // cout<<"[link->canOccupy() 0] ("<<m_src->getID()<<")->("<<m_dst->getID()<<")..."<<endl;
+  Counters::add(COUNTER_LINK_PROBES);
   if (m_disabled)
     return false;
   if (m_currentCtrlMemItems + 1 > m_ctrlMemSize)
     return false;
-  if (m_occupied[t_cycle])
+  if (getSlot(t_cycle).occupied)
     return false;
   if (!satisfyBypassConstraint(t_cycle, t_II))
     return false;
@@ -130,13 +134,15 @@ bool CGRALink::canOccupy(DFGNode* t_srcDFGNode, CGRANode* t_srcCGRANode,
                          int t_cycle, int t_II) {
 
   // cout<<"[link->canOccupy() 1] ("<<m_src->getID()<<")->("<<m_dst->getID()<<")..."<<endl;
+  Counters::add(COUNTER_LINK_PROBES);
   if (m_disabled)
     return false;
-  if (m_dfgNodes[t_cycle] != NULL and t_srcDFGNode == m_dfgNodes[t_cycle])
+  LinkSlot& slot = getSlot(t_cycle);
+  if (slot.dfgNode != NULL and t_srcDFGNode == slot.dfgNode)
     return true;
   if (m_currentCtrlMemItems + 1 > m_ctrlMemSize)
     return false;
-  if (m_occupied[t_cycle])
+  if (slot.occupied)
     return false;
   if (!satisfyBypassConstraint(t_cycle, t_II))
     return false;
@@ -145,16 +151,16 @@ bool CGRALink::canOccupy(DFGNode* t_srcDFGNode, CGRANode* t_srcCGRANode,
   // The case of resultOut that is blocked by the bypass (blocking
   // the port/register) for 2 cycles:
   if (getSrc() == t_srcCGRANode) {
-    int t = (t_cycle+1) % t_II;
-    if (m_dfgNodes[t] != NULL and
-        !m_generatedOut[t]) {
+    LinkSlot& next = getSlot(t_cycle+1);
+    if (next.dfgNode != NULL and
+        !next.generatedOut) {
       return false;
     }
   } else { // On the other hand, the link for bypass is blocked
            // by the resultOut for 2 cycles:
-    int t = (t_cycle+t_II-1) % t_II;
-    if (m_dfgNodes[t] != NULL and
-        m_generatedOut[t]) {
+    LinkSlot& prev = getSlot(t_cycle+t_II-1);
+    if (prev.dfgNode != NULL and
+        prev.generatedOut) {
       return false;
     }
   }
@@ -196,79 +202,60 @@ bool CGRALink::canOccupy(DFGNode* t_srcDFGNode, int t_cycle, int t_II) {
 */
 
 bool CGRALink::isOccupied(int t_cycle) {
-  return m_occupied[t_cycle];
+  return getSlot(t_cycle).occupied;
 }
 
+// The static elastic CGRA occupies the link at every slot (see occupy()),
+// so checking the slot of t_cycle covers both cases.
 bool CGRALink::isOccupied(int t_cycle, int t_II, bool t_isStaticElasticCGRA) {
-  int interval = t_II;
-  if (t_isStaticElasticCGRA)
-    interval = 1;
-  for (int i=t_cycle; i<m_cycleBoundary; i=i+interval) {
-    if (m_occupied[i]) {
-      return true;
-    }
-  }
-  return false;
+  return getSlot(t_cycle).occupied;
 }
 
 bool CGRALink::isReused(int t_cycle) {
-  return m_occupied[t_cycle];
+  return getSlot(t_cycle).occupied;
 }
 
 void CGRALink::occupy(DFGNode* t_srcDFGNode, int t_cycle, int duration,
     int t_II, bool t_isBypass, bool t_isGeneratedOut, bool t_isStaticElasticCGRA) {
+  journal(&m_mapped);
   m_mapped = true;
   int interval = t_II;
   if (t_isStaticElasticCGRA) {
     interval = 1;
     t_cycle = 0;
   }
-  for(int cycle=t_cycle; cycle<m_cycleBoundary; cycle+=interval) {
-    m_dfgNodes[cycle] = t_srcDFGNode;
-    m_occupied[cycle] = true;
-    // Only set 'm_bypassed' as true if it is bypassed.
+  for (int cycle=t_cycle; cycle<t_cycle+m_II; cycle+=interval) {
+    LinkSlot& slot = getSlot(cycle);
+    journal(&slot);
+    slot.dfgNode = t_srcDFGNode;
+    slot.occupied = true;
+    // Only set 'bypassed' as true if it is bypassed.
     // Will never set it back to false.
     if (t_isBypass)
-      m_bypassed[cycle] = true;
+      slot.bypassed = true;
     if (t_isGeneratedOut)
-      m_generatedOut[cycle] = true;
-    // Only set 'm_arrived' as true if it is not bypassed.
+      slot.generatedOut = true;
+    // Only set 'arrived' as true if it is not bypassed.
     // Will never set it back to false.
     if (!t_isBypass)
-      m_arrived[cycle] = true;
-  }
-  for(int cycle=t_cycle; cycle>=0; cycle-=interval) {
-    m_dfgNodes[cycle] = t_srcDFGNode;
-    m_occupied[cycle] = true;
-    // Only set 'm_bypassed' as true if it is bypassed.
-    // Will never set it back to false.
-    if (t_isBypass)
-      m_bypassed[cycle] = true;
-    if (t_isGeneratedOut)
-      m_generatedOut[cycle] = true;
-    // Only set 'm_arrived' as true if it is not bypassed.
-    // Will never set it back to false.
-    if (!t_isBypass)
-      m_arrived[cycle] = true;
+      slot.arrived = true;
   }
   if (!t_isBypass) {
     m_dst->allocateReg(this, t_cycle, duration, interval);
   }
 
+  journal(&m_currentCtrlMemItems);
   ++m_currentCtrlMemItems;
 
-  cout<<"[DEBUG] occupy link["<<m_src->getID()<<"]-->["<<m_dst->getID()<<"] (bypass:"<<t_isBypass<<") dfgNode: "<<t_srcDFGNode->getID()<<" at cycle "<<t_cycle<<"\n";
+  CGRA_LOG(LOG_ROUTE, LOG_TRACE)<<"[DEBUG] occupy link["<<m_src->getID()<<"]-->["<<m_dst->getID()<<"] (bypass:"<<t_isBypass<<") dfgNode: "<<t_srcDFGNode->getID()<<" at cycle "<<t_cycle<<"\n";
 }
 
 DFGNode* CGRALink::getMappedDFGNode(int t_cycle) {
-  if (t_cycle < 0) {
-    return m_dfgNodes[m_II+t_cycle];
-  }
-  return m_dfgNodes[t_cycle];
+  return getSlot(t_cycle).dfgNode;
 }
 
 bool CGRALink::isBypass(int t_cycle) {
-  return m_bypassed[t_cycle];
+  return getSlot(t_cycle).bypassed;
 }
 
 CGRANode* CGRALink::getSrc() {
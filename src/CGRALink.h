@@ -16,12 +16,24 @@
 
 #include "CGRANode.h"
 #include "DFGNode.h"
+#include "UndoLog.h"
+#include "MRRGArena.h"
 
 //using namespace llvm;
 using namespace std;
 
 class CGRANode;
 
+// One slot of the link's modulo reservation table, i.e., the link usage
+// at (cycle % II).
+struct LinkSlot {
+  DFGNode* dfgNode;
+  bool occupied;
+  bool bypassed;
+  bool generatedOut;
+  bool arrived;
+};
+
 class CGRALink
 {
   private:
@@ -34,13 +46,18 @@ class CGRALink
     int m_currentCtrlMemItems;
     bool m_mapped;
 
-    int m_cycleBoundary;
     bool m_disabled;
-    bool* m_occupied;
-    bool* m_bypassed;
-    bool* m_generatedOut;
-    bool* m_arrived;
-    DFGNode** m_dfgNodes;
+    // Allocated from the arena of the CGRA.
+    LinkSlot* m_slots;
+    // Journal of the writes to the MRRG state of this link and the arena
+    // holding the state, both owned by CGRA.
+    UndoLog* m_undoLog;
+    MRRGArena* m_arena;
+    LinkSlot& getSlot(int);
+    template<typename T> void journal(T* t_field) {
+      if (m_undoLog != NULL)
+        m_undoLog->record(t_field);
+    }
     bool satisfyBypassConstraint(int, int);
 
   public:
@@ -52,6 +69,8 @@ class CGRALink
     void connect(CGRANode*, CGRANode*);
     CGRANode* getConnectedNode(CGRANode*);
 
+    void setUndoLog(UndoLog*);
+    void setArena(MRRGArena*);
     void constructMRRG(int, int);
     bool canOccupy(int, int);
     bool isOccupied(int);
@@ -9,7 +9,9 @@
  */
 
 #include "CGRANode.h"
-#include <stdio.h>
+#include "Counters.h"
+#include <assert.h>
+#include "Log.h"
 
 #define SINGLE_OCCUPY     0 // A single-cycle opt is in the FU
 #define START_PIPE_OCCUPY 1 // A multi-cycle opt starts in the FU
@@ -36,11 +38,13 @@ CGRANode::CGRANode(int t_id, int t_x, int t_y) {
 
   m_x = t_x;
   m_y = t_y;
-  m_neighbors = NULL;
-  m_occupiableInLinks = NULL;
-  m_occupiableOutLinks = NULL;
-  m_regs_duration = NULL;
-  m_regs_timing = NULL;
+  m_II = 1;
+  m_cycleBoundary = 0;
+  m_undoLog = NULL;
+  m_arena = NULL;
+  m_regsDuration = NULL;
+  m_regsTiming = NULL;
+  m_fuSlots = NULL;
 
   // used for parameterizable CGRA functional units
   m_canAdd    = true;
@@ -82,45 +86,34 @@ void CGRANode::allocateReg(int t_port_id, int t_cycle, int t_duration, int t_II)
   bool allocated = false;
   for (int i=0; i<m_registerCount; ++i) {
     bool reg_occupied = false;
-    for (int cycle=t_cycle; cycle<m_cycleBoundary; cycle+=t_II) {
+    for (int cycle=t_cycle; cycle<t_cycle+m_II; cycle+=t_II) {
       for (int d=0; d<t_duration; ++d) {
-        if (cycle+d<m_cycleBoundary and m_regs_duration[cycle+d][i] != -1)
-          reg_occupied = true;
-      }
-    }
-    for (int cycle=t_cycle; cycle>=0; cycle-=t_II) {
-      for (int d=0; d<t_duration; ++d) {
-        if (m_regs_duration[cycle+d][i] != -1)
+        if (m_regsDuration[getSlot(cycle+d)*m_registerCount+i] != -1)
           reg_occupied = true;
       }
     }
     if (reg_occupied == false) {
-      cout<<"[DEBUG] in allocateReg() t_cycle: "<<t_cycle<<"; i: "<<i<<" CGRA node: "<<this->getID()<<"; link: "<<t_port_id<<" duration "<<t_duration<<"\n";
-      for (int cycle=t_cycle; cycle<m_cycleBoundary; cycle+=t_II) {
-        m_regs_timing[cycle][i] = t_port_id;
+      CGRA_LOG(LOG_MRRG, LOG_TRACE)<<"[DEBUG] in allocateReg() t_cycle: "<<t_cycle<<"; i: "<<i<<" CGRA node: "<<this->getID()<<"; link: "<<t_port_id<<" duration "<<t_duration<<"\n";
+      for (int cycle=t_cycle; cycle<t_cycle+m_II; cycle+=t_II) {
+        journal(&m_regsTiming[getSlot(cycle)*m_registerCount+i]);
+        m_regsTiming[getSlot(cycle)*m_registerCount+i] = t_port_id;
         for (int d=0; d<t_duration; ++d) {
-          if (cycle+d<m_cycleBoundary) {
-            // assert(m_regs_duration[cycle+d][i] == -1);
-            m_regs_duration[cycle+d][i] = t_port_id;
-          }
-        }
-      }
-      for (int cycle=t_cycle; cycle>=0; cycle-=t_II) {
-        m_regs_timing[cycle][i] = t_port_id;
-        for (int d=0; d<t_duration; ++d) {
-          m_regs_duration[cycle+d][i] = t_port_id;
+          // assert(m_regsDuration[getSlot(cycle+d)*m_registerCount+i] == -1);
+          journal(&m_regsDuration[getSlot(cycle+d)*m_registerCount+i]);
+          m_regsDuration[getSlot(cycle+d)*m_registerCount+i] = t_port_id;
         }
       }
       allocated = true;
       break;
     }
   }
-  cout<<"[DEBUG] done reg allocation"<<endl;
+  Counters::add(allocated ? COUNTER_REGS_ALLOCATED : COUNTER_REGS_REJECTED);
+  CGRA_LOG(LOG_MRRG, LOG_TRACE)<<"[DEBUG] done reg allocation\n";
   //assert(allocated);
 }
 
 int* CGRANode::getRegsAllocation(int t_cycle) {
-  return m_regs_timing[t_cycle];
+  return &m_regsTiming[getSlot(t_cycle)*m_registerCount];
 }
 
 void CGRANode::setCtrlMemConstraint(int t_ctrlMemConstraint) {
@@ -168,6 +161,7 @@ int CGRANode::getDVFSIslandID() {
 
 void CGRANode::setDVFSLatencyMultiple(int t_DVFSLatencyMultiple) {
   assert(t_DVFSLatencyMultiple == 1 || t_DVFSLatencyMultiple == 2 || t_DVFSLatencyMultiple == 4);
+  journal(&m_DVFSLatencyMultiple);
   m_DVFSLatencyMultiple = t_DVFSLatencyMultiple;
 }
 
@@ -199,40 +193,69 @@ list<CGRALink*>* CGRANode::getOutLinks() {
   return &m_outLinks;
 }
 
-list<CGRANode*>* CGRANode::getNeighbors() {
-  if (m_neighbors != NULL)
-    return m_neighbors;
-  m_neighbors = new list<CGRANode*>();
+void CGRANode::initNeighbors() {
+  m_neighbors.clear();
   for (CGRALink* link: m_outLinks)
-    m_neighbors->push_back(link->getConnectedNode(this));
-  return m_neighbors;
+    m_neighbors.push_back(link->getConnectedNode(this));
+}
+
+list<CGRANode*>* CGRANode::getNeighbors() {
+  return &m_neighbors;
+}
+
+int CGRANode::getSlot(int t_cycle) {
+  return ((t_cycle % m_II) + m_II) % m_II;
+}
+
+void CGRANode::addToSlot(int t_cycle, DFGNode* t_opt, int t_status) {
+  FUSlot& slot = m_fuSlots[getSlot(t_cycle)];
+  journal(m_arena->getCursor());
+  FUOpt* opt = m_arena->allocate<FUOpt>(1);
+  opt->dfgNode = t_opt;
+  opt->status = t_status;
+  opt->next = NULL;
+  if (slot.lastOpt == NULL) {
+    journal(&slot.firstOpt);
+    slot.firstOpt = opt;
+  } else {
+    journal(&slot.lastOpt->next);
+    slot.lastOpt->next = opt;
+  }
+  journal(&slot.lastOpt);
+  slot.lastOpt = opt;
+  journal(&slot.optCount);
+  ++slot.optCount;
+  journal(&slot.statusCount[t_status]);
+  ++slot.statusCount[t_status];
+}
+
+void CGRANode::setUndoLog(UndoLog* t_undoLog) {
+  m_undoLog = t_undoLog;
+}
+
+void CGRANode::setArena(MRRGArena* t_arena) {
+  m_arena = t_arena;
 }
 
 void CGRANode::constructMRRG(int t_CGRANodeCount, int t_II) {
+  m_II = t_II;
   m_cycleBoundary = t_CGRANodeCount*t_II*t_II;
   m_currentCtrlMemItems = 0;
   m_registers.clear();
-  // Delete all these local arrays to avoid memory leakage.
-  if (m_dfgNodesWithOccupyStatus.size() > 0) {
-    for (list<pair<DFGNode*, int>>* opts: m_dfgNodesWithOccupyStatus) {
-      opts->clear();
+  m_fuSlots = m_arena->allocate<FUSlot>(t_II);
+  for (int slot=0; slot<t_II; ++slot) {
+    m_fuSlots[slot].firstOpt = NULL;
+    m_fuSlots[slot].lastOpt = NULL;
+    m_fuSlots[slot].optCount = 0;
+    for (int status=0; status<4; ++status) {
+      m_fuSlots[slot].statusCount[status] = 0;
     }
   }
-  m_dfgNodesWithOccupyStatus.clear();
-  // m_dfgNodesWithOccupyStatus = new list<list<pair<DFGNode*, int>>*>();
-  for (int i=0; i<m_cycleBoundary; ++i) {
-    m_dfgNodesWithOccupyStatus.push_back(new list<pair<DFGNode*, int>>());
-  }
-
-  m_regs_duration = new int*[m_cycleBoundary];
-  m_regs_timing = new int*[m_cycleBoundary];
-  for (int i=0; i<m_cycleBoundary; ++i) {
-    m_regs_duration[i] = new int[m_registerCount];
-    m_regs_timing[i] = new int[m_registerCount];
-    for (int j=0; j<m_registerCount; ++j) {
-      m_regs_duration[i][j] = -1;
-      m_regs_timing[i][j] = -1;
-    }
+  m_regsDuration = m_arena->allocate<int>(t_II*m_registerCount);
+  m_regsTiming = m_arena->allocate<int>(t_II*m_registerCount);
+  for (int i=0; i<t_II*m_registerCount; ++i) {
+    m_regsDuration[i] = -1;
+    m_regsTiming[i] = -1;
   }
 }
 
@@ -240,12 +263,10 @@ bool CGRANode::canSupport(DFGNode* t_opt) {
   if (m_disabled)
     return false;
   // Check whether this CGRA node supports the required functionality.
-  string call_f = t_opt->isCall();
-  if (call_f.compare("None") && !canCall(call_f)) {
+  if (t_opt->isCallOpt() && !canCall(t_opt->isCall())) {
     return false;
   }
-  string complex_f = t_opt->getComplexType();
-  if (complex_f.compare("None") && !supportComplex(complex_f)) {
+  if (t_opt->hasCombined() && !supportComplex(t_opt->getComplexType())) {
     return false;
   }
   if ((t_opt->isLoad()       and !canLoad())  or
@@ -268,6 +289,7 @@ bool CGRANode::canSupport(DFGNode* t_opt) {
 }
 
 bool CGRANode::canOccupy(DFGNode* t_opt, int t_cycle, int t_II) {
+  Counters::add(COUNTER_TILE_PROBES);
   if (m_disabled)
     return false;
 
@@ -295,79 +317,61 @@ bool CGRANode::canOccupy(DFGNode* t_opt, int t_cycle, int t_II) {
   }
 
   // Handle multi-cycle execution and pipelinable operations.
+  FUSlot& startSlot = m_fuSlots[getSlot(t_cycle)];
   if (not t_opt->isMultiCycleExec(getDVFSLatencyMultiple())) {
     // Single-cycle opt:
-    for (int cycle=t_cycle%t_II; cycle<m_cycleBoundary; cycle+=t_II) {
-      // If this tile don't support inclusive execution (canMultipleOps() == false), and there has been an operation occupied this tile at the current cycle, we cannot map t_opt on it. 
-      if (!canMultipleOps() && !m_dfgNodesWithOccupyStatus[cycle]->empty()) {
-        return false;
-      }
-      for (pair<DFGNode*, int> p: *(m_dfgNodesWithOccupyStatus[cycle])) {
-        if (p.second != IN_PIPE_OCCUPY) {
-          return false;
-        }
-      }
+    // If this tile don't support inclusive execution (canMultipleOps() == false), and there has been an operation occupied this tile at the current cycle, we cannot map t_opt on it.
+    if (!canMultipleOps() && startSlot.optCount > 0) {
+      return false;
+    }
+    if (startSlot.optCount != startSlot.statusCount[IN_PIPE_OCCUPY]) {
+      return false;
     }
   } else {
     // Multi-cycle opt.
-    for (int cycle=t_cycle%t_II; cycle<m_cycleBoundary; cycle+=t_II) {
-      // Can not support simultaneous execution of multiple operations.
-      if (!canMultipleOps()) {
-        int exec_latency = t_opt->getExecLatency(getDVFSLatencyMultiple());
-        for (int duration=0; duration < exec_latency; duration++) {
-          if (cycle + duration >= m_cycleBoundary) {
-            break;
-          }
-          if (!m_dfgNodesWithOccupyStatus[cycle+duration]->empty()) {
-            return false;
-          }
+    int exec_latency = t_opt->getExecLatency(getDVFSLatencyMultiple());
+    // Can not support simultaneous execution of multiple operations.
+    if (!canMultipleOps()) {
+      for (int duration=0; duration < exec_latency and duration < m_II; duration++) {
+        if (m_fuSlots[getSlot(t_cycle+duration)].optCount > 0) {
+          return false;
         }
       }
-      else {
-        // Check start cycle.
-        for (pair<DFGNode*, int> p: *(m_dfgNodesWithOccupyStatus[cycle])) {
-          // Cannot occupy/overlap by/with other operation if DVFS is enabled.
-          if (isDVFSEnabled() and
-              (p.second == SINGLE_OCCUPY or
-              p.second == START_PIPE_OCCUPY or
-              p.second == IN_PIPE_OCCUPY or
-              p.second == END_PIPE_OCCUPY)) {
-            return false;
-          }
-          // Multi-cycle opt's start cycle overlaps with single-cycle opt' cycle.
-          else if (p.second == SINGLE_OCCUPY) {
-            return false;
-          }
-          // Multi-cycle opt's start cycle overlaps with multi-cycle opt's start cycle.
-          else if (p.second == START_PIPE_OCCUPY) {
-            return false;
-          }
-          // Multi-cycle opt's start cycle overlaps with multi-cycle opt with the same type:
-          else if ((p.second == IN_PIPE_OCCUPY or p.second == END_PIPE_OCCUPY) and
-                  (t_opt->shareFU(p.first))   and
-                  (not t_opt->isPipelinable() or not p.first->isPipelinable())) {
-            return false;
-          }
-        }
-        if (cycle+t_opt->getExecLatency(getDVFSLatencyMultiple())-1 >= m_cycleBoundary) {
-          break;
+    }
+    else {
+      // Check start cycle.
+      // Cannot occupy/overlap by/with other operation if DVFS is enabled.
+      if (isDVFSEnabled() and startSlot.optCount > 0) {
+        return false;
+      }
+      // Multi-cycle opt's start cycle overlaps with single-cycle opt' cycle,
+      // or with multi-cycle opt's start cycle.
+      if (startSlot.statusCount[SINGLE_OCCUPY] > 0 or
+          startSlot.statusCount[START_PIPE_OCCUPY] > 0) {
+        return false;
+      }
+      // Multi-cycle opt's start cycle overlaps with multi-cycle opt with the same type:
+      for (FUOpt* p=startSlot.firstOpt; p!=NULL; p=p->next) {
+        if ((p->status == IN_PIPE_OCCUPY or p->status == END_PIPE_OCCUPY) and
+            (t_opt->shareFU(p->dfgNode))   and
+            (not t_opt->isPipelinable() or not p->dfgNode->isPipelinable())) {
+          return false;
         }
-        // Check end cycle.
-        for (pair<DFGNode*, int> p: *(m_dfgNodesWithOccupyStatus[cycle+t_opt->getExecLatency(getDVFSLatencyMultiple())-1])) {
-          // Multi-cycle opt's end cycle overlaps with single-cycle opt' cycle.
-          if (p.second == SINGLE_OCCUPY) {
-            return false;
-          }
-          // Multi-cycle opt's end cycle overlaps with multi-cycle opt's end cycle.
-          else if (p.second == END_PIPE_OCCUPY) {
-            return false;
-          }
-          // Multi-cycle opt's end cycle overlaps with multi-cycle opt with the same type:
-          else if ((p.second == IN_PIPE_OCCUPY or p.second == START_PIPE_OCCUPY) and
-                  (t_opt->shareFU(p.first))   and
-                  (not t_opt->isPipelinable() or not p.first->isPipelinable())) {
-            return false;
-          }
+      }
+      // Check end cycle.
+      FUSlot& endSlot = m_fuSlots[getSlot(t_cycle+exec_latency-1)];
+      // Multi-cycle opt's end cycle overlaps with single-cycle opt' cycle,
+      // or with multi-cycle opt's end cycle.
+      if (endSlot.statusCount[SINGLE_OCCUPY] > 0 or
+          endSlot.statusCount[END_PIPE_OCCUPY] > 0) {
+        return false;
+      }
+      // Multi-cycle opt's end cycle overlaps with multi-cycle opt with the same type:
+      for (FUOpt* p=endSlot.firstOpt; p!=NULL; p=p->next) {
+        if ((p->status == IN_PIPE_OCCUPY or p->status == START_PIPE_OCCUPY) and
+            (t_opt->shareFU(p->dfgNode))   and
+            (not t_opt->isPipelinable() or not p->dfgNode->isPipelinable())) {
+          return false;
         }
       }
     }
@@ -377,49 +381,27 @@ bool CGRANode::canOccupy(DFGNode* t_opt, int t_cycle, int t_II) {
 }
 
 bool CGRANode::isOccupied(int t_cycle, int t_II) {
-  for (int cycle=t_cycle; cycle<m_cycleBoundary; cycle+=t_II) {
-    for (pair<DFGNode*, int> p: *(m_dfgNodesWithOccupyStatus[cycle])) {
-      // If DVFS is supported, the entire tile is occupied before the current multi-cycle operation
-      // completes. Otherwise, the next operation can start before the current one completes.
-      if (p.second == START_PIPE_OCCUPY or p.second == SINGLE_OCCUPY or m_supportDVFS) {
-        return true;
-      }
-    }
+  FUSlot& slot = m_fuSlots[getSlot(t_cycle)];
+  // If DVFS is supported, the entire tile is occupied before the current multi-cycle operation
+  // completes. Otherwise, the next operation can start before the current one completes.
+  if (m_supportDVFS) {
+    return slot.optCount > 0;
   }
-  return false;
+  return slot.statusCount[START_PIPE_OCCUPY] > 0 or slot.statusCount[SINGLE_OCCUPY] > 0;
 }
 
 bool CGRANode::isStartOrInPipe(int t_cycle, int t_II) {
-  for (int cycle=t_cycle; cycle<m_cycleBoundary; cycle+=t_II) {
-    for (pair<DFGNode*, int> p: *(m_dfgNodesWithOccupyStatus[cycle])) {
-      if (p.second == START_PIPE_OCCUPY or p.second == IN_PIPE_OCCUPY) {
-        return true;
-      }
-    }
-  }
-  return false;
+  FUSlot& slot = m_fuSlots[getSlot(t_cycle)];
+  return slot.statusCount[START_PIPE_OCCUPY] > 0 or slot.statusCount[IN_PIPE_OCCUPY] > 0;
 }
 
 bool CGRANode::isInOrEndPipe(int t_cycle, int t_II) {
-  for (int cycle=t_cycle; cycle<m_cycleBoundary; cycle+=t_II) {
-    for (pair<DFGNode*, int> p: *(m_dfgNodesWithOccupyStatus[cycle])) {
-      if (p.second == IN_PIPE_OCCUPY or p.second == END_PIPE_OCCUPY) {
-        return true;
-      }
-    }
-  }
-  return false;
+  FUSlot& slot = m_fuSlots[getSlot(t_cycle)];
+  return slot.statusCount[IN_PIPE_OCCUPY] > 0 or slot.statusCount[END_PIPE_OCCUPY] > 0;
 }
 
 bool CGRANode::isEndPipe(int t_cycle, int t_II) {
-  for (int cycle=t_cycle; cycle<m_cycleBoundary; cycle+=t_II) {
-    for (pair<DFGNode*, int> p: *(m_dfgNodesWithOccupyStatus[cycle])) {
-      if (p.second == END_PIPE_OCCUPY) {
-        return true;
-      }
-    }
-  }
-  return false;
+  return m_fuSlots[getSlot(t_cycle)].statusCount[END_PIPE_OCCUPY] > 0;
 }
 
 bool CGRANode::isSynced() {
@@ -427,6 +409,7 @@ bool CGRANode::isSynced() {
 }
 
 void CGRANode::syncDVFS() {
+  journal(&m_synced);
   m_synced = true;
 }
 
@@ -440,47 +423,46 @@ void CGRANode::setDFGNode(DFGNode* t_opt, int t_cycle, int t_II,
   if (t_isStaticElasticCGRA) {
     interval = 1;
   }
+  journal(&m_mapped);
   m_mapped = true;
   if (isDVFSEnabled()) {
     if (not m_synced) {
       setDVFSLatencyMultiple(t_opt->getDVFSLatencyMultiple());
     }
   }
-  for (int cycle=t_cycle%interval; cycle<m_cycleBoundary; cycle+=interval) {
+  // The static elastic CGRA keeps the opt in the FU at every cycle, i.e.,
+  // it starts from each of the II slots.
+  for (int cycle=t_cycle; cycle<t_cycle+m_II; cycle+=interval) {
     if (not t_opt->isMultiCycleExec(getDVFSLatencyMultiple())) {
-      m_dfgNodesWithOccupyStatus[cycle]->push_back(make_pair(t_opt, SINGLE_OCCUPY));
+      addToSlot(cycle, t_opt, SINGLE_OCCUPY);
     } else {
-      m_dfgNodesWithOccupyStatus[cycle]->push_back(make_pair(t_opt, START_PIPE_OCCUPY));
+      addToSlot(cycle, t_opt, START_PIPE_OCCUPY);
       for (int i=1; i<t_opt->getExecLatency(getDVFSLatencyMultiple())-1; ++i) {
-        if (cycle+i < m_cycleBoundary) {
-          m_dfgNodesWithOccupyStatus[cycle+i]->push_back(make_pair(t_opt, IN_PIPE_OCCUPY));
-        }
+        addToSlot(cycle+i, t_opt, IN_PIPE_OCCUPY);
       }
       int lastCycle = cycle+t_opt->getExecLatency(getDVFSLatencyMultiple())-1;
-      if (lastCycle < m_cycleBoundary) {
-        m_dfgNodesWithOccupyStatus[lastCycle]->push_back(make_pair(t_opt, END_PIPE_OCCUPY));
-      }
+      addToSlot(lastCycle, t_opt, END_PIPE_OCCUPY);
     }
   }
 
-  cout<<"[DEBUG] setDFGNode "<<t_opt->getID()<<" onto CGRANode "<<getID()<<" at cycle: "<<t_cycle<<"\n";
+  CGRA_LOG(LOG_MRRG, LOG_TRACE)<<"[DEBUG] setDFGNode "<<t_opt->getID()<<" onto CGRANode "<<getID()<<" at cycle: "<<t_cycle<<"\n";
+  journal(&m_currentCtrlMemItems);
   ++m_currentCtrlMemItems;
-  t_opt->setMapped();
 }
 
 DFGNode* CGRANode::getMappedDFGNode(int t_cycle) {
-  for (pair<DFGNode*, int> p: *(m_dfgNodesWithOccupyStatus[t_cycle])) {
-    if (p.second == SINGLE_OCCUPY or p.second == END_PIPE_OCCUPY) {
-      return p.first;
+  for (FUOpt* p=m_fuSlots[getSlot(t_cycle)].firstOpt; p!=NULL; p=p->next) {
+    if (p->status == SINGLE_OCCUPY or p->status == END_PIPE_OCCUPY) {
+      return p->dfgNode;
     }
   }
   return NULL;
 }
 
 bool CGRANode::containMappedDFGNode(DFGNode* t_node, int t_II) {
-  for (int c=0; c<2*t_II; ++c) {
-    for (pair<DFGNode*, int> p: *(m_dfgNodesWithOccupyStatus[c])) {
-      if (t_node == p.first) {
+  for (int slot=0; slot<m_II; ++slot) {
+    for (FUOpt* p=m_fuSlots[slot].firstOpt; p!=NULL; p=p->next) {
+      if (t_node == p->dfgNode) {
         return true;
       }
     }
@@ -497,28 +479,24 @@ void CGRANode::addRegisterValue(float t_value) {
   m_registers.push_back(t_value);
 }
 
-list<CGRALink*>* CGRANode::getOccupiableInLinks(int t_cycle, int t_II) {
-  if (m_occupiableInLinks == NULL)
-    m_occupiableInLinks = new list<CGRALink*>();
-  m_occupiableInLinks->clear();
+void CGRANode::getOccupiableInLinks(int t_cycle, int t_II,
+    vector<CGRALink*>* t_links) {
+  t_links->clear();
   for (CGRALink* link: m_inLinks) {
     if (link->canOccupy(t_cycle, t_II)) {
-      m_occupiableInLinks->push_back(link);
+      t_links->push_back(link);
     }
   }
-  return m_occupiableInLinks;
 }
 
-list<CGRALink*>* CGRANode::getOccupiableOutLinks(int t_cycle, int t_II) {
-  if (m_occupiableOutLinks == NULL)
-    m_occupiableOutLinks = new list<CGRALink*>();
-  m_occupiableOutLinks->clear();
+void CGRANode::getOccupiableOutLinks(int t_cycle, int t_II,
+    vector<CGRALink*>* t_links) {
+  t_links->clear();
   for (CGRALink* link: m_outLinks) {
     if (link->canOccupy(t_cycle, t_II)) {
-      m_occupiableOutLinks->push_back(link);
+      t_links->push_back(link);
     }
   }
-  return m_occupiableOutLinks;
 }
 
 int CGRANode::getAvailableRegisterCount() {
@@ -547,7 +525,9 @@ CGRALink* CGRANode::getOutLink(CGRANode* t_node) {
 
 int CGRANode::getMinIdleCycle(DFGNode* t_dfgNode, int t_cycle, int t_II) {
   int tempCycle = t_cycle;
-  while (tempCycle < m_cycleBoundary) {
+  // The occupancy repeats every II cycles, so there is no need to look
+  // further than one II ahead.
+  while (tempCycle < m_cycleBoundary and tempCycle < t_cycle + m_II) {
     if (canOccupy(t_dfgNode, tempCycle, t_II))
       return tempCycle;
     ++tempCycle;
@@ -664,7 +644,7 @@ void CGRANode::enableDiv() {
 }
 
 void CGRANode::disableMultipleOps() {
-  printf("disabling multiple ops\n");
+  CGRA_LOG(LOG_MRRG, LOG_INFO)<<"disabling multiple ops\n";
   m_canMultipleOps = false;
 }
 
@@ -676,6 +656,14 @@ bool CGRANode::supportComplex(string type) {
   return false;
 }
 
+vector<string>* CGRANode::getCallFuncs() {
+  return &m_canCall;
+}
+
+vector<string>* CGRANode::getComplexTypes() {
+  return &m_supportComplexType;
+}
+
 bool CGRANode::supportVectorization() {
   return m_supportVectorization;
 }
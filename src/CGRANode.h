@@ -13,6 +13,8 @@
 
 #include "CGRALink.h"
 #include "DFGNode.h"
+#include "UndoLog.h"
+#include "MRRGArena.h"
 #include <iostream>
 //#include <llvm/IR/Function.h>
 //#include <llvm/IR/Value.h>
@@ -23,11 +25,30 @@
 #include <map>
 
 using namespace std;
-using namespace llvm;
 
 class CGRALink;
 class DFGNode;
 
+// An operation occupying a slot of a tile's functional unit together with
+// its pipeline status, chained in the order the operations are placed.
+struct FUOpt {
+  DFGNode* dfgNode;
+  int status;
+  FUOpt* next;
+};
+
+// One slot of the modulo reservation table (MRT) of a tile's functional
+// unit, i.e., the operations occupying the FU at (cycle % II). The
+// per-status counters answer the common occupancy queries in O(1); the
+// operations are only walked when overlapped multi-cycle operations need
+// to be compared with each other.
+struct FUSlot {
+  FUOpt* firstOpt;
+  FUOpt* lastOpt;
+  int optCount;
+  int statusCount[4];
+};
+
 class CGRANode {
 
   private:
@@ -42,11 +63,11 @@ class CGRANode {
     float* m_ctrlMem;
     list<CGRALink*> m_inLinks;
     list<CGRALink*> m_outLinks;
-    list<CGRALink*>* m_occupiableInLinks;
-    list<CGRALink*>* m_occupiableOutLinks;
-    list<CGRANode*>* m_neighbors;
+    list<CGRANode*> m_neighbors;
 
-    // functional unit occupied with cycle going on
+    // The modulo reservation table only keeps II slots, the cycle boundary
+    // just bounds how far the scheduler looks for an idle cycle.
+    int m_II;
     int m_cycleBoundary;
     int* m_fuOccupied;
     DFGNode** m_dfgNodes;
@@ -67,9 +88,11 @@ class CGRANode {
     bool m_canDiv;
     bool m_supportComplex;
     bool m_supportVectorization;
-    int** m_regs_duration;
-    int** m_regs_timing;
-    vector<list<pair<DFGNode*, int>>*> m_dfgNodesWithOccupyStatus;
+    // The MRT slots and the register occupancy per slot (flattened as
+    // [slot][register]), allocated from the arena of the CGRA.
+    int* m_regsDuration;
+    int* m_regsTiming;
+    FUSlot* m_fuSlots;
     vector<string> m_canCall;
     vector<string> m_supportComplexType;
 
@@ -84,6 +107,18 @@ class CGRANode {
 
     bool m_canMultipleOps;
 
+    // Journal of the writes to the MRRG state of this tile and the arena
+    // holding the state, both owned by CGRA.
+    UndoLog* m_undoLog;
+    MRRGArena* m_arena;
+
+    int getSlot(int);
+    void addToSlot(int, DFGNode*, int);
+    template<typename T> void journal(T* t_field) {
+      if (m_undoLog != NULL)
+        m_undoLog->record(t_field);
+    }
+
   public:
     CGRANode(int, int, int);
 //    CGRANode(int, int, int, int, int);
@@ -123,8 +158,13 @@ class CGRANode {
     list<CGRALink*>* getOutLinks();
     CGRALink* getInLink(CGRANode*);
     CGRALink* getOutLink(CGRANode*);
+    // Collects the neighbors once all the links are connected, so that
+    // getNeighbors() is a pure read while mapping (possibly in parallel).
+    void initNeighbors();
     list<CGRANode*>* getNeighbors();
 
+    void setUndoLog(UndoLog*);
+    void setArena(MRRGArena*);
     void constructMRRG(int, int);
     bool canSupport(DFGNode*);
     bool isOccupied(int, int);
@@ -133,8 +173,10 @@ class CGRANode {
     void setDFGNode(DFGNode*, int, int, bool);
     void configXbar(CGRALink*, int, int);
     void addRegisterValue(float);
-    list<CGRALink*>* getOccupiableInLinks(int, int);
-    list<CGRALink*>* getOccupiableOutLinks(int, int);
+    // The occupiable links are filled into the caller's buffer rather than
+    // into a list owned by the tile, which keeps the query reentrant.
+    void getOccupiableInLinks(int, int, vector<CGRALink*>*);
+    void getOccupiableOutLinks(int, int, vector<CGRALink*>*);
     int getAvailableRegisterCount();
     int getMinIdleCycle(DFGNode*, int, int);
     int getCurrentCtrlMemItems();
@@ -145,6 +187,8 @@ class CGRANode {
     bool canLoad();
     bool canCall(string t_func="");
     bool supportComplex(string type="");
+    vector<string>* getCallFuncs();
+    vector<string>* getComplexTypes();
     bool supportVectorization();
     bool canAdd();
     bool canMul();
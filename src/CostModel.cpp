@@ -0,0 +1,232 @@
+/*
+ * ======================================================================
+ * CostModel.cpp
+ * ======================================================================
+ * Weighted cost terms of the placement implementation.
+ *
+ * Date : October 16, 2026
+ */
+
+#include "CostModel.h"
+#include "CGRA.h"
+#include "DFGView.h"
+#include "Route.h"
+#include <cstdlib>
+
+// Consider the cost of the distance.
+static float distanceTerm(PathCostContext* t_context) {
+  return t_context->cycle + 1;
+}
+
+// Consider the same tile mapped with continuously two DFG nodes, i.e.,
+// the data waiting along the path.
+static float waitTerm(PathCostContext* t_context) {
+  Route* path = t_context->path;
+  int waits = 0;
+  for (int h=1; h<path->size(); ++h) {
+    if (path->getHop(h)->cycle - path->getHop(h-1)->cycle > 1)
+      ++waits;
+  }
+  return waits;
+}
+
+// Consider the single tile that processes everything.
+static float localPathTerm(PathCostContext* t_context) {
+  return t_context->path->isLocal() ? 1 : 0;
+}
+
+// Consider the cost of the utilization of contrl memory.
+static float ctrlMemTerm(PathCostContext* t_context) {
+  int items = t_context->tile->getCurrentCtrlMemItems();
+  return t_context->DVFSAwareMapping ? items / 2 : items;
+}
+
+// Consider the cost of the outgoing ports.
+static float outPortsTerm(PathCostContext* t_context) {
+  if (t_context->view->getSuccCount(t_context->index) <= 1)
+    return 0;
+  return 4 - (int)t_context->tile->getOutLinks()->size();
+}
+
+// Consider the distance to the center of the CGRA, which leaves room
+// around the DFG node with multiple successors.
+static float centralityTerm(PathCostContext* t_context) {
+  if (t_context->view->getSuccCount(t_context->index) <= 1)
+    return 0;
+  CGRA* cgra = t_context->cgra;
+  return abs(cgra->getColumns()/2 - t_context->tile->getX()) +
+         abs(cgra->getRows()/2 - t_context->tile->getY());
+}
+
+// Consider the predecessors with many successors mapped onto the tile.
+static float predFanoutTerm(PathCostContext* t_context) {
+  DFGView* view = t_context->view;
+  const int* preds = view->getPreds(t_context->index);
+  int count = 0;
+  for (int p=0; p<view->getPredCount(t_context->index); ++p) {
+    if (view->getSuccCount(preds[p]) > 2 and
+        (*t_context->mappedTiles)[preds[p]] == t_context->tile)
+      ++count;
+  }
+  return count;
+}
+
+// Considers the island for DVFS.
+// Better to put the DFGNode inside the CGRA island with the
+// matched DVFS level. A special case is by default the DVFS
+// level is 1, but the island mapped with DFG node has the
+// real DVFS level 1, which has the highest priority. The unmapped
+// island has lower priority though its DVFS level is also shown
+// as 1.
+static float DVFSMappedIslandTerm(PathCostContext* t_context) {
+  return t_context->DVFSAwareMapping and t_context->tile->isMapped() ? 1 : 0;
+}
+
+static float DVFSMatchedLevelTerm(PathCostContext* t_context) {
+  CGRANode* tile = t_context->tile;
+  return t_context->DVFSAwareMapping and tile->isSynced() and
+      tile->getDVFSLatencyMultiple() ==
+          t_context->dfgNode->getDVFSLatencyMultiple() ? 1 : 0;
+}
+
+static float DVFSUnsyncedIslandTerm(PathCostContext* t_context) {
+  return t_context->DVFSAwareMapping and !t_context->tile->isSynced() ? 1 : 0;
+}
+
+// Consider the cost of that the DFG node with multiple successor
+// might potentially occupy the surrounding CGRA nodes.
+static float neighborFanoutTerm(PathCostContext* t_context) {
+  int count = 0;
+  for (CGRANode* neighbor: *(t_context->tile->getNeighbors())) {
+    count += (*t_context->tileFanoutCounts)[neighbor->getID()];
+  }
+  return count;
+}
+
+// Consider the cost of occupying the leftmost (rightmost) CGRA
+// nodes that are reserved for load.
+static float loadStoreTileTerm(PathCostContext* t_context) {
+  DFGNode* dfgNode = t_context->dfgNode;
+  CGRANode* tile = t_context->tile;
+  return (!dfgNode->isLoad() and tile->canLoad()) or
+         (!dfgNode->isStore() and tile->canStore()) ? 1 : 0;
+}
+
+// Consider the bonus of reusing the same link for delivery the
+// same data to different destination CGRA nodes (multicast).
+static float multicastTerm(PathCostContext* t_context) {
+  Route* path = t_context->path;
+  int count = 0;
+  for (int h=1; h<path->size(); ++h) {
+    CGRALink* link = path->getHop(h)->link;
+    if (link != NULL and link->isReused(path->getHop(h-1)->cycle))
+      ++count;
+  }
+  return count;
+}
+
+// Consider the bonus of available links on the target CGRA nodes.
+static float freeInLinksTerm(PathCostContext* t_context) {
+  static thread_local vector<CGRALink*> occupiableInLinks;
+  t_context->tile->getOccupiableInLinks(t_context->cycle, t_context->II,
+                                        &occupiableInLinks);
+  return occupiableInLinks.size();
+}
+
+static float freeOutLinksTerm(PathCostContext* t_context) {
+  static thread_local vector<CGRALink*> occupiableOutLinks;
+  t_context->tile->getOccupiableOutLinks(t_context->cycle, t_context->II,
+                                         &occupiableOutLinks);
+  return occupiableOutLinks.size();
+}
+
+CostModel::CostModel() {
+  registerTerm("distance", distanceTerm, 1);
+  registerTerm("wait", waitTerm, 1.5, COST_PER_UNIT);
+  registerTerm("localPath", localPathTerm, 2);
+  registerTerm("ctrlMem", ctrlMemTerm, 1);
+  registerTerm("outPorts", outPortsTerm, 1, COST_WITH_NEXT);
+  registerTerm("centrality", centralityTerm, 1);
+  registerTerm("predFanout", predFanoutTerm, -0.5, COST_PER_UNIT);
+  registerTerm("DVFSMappedIsland", DVFSMappedIslandTerm, -0.3);
+  registerTerm("DVFSMatchedLevel", DVFSMatchedLevelTerm, -1.0);
+  registerTerm("DVFSUnsyncedIsland", DVFSUnsyncedIslandTerm, -0.2);
+  registerTerm("neighborFanout", neighborFanoutTerm, 0.4, COST_PER_UNIT);
+  registerTerm("loadStoreTile", loadStoreTileTerm, 2);
+  registerTerm("multicast", multicastTerm, -0.5, COST_PER_UNIT);
+  registerTerm("freeInLinks", freeInLinksTerm, -0.3, COST_WITH_NEXT);
+  registerTerm("freeOutLinks", freeOutLinksTerm, -0.3);
+}
+
+void CostModel::registerTerm(string t_name, CostTermFunction t_function,
+    double t_weight, CostAccumulation t_accumulation) {
+  for (CostTerm& term: m_terms) {
+    if (term.name == t_name) {
+      term.function = t_function;
+      term.weight = t_weight;
+      term.accumulation = t_accumulation;
+      return;
+    }
+  }
+  CostTerm term;
+  term.name = t_name;
+  term.function = t_function;
+  term.weight = t_weight;
+  term.accumulation = t_accumulation;
+  m_terms.push_back(term);
+}
+
+bool CostModel::setWeight(string t_name, double t_weight) {
+  for (CostTerm& term: m_terms) {
+    if (term.name == t_name) {
+      term.weight = t_weight;
+      return true;
+    }
+  }
+  return false;
+}
+
+double CostModel::getWeight(string t_name) {
+  for (CostTerm& term: m_terms) {
+    if (term.name == t_name)
+      return term.weight;
+  }
+  return 0;
+}
+
+int CostModel::getTermCount() {
+  return m_terms.size();
+}
+
+CostTerm* CostModel::getTerm(int t_index) {
+  return &m_terms[t_index];
+}
+
+float CostModel::getCost(PathCostContext* t_context) {
+  float cost = 0;
+  // The weighted values waiting for the next term added in one step.
+  double pending = 0;
+  for (CostTerm& term: m_terms) {
+    // A disabled term is not even evaluated.
+    float value = term.weight != 0 ? term.function(t_context) : 0;
+    if (term.accumulation == COST_WITH_NEXT) {
+      pending += term.weight * value;
+    } else if (term.accumulation == COST_PER_UNIT) {
+      for (int unit=0; unit<value; ++unit) {
+        cost += term.weight;
+      }
+    } else {
+      cost += pending + term.weight * value;
+      pending = 0;
+    }
+  }
+  return cost + pending;
+}
+
+void CostModel::getTermValues(PathCostContext* t_context,
+    vector<float>* t_values) {
+  t_values->clear();
+  for (CostTerm& term: m_terms) {
+    t_values->push_back(term.function(t_context));
+  }
+}
@@ -0,0 +1,92 @@
+/*
+ * ======================================================================
+ * CostModel.h
+ * ======================================================================
+ * Weighted cost terms of the placement header file.
+ *
+ * Date : October 16, 2026
+ */
+
+#ifndef CostModel_H
+#define CostModel_H
+
+#include <string>
+#include <vector>
+
+using namespace std;
+
+class CGRA;
+class CGRANode;
+class DFGNode;
+class DFGView;
+class Route;
+
+// Everything a cost term may read about placing the DFG node (index in
+// the view) onto the last tile of the path.
+struct PathCostContext {
+  CGRA* cgra;
+  int II;
+  DFGView* view;
+  int index;
+  DFGNode* dfgNode;
+  Route* path;
+  CGRANode* tile;
+  int cycle;
+  bool DVFSAwareMapping;
+  // The tile each DFG node is mapped onto (or NULL), indexed as in view.
+  vector<CGRANode*>* mappedTiles;
+  // The number of nodes with more than two successors on each tile.
+  vector<int>* tileFanoutCounts;
+};
+
+// The raw (unweighted) value of a term, e.g., the number of free links.
+typedef float (*CostTermFunction)(PathCostContext*);
+
+// How the weighted value of a term is added onto the cost. The built-in
+// terms add up in the same steps as the hand-written cost they replace,
+// so that the float rounding (and thus the ties between the candidates)
+// stays the same with the default weights.
+enum CostAccumulation {
+  // The weight times the value, in one step.
+  COST_ONCE,
+  // The weight once per unit of the value, e.g., per wait along the path.
+  COST_PER_UNIT,
+  // Summed with the weighted value of the next term added in one step.
+  COST_WITH_NEXT
+};
+
+struct CostTerm {
+  string name;
+  CostTermFunction function;
+  double weight;
+  CostAccumulation accumulation;
+};
+
+// The cost of a candidate placement is the weighted sum of its terms,
+// lower being better. The built-in terms come with the weights that were
+// tuned on 4x4 meshes, which can be overridden per term (see
+// "costWeights" in param.json), and other terms can be registered on
+// top. The terms only read the context, so the candidates are costed
+// concurrently.
+class CostModel {
+  private:
+    vector<CostTerm> m_terms;
+
+  public:
+    CostModel();
+    // Adds a term, or replaces the function, weight, and accumulation of
+    // the term with the same name.
+    void registerTerm(string, CostTermFunction, double,
+                      CostAccumulation t_accumulation=COST_ONCE);
+    // Returns false if there is no term with the name.
+    bool setWeight(string, double);
+    double getWeight(string);
+    int getTermCount();
+    CostTerm* getTerm(int);
+    float getCost(PathCostContext*);
+    // The raw value of each term in the order of registration, which the
+    // weights can be fitted against.
+    void getTermValues(PathCostContext*, vector<float>*);
+};
+
+#endif
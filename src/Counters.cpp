@@ -0,0 +1,122 @@
+/*
+ * ======================================================================
+ * Counters.cpp
+ * ======================================================================
+ * Per-thread event counters of the mapping implementation.
+ *
+ * Date : October 16, 2026
+ */
+
+#include "Counters.h"
+#include <mutex>
+#include <set>
+
+static const char* s_names[COUNTER_COUNT] = {
+  "routerSearches",
+  "tryToRoute",
+  "linkProbes",
+  "tileProbes",
+  "placements",
+  "candidatePaths",
+  "schedules",
+  "scheduleFailsPredRoute",
+  "scheduleFailsSuccRoute",
+  "routeFailsIIViolation",
+  "routeFailsNoPath",
+  "routeFailsTooLate",
+  "routeFailsBackedge",
+  "DFSBacktracks",
+  "regsAllocated",
+  "regsRejected"
+};
+
+static const char* s_descriptions[COUNTER_COUNT] = {
+  "Number of shortest path searches",
+  "Number of routings between two mapped DFG nodes",
+  "Number of link occupancy checks",
+  "Number of tile occupancy checks",
+  "Number of DFG nodes whose candidate paths are ranked",
+  "Number of candidate paths ranked",
+  "Number of schedules",
+  "Number of schedules failing to route a predecessor",
+  "Number of schedules failing to route a successor",
+  "Number of routings violating the II of a recurrence",
+  "Number of routings without any path",
+  "Number of routings beyond the mapping cycles",
+  "Number of routings failing on a backedge",
+  "Number of backtracks of the exhaustive search",
+  "Number of registers allocated",
+  "Number of register allocations without a free register"
+};
+
+// The blocks of the live threads, and the counts of the exited ones. The
+// registry is allocated once and never destructed, as the threads (e.g.,
+// the OpenMP workers) may exit after the static destructors have run.
+struct CounterRegistry {
+  mutex lock;
+  set<CounterBlock*> blocks;
+  long retired[COUNTER_COUNT];
+  CounterRegistry() {
+    for (int i=0; i<COUNTER_COUNT; ++i) {
+      retired[i] = 0;
+    }
+  }
+};
+
+static CounterRegistry* getRegistry() {
+  static CounterRegistry* registry = new CounterRegistry();
+  return registry;
+}
+
+CounterBlock::CounterBlock() {
+  for (int i=0; i<COUNTER_COUNT; ++i) {
+    values[i] = 0;
+  }
+  CounterRegistry* registry = getRegistry();
+  lock_guard<mutex> guard(registry->lock);
+  registry->blocks.insert(this);
+}
+
+CounterBlock::~CounterBlock() {
+  CounterRegistry* registry = getRegistry();
+  lock_guard<mutex> guard(registry->lock);
+  for (int i=0; i<COUNTER_COUNT; ++i) {
+    registry->retired[i] += values[i];
+  }
+  registry->blocks.erase(this);
+}
+
+long Counters::get(Counter t_counter) {
+  CounterRegistry* registry = getRegistry();
+  lock_guard<mutex> guard(registry->lock);
+  long total = registry->retired[t_counter];
+  for (CounterBlock* block: registry->blocks) {
+    total += block->values[t_counter];
+  }
+  return total;
+}
+
+const char* Counters::getName(Counter t_counter) {
+  return s_names[t_counter];
+}
+
+const char* Counters::getDescription(Counter t_counter) {
+  return s_descriptions[t_counter];
+}
+
+void Counters::reset() {
+  CounterRegistry* registry = getRegistry();
+  lock_guard<mutex> guard(registry->lock);
+  for (int i=0; i<COUNTER_COUNT; ++i) {
+    registry->retired[i] = 0;
+    for (CounterBlock* block: registry->blocks) {
+      block->values[i] = 0;
+    }
+  }
+}
+
+void Counters::dump(ostream& t_stream) {
+  for (int i=0; i<COUNTER_COUNT; ++i) {
+    t_stream<<"[counter] "<<s_names[i]<<": "<<get((Counter)i)<<"\n";
+  }
+}
@@ -0,0 +1,70 @@
+/*
+ * ======================================================================
+ * Counters.h
+ * ======================================================================
+ * Per-thread event counters of the mapping header file.
+ *
+ * Date : October 16, 2026
+ */
+
+#ifndef Counters_H
+#define Counters_H
+
+#include <iostream>
+
+using namespace std;
+
+enum Counter {
+  COUNTER_ROUTER_SEARCHES,
+  COUNTER_TRY_TO_ROUTE,
+  COUNTER_LINK_PROBES,
+  COUNTER_TILE_PROBES,
+  // The DFG nodes whose candidate paths are ranked, and those paths.
+  COUNTER_PLACEMENTS,
+  COUNTER_CANDIDATE_PATHS,
+  COUNTER_SCHEDULES,
+  COUNTER_SCHEDULE_FAILS_PRED_ROUTE,
+  COUNTER_SCHEDULE_FAILS_SUCC_ROUTE,
+  // Why tryToRoute() fails.
+  COUNTER_ROUTE_FAILS_II_VIOLATION,
+  COUNTER_ROUTE_FAILS_NO_PATH,
+  COUNTER_ROUTE_FAILS_TOO_LATE,
+  COUNTER_ROUTE_FAILS_BACKEDGE,
+  COUNTER_DFS_BACKTRACKS,
+  COUNTER_REGS_ALLOCATED,
+  COUNTER_REGS_REJECTED,
+  COUNTER_COUNT
+};
+
+// The counters of one thread, which only that thread writes. The values
+// are folded into the retired counters when the thread exits.
+struct CounterBlock {
+  long values[COUNTER_COUNT];
+  CounterBlock();
+  ~CounterBlock();
+};
+
+// Counts the events in the search (e.g., the routing attempts and why
+// they fail) on the mapping threads, without any synchronization on the
+// hot paths. The totals are only meant to be read once the threads are
+// done, e.g., at the end of the pass.
+class Counters {
+  private:
+    static CounterBlock* getBlock() {
+      static thread_local CounterBlock block;
+      return &block;
+    }
+
+  public:
+    static void add(Counter t_counter, long t_value=1) {
+      getBlock()->values[t_counter] += t_value;
+    }
+    // The total across the threads.
+    static long get(Counter);
+    static const char* getName(Counter);
+    static const char* getDescription(Counter);
+    static void reset();
+    static void dump(ostream&);
+};
+
+#endif
@@ -10,17 +10,22 @@
  */
 
 #include <fstream>
+#include <assert.h>
 #include "DFG.h"
+#include "Log.h"
+#include "Profiler.h"
+#include "json.hpp"
 
-DFG::DFG(Function& t_F, list<Loop*>* t_loops, bool t_targetFunction,
-         bool t_precisionAware, list<string>* t_fusionStrategy,
-         map<string, int>* t_execLatency, list<string>* t_pipelinedOpt,
-         map<string, list<string>*>* t_fusionPattern,
-	      bool t_supportDVFS, bool t_DVFSAwareMapping,
-	      int t_vectorFactorForIdiv, bool enableDistributed) {
+using json = nlohmann::json;
+using ordered_json = nlohmann::ordered_json;
+
+void DFG::init(bool t_precisionAware, bool t_supportDVFS,
+               bool t_DVFSAwareMapping, int t_vectorFactorForIdiv,
+               int t_maxCycleCount) {
   m_num = 0;
-  m_targetFunction = t_targetFunction;
-  m_targetLoops = t_loops;
+  m_maxCycleCount = t_maxCycleCount;
+  m_targetFunction = true;
+  m_targetLoops = NULL;
   m_orderedNodes = NULL;
   m_CDFGFused = false;
   m_cycleNodeLists = new list<list<DFGNode*>*>();
@@ -28,30 +33,46 @@ DFG::DFG(Function& t_F, list<Loop*>* t_loops, bool t_targetFunction,
   m_supportDVFS = t_supportDVFS;
   m_DVFSAwareMapping = t_DVFSAwareMapping;
   m_vectorFactorForIdiv = t_vectorFactorForIdiv;
+}
 
-  construct(t_F);
+DFG::DFG(bool t_precisionAware, bool t_supportDVFS, bool t_DVFSAwareMapping,
+         int t_maxCycleCount) {
+  init(t_precisionAware, t_supportDVFS, t_DVFSAwareMapping, 4,
+       t_maxCycleCount);
+}
+
+// Fuses the patterns and sets up the multi-cycle and pipelinable nodes of
+// the constructed DFG.
+void DFG::transform(list<string>* t_fusionStrategy,
+                    map<string, int>* t_execLatency,
+                    list<string>* t_pipelinedOpt,
+                    map<string, list<string>*>* t_fusionPattern,
+                    bool enableDistributed) {
   bool needsCycleCalculation = false;
-  for (auto strategy : *t_fusionStrategy) {
-    if (strategy == "default_heterogeneous") {
-      combine("phi", "add", "Ctrl");
-      combine("phi", "fadd", "Ctrl");
-      combine("fcmp", "select", "Ctrl");
-      combine("icmp", "select", "Ctrl");
-      combine("icmp", "br", "Ctrl");
-      combine("fcmp", "br", "Ctrl");
-      tuneForPattern();
-      needsCycleCalculation = true;
-    }
-    else if (strategy == "nonlinear") {
-      nonlinear_combine();
-      needsCycleCalculation = true;
-    }
-    else if (strategy == "ctrl_flow") {
-      ctrlFlow_combine(t_fusionPattern);
-      needsCycleCalculation = true;
-    }
-    else {
-      cout << "Error: Unknown strategy '" << strategy << "'\n";
+  {
+    ScopedTimer timer("dfg.fuse");
+    for (auto strategy : *t_fusionStrategy) {
+      if (strategy == "default_heterogeneous") {
+        combine("phi", "add", "Ctrl");
+        combine("phi", "fadd", "Ctrl");
+        combine("fcmp", "select", "Ctrl");
+        combine("icmp", "select", "Ctrl");
+        combine("icmp", "br", "Ctrl");
+        combine("fcmp", "br", "Ctrl");
+        tuneForPattern();
+        needsCycleCalculation = true;
+      }
+      else if (strategy == "nonlinear") {
+        nonlinear_combine();
+        needsCycleCalculation = true;
+      }
+      else if (strategy == "ctrl_flow") {
+        ctrlFlow_combine(t_fusionPattern);
+        needsCycleCalculation = true;
+      }
+      else {
+        cout << "Error: Unknown strategy '" << strategy << "'\n";
+      }
     }
   }
   if (needsCycleCalculation) {
@@ -63,12 +84,20 @@ DFG::DFG(Function& t_F, list<Loop*>* t_loops, bool t_targetFunction,
     splitNodes();
   }
   calculateCycles();
+
+  // The predecessor/successor lists are otherwise built lazily on first
+  // use, builds them here so that the mapper only ever reads them.
+  for (DFGNode* node: nodes) {
+    node->getPredNodes();
+    node->getSuccNodes();
+  }
 }
 
 // Split multi-cycle nodes in the DFG into multiple single-cycle nodes when distributed strategy is adopted.
 // Example: Division takes 8 cycles on our hardware, so each division node in the DFG should be split into 8 sub-nodes, each of which only needs to perform one cycle of division execution.
 // The cycles of the multi-cycle operations are specified by `optLatency` in param.json.
 void DFG::splitNodes() {
+  ScopedTimer timer("dfg.split");
   list<DFGNode*>* add_nodes = new list<DFGNode*>();
   int dfgNodeID = nodes.size();
   for (DFGNode* dfgNode: nodes) {
@@ -83,7 +112,7 @@ void DFG::splitNodes() {
         int dfgEdgeID = m_DFGEdges.size();
         DFGEdge* newEdge = new DFGEdge(dfgEdgeID++, nowNode, newNode);
         newNode->setExecLatency(1);
-        m_DFGEdges.push_back(newEdge);
+        addDFGEdge(newEdge);
         // nodes.push_back(newNode);
         add_nodes->push_back(newNode);
         // Update the pred and succ nodes of nods.
@@ -108,7 +137,7 @@ void DFG::splitNodes() {
   }
 
   for (DFGNode* dfgNode: *add_nodes) {
-    nodes.push_back(dfgNode);
+    appendNode(dfgNode);
   }
 }
 
@@ -164,9 +193,9 @@ void DFG::initDVFSLatencyMultiple(int t_II, int t_DVFSIslandDim,
       ((high_dvfs_dfg_nodes + num_tiles_in_island - 1) / num_tiles_in_island)) -
       (t_II * num_tiles_in_island *
        ((mid_dvfs_dfg_nodes + num_tiles_in_island - 1) / num_tiles_in_island))) / 4;
-  cout << "[debug] unused_high_dvfs_cgra_tiles_across_II: " << unused_high_dvfs_cgra_tiles_across_II << endl;
-  cout << "[debug] unused_mid_dvfs_cgra_tiles_across_II: " << unused_mid_dvfs_cgra_tiles_across_II << endl;
-  cout << "[debug] unused_low_dvfs_cgra_tiles_across_II: " << unused_low_dvfs_cgra_tiles_across_II << endl;
+  CGRA_LOG(LOG_DVFS, LOG_INFO) << "[debug] unused_high_dvfs_cgra_tiles_across_II: " << unused_high_dvfs_cgra_tiles_across_II << "\n";
+  CGRA_LOG(LOG_DVFS, LOG_INFO) << "[debug] unused_mid_dvfs_cgra_tiles_across_II: " << unused_mid_dvfs_cgra_tiles_across_II << "\n";
+  CGRA_LOG(LOG_DVFS, LOG_INFO) << "[debug] unused_low_dvfs_cgra_tiles_across_II: " << unused_low_dvfs_cgra_tiles_across_II << "\n";
 
   int unlabeled_dfg_nodes = 0;
   for (auto node : nodes) {
@@ -296,10 +325,10 @@ void DFG::tuneDivPattern() {
     }
   }
   for (DFGNode* dfgNode: *removeNodes) {
-    nodes.remove(dfgNode);
+    removeNode(dfgNode);
   }
   for (DFGNode *dfgNode: *splitNodes) {
-    nodes.push_back(dfgNode);
+    appendNode(dfgNode);
   }
 }
 
@@ -331,7 +360,7 @@ void DFG::tuneForPattern() {
       if (dfgNode->isPatternRoot()) {
         for (DFGNode* patternNode: *(dfgNode->getPatternNodes())) {
           if (hasDFGEdge(dfgNode, patternNode))
-            m_DFGEdges.remove(getDFGEdge(dfgNode, patternNode));
+            removeDFGEdge(getDFGEdge(dfgNode, patternNode));
           for (DFGNode* predNode: *(patternNode->getPredNodes())) {
             if (predNode == dfgNode or
                 predNode->isOneOfThem(dfgNode->getPatternNodes())) {
@@ -365,7 +394,7 @@ void DFG::tuneForPattern() {
     }
   }
   for (DFGNode* dfgNode: *removeNodes) {
-    nodes.remove(dfgNode);
+    removeNode(dfgNode);
   }
 }
 
@@ -627,245 +656,144 @@ void DFG::combineForUnroll(string type) {
   }
 }
 
-bool DFG::shouldIgnore(Instruction* t_inst) {
-  if (m_targetFunction) {
-    return false;
-  }
-  if (m_targetLoops->size() == 0)
-    return false;
-  for (Loop* current_loop: *m_targetLoops) {
-    if (current_loop->contains(t_inst)) {
-      return false;
+// Indexes the nodes in their current order, and collects the successors
+// of each node as indices. The successors that are not in the DFG (any
+// more) are left out.
+void DFG::indexSuccNodes(vector<DFGNode*>* t_indexedNodes,
+    vector<vector<int>>* t_succs) {
+  t_indexedNodes->assign(nodes.begin(), nodes.end());
+  int nodeCount = t_indexedNodes->size();
+  unordered_map<DFGNode*, int> nodeIndex;
+  for (int i=0; i<nodeCount; ++i) {
+    nodeIndex[(*t_indexedNodes)[i]] = i;
+  }
+  t_succs->assign(nodeCount, vector<int>());
+  for (int i=0; i<nodeCount; ++i) {
+    for (DFGNode* succNode: *((*t_indexedNodes)[i]->getSuccNodes())) {
+      auto succ = nodeIndex.find(succNode);
+      if (succ != nodeIndex.end()) {
+        (*t_succs)[i].push_back(succ->second);
+      }
     }
   }
-  return true;
 }
 
 list<DFGNode*>* DFG::getDFSOrderedNodes() {
-  if (m_orderedNodes != NULL)
-    return m_orderedNodes;
-  m_orderedNodes = new list<DFGNode*>();
-  list<DFGNode*> tempNodes;
-  while (m_orderedNodes->size() < nodes.size()) {
-    DFGNode* startNode = NULL;
-    int curWithMaxSucc = 0;
-    for (DFGNode* dfgNode: nodes) {
-      if (find(m_orderedNodes->begin(), m_orderedNodes->end(), dfgNode) ==
-          m_orderedNodes->end()) {
-        if (dfgNode->getSuccNodes()->size() > curWithMaxSucc) {
-          curWithMaxSucc = dfgNode->getSuccNodes()->size();
-          startNode = dfgNode;
-        }
-      }
+  if (m_orderedNodes == NULL)
+    m_orderedNodes = new list<DFGNode*>();
+  m_orderedNodes->clear();
+  vector<DFGNode*> indexedNodes;
+  vector<vector<int>> succs;
+  indexSuccNodes(&indexedNodes, &succs);
+  int nodeCount = indexedNodes.size();
+
+  // Each DFS starts from the not yet ordered node with the most successors
+  // (the first one in the node order among the equal ones), so the nodes
+  // are bucketed by their successor count once.
+  int maxSuccCount = 0;
+  for (DFGNode* dfgNode: indexedNodes) {
+    maxSuccCount = max(maxSuccCount, (int)dfgNode->getSuccNodes()->size());
+  }
+  vector<int> startCandidates;
+  vector<vector<int>> succCountBuckets(maxSuccCount + 1);
+  for (int i=0; i<nodeCount; ++i) {
+    succCountBuckets[indexedNodes[i]->getSuccNodes()->size()].push_back(i);
+  }
+  for (int count=maxSuccCount; count>=0; --count) {
+    startCandidates.insert(startCandidates.end(),
+        succCountBuckets[count].begin(), succCountBuckets[count].end());
+  }
+
+  vector<bool> ordered(nodeCount, false);
+  // Each frame is a node together with the next successor to check.
+  vector<pair<int, int>> frames;
+  for (int start: startCandidates) {
+    if (ordered[start]) {
+      continue;
     }
-    if (startNode != NULL) {
-      assert( find(m_orderedNodes->begin(), m_orderedNodes->end(), startNode) ==
-          m_orderedNodes->end() );
-      tempNodes.push_back(startNode);
-      m_orderedNodes->push_back(startNode);
-    }
-//    for (DFGNode* dfgNode: nodes) {
-//      if (find(m_orderedNodes->begin(), m_orderedNodes->end(), dfgNode) ==
-//          m_orderedNodes->end()) {
-//        tempNodes.push_back(dfgNode);
-//        m_orderedNodes->push_back(dfgNode);
-//        break;
-//      }
-//    }
-    DFGNode* currentNode;
-    while (tempNodes.size() != 0) {
-      currentNode = tempNodes.back();
-      list<DFGNode*>* succNodes = currentNode->getSuccNodes();
-      bool canPop = true;
-      for (DFGNode* succNode: *succNodes) {
-        if (find(m_orderedNodes->begin(), m_orderedNodes->end(), succNode) ==
-            m_orderedNodes->end()) {
-          tempNodes.push_back(succNode);
-          canPop = false;
-          m_orderedNodes->push_back(succNode);
-          break;
+    ordered[start] = true;
+    m_orderedNodes->push_back(indexedNodes[start]);
+    frames.push_back(make_pair(start, 0));
+    while (!frames.empty()) {
+      int current = frames.back().first;
+      if (frames.back().second < (int)succs[current].size()) {
+        int succ = succs[current][frames.back().second++];
+        if (!ordered[succ]) {
+          ordered[succ] = true;
+          m_orderedNodes->push_back(indexedNodes[succ]);
+          frames.push_back(make_pair(succ, 0));
         }
-      }
-      if (canPop) {
-        tempNodes.pop_back();
+      } else {
+        frames.pop_back();
       }
     }
   }
-  cout<<"\nordered nodes: \n";
+  CGRA_LOG(LOG_DFG, LOG_INFO)<<"\nordered nodes: \n";
   for (DFGNode* dfgNode: *m_orderedNodes) {
-    cout<<dfgNode->getID()<<"  ";
+    CGRA_LOG(LOG_DFG, LOG_INFO)<<dfgNode->getID()<<"  ";
   }
-  cout<<"\n";
+  CGRA_LOG(LOG_DFG, LOG_INFO)<<"\n";
   assert(m_orderedNodes->size() == nodes.size());
   return m_orderedNodes;
 }
 
 list<DFGNode*>* DFG::getBFSOrderedNodes() {
-  if (m_orderedNodes != NULL)
-    return m_orderedNodes;
-  m_orderedNodes = new list<DFGNode*>();
-  list<DFGNode*> tempNodes;
-  while (m_orderedNodes->size() < nodes.size()) {
-    for (DFGNode* dfgNode: nodes) {
-      if (find(m_orderedNodes->begin(), m_orderedNodes->end(), dfgNode) ==
-            m_orderedNodes->end()) {
-        tempNodes.push_back(dfgNode);
-        m_orderedNodes->push_back(dfgNode);
-        break;
-      }
+  if (m_orderedNodes == NULL)
+    m_orderedNodes = new list<DFGNode*>();
+  m_orderedNodes->clear();
+  vector<DFGNode*> indexedNodes;
+  vector<vector<int>> succs;
+  indexSuccNodes(&indexedNodes, &succs);
+  int nodeCount = indexedNodes.size();
+
+  // Each BFS starts from the first not yet ordered node.
+  vector<bool> ordered(nodeCount, false);
+  vector<int> queue;
+  queue.reserve(nodeCount);
+  for (int start=0; start<nodeCount; ++start) {
+    if (ordered[start]) {
+      continue;
     }
-    DFGNode* currentNode;
-    while (tempNodes.size() != 0) {
-      currentNode = tempNodes.front();
-      tempNodes.pop_front();
-      for (DFGNode* succNode: *currentNode->getSuccNodes()) {
-        if (find(m_orderedNodes->begin(), m_orderedNodes->end(), succNode) ==
-            m_orderedNodes->end()) {
-          tempNodes.push_back(succNode);
-          m_orderedNodes->push_back(succNode);
+    ordered[start] = true;
+    queue.push_back(start);
+    for (int head=queue.size()-1; head<(int)queue.size(); ++head) {
+      int current = queue[head];
+      m_orderedNodes->push_back(indexedNodes[current]);
+      for (int succ: succs[current]) {
+        if (!ordered[succ]) {
+          ordered[succ] = true;
+          queue.push_back(succ);
         }
       }
     }
   }
-  cout<<"\nordered nodes: \n";
+  CGRA_LOG(LOG_DFG, LOG_INFO)<<"\nordered nodes: \n";
   for (DFGNode* dfgNode: *m_orderedNodes) {
-    cout<<dfgNode->getID()<<"  ";
+    CGRA_LOG(LOG_DFG, LOG_INFO)<<dfgNode->getID()<<"  ";
   }
-  cout<<"\n";
+  CGRA_LOG(LOG_DFG, LOG_INFO)<<"\n";
   assert(m_orderedNodes->size() == nodes.size());
   return m_orderedNodes;
 }
 
- // extract DFG from specific function
- void DFG::construct(Function& t_F) {
-
-  m_DFGEdges.clear();
+// Reorder the DFG nodes in the given traversal order for mapping.
+void DFG::reorderInTraversal(list<DFGNode*>* t_orderedNodes, string t_order) {
+  ScopedTimer timer("dfg.reorder");
+  list<DFGNode*> tempNodes(t_orderedNodes->begin(), t_orderedNodes->end());
   nodes.clear();
-  m_ctrlEdges.clear();
-  m_targetBBs.clear();
-
-  int nodeID = 0;
-  int ctrlEdgeID = 0;
-  int dfgEdgeID = 0;
-  int bbID =0;
-
-  cout<<"*** current function: "<<t_F.getName().str()<<"\n";
-
-  // construct DFG Nodes.
-  for (Function::iterator BB=t_F.begin(), BEnd=t_F.end(); BB!=BEnd; ++BB) {
-    BasicBlock *curBB = &*BB;
-    bool isTargetBB = false;
-    errs()<<"└── *** current basic block: "<<curBB->getName().str()<<"; First Inst: "<<*curBB->begin()<<"\n";
-    for (BasicBlock::iterator II=curBB->begin(), IEnd=curBB->end(); II!=IEnd; ++II) {
-      Instruction* curII = &*II;
-      if (shouldIgnore(curII)) {
-        errs()<<"│   └── *** ignored by pass because instruction \""<<*curII<<"\" is out of the scope (target loop)."<<"\n";
-        continue;
-      }
-      else {
-        isTargetBB = true;
-        DFGNode* dfgNode;
-        dfgNode = new DFGNode(nodeID++, m_precisionAware, curII, getValueName(curII), m_supportDVFS);
-        dfgNode->setBBID(bbID);
-        nodes.push_back(dfgNode);
-        errs()<<"│   └── +++ \""<<*curII<<"\" (ID: "<<dfgNode->getID()<<")"<<"\n";
-      }
-    }
-    if(isTargetBB) {
-      errs()<<"└── +++ basic block \""<<curBB->getName().str()<<"\" got ID: "<<bbID<<"\n│\n";
-      m_targetBBs.push_back(curBB);
-      bbID += 1;
-    }
-    else{
-      errs()<<"└── *** ignored by pass because basic block \""<<curBB->getName().str()<<"\" is out of the scope (target loop)."<<"\n│\n";
-    }
-  }
-
-  // construct ctrl flows.
-  // consider 3 types in function "isLiveInInst".
-  // 1. pointed to "sucBB->front()"
-  // 2. pointed to "lonely inst"(i.e. an inst without any flow pointed to it)
-  // 3. pointed to an inst without [intra-iteration & intra-basicblock] data flow pointed to it.
-  for (BasicBlock* curBB : m_targetBBs) {
-    errs()<<"│\n";
-    errs()<<"└── *** curBB: "<<curBB->getName().str()<<"; First Inst: "<<*curBB->begin()<<"\n";
-    Instruction* terminator = curBB->getTerminator();
-    if(shouldIgnore(terminator)) {
-      errs()<<"│   └── *** ignore terminator instruction \""<<*terminator<<"\""<<"\n";
-      continue;
-    }
-    else {
-      errs()<<"│   ├── *** find terminator instruction of curBB: "<<*terminator<<"\n";
-      for(BasicBlock* sucBB : successors(curBB)) {
-        auto it = find(m_targetBBs.begin(), m_targetBBs.end(), sucBB);
-        if(it == m_targetBBs.end()) {
-          errs()<<"│   └── *** ignore sucBB \""<<sucBB->getName().str()<<"\""<<"\n";
-          continue;
-        }
-        else {
-          errs()<<"│   ├── *** into sucBB \""<<sucBB->getName().str()<<"\""<<"\n";
-          for(BasicBlock::iterator II = sucBB->begin(), IEnd = sucBB->end(); II != IEnd; ++II) {
-            Instruction* instruction = &*II;
-            if(isLiveInInst(sucBB,instruction)) {
-              errs()<<"│   │   └── +++ construct ctrl flow: "<<*terminator<<"->"<<*instruction<<"\n";
-              DFGEdge* ctrlEdge;
-              if (hasCtrlEdge(getNode(terminator), getNode(instruction))) {
-                ctrlEdge = getCtrlEdge(getNode(terminator), getNode(instruction));
-              }
-              else {
-                ctrlEdge = new DFGEdge(ctrlEdgeID++, getNode(terminator), getNode(instruction), true);
-                m_ctrlEdges.push_back(ctrlEdge);
-              }
-            }
-          }
-        }
-      }
-    }
-  }
-
-  // construct data flow edges.
-  for (DFGNode* node: nodes) {
-    Instruction* curII = node->getInst();
-    for (Instruction::op_iterator op = curII->op_begin(), opEnd = curII->op_end(); op != opEnd; ++op) {
-      Instruction* tempInst = dyn_cast<Instruction>(*op);
-      if (tempInst and !shouldIgnore(tempInst)) {
-        DFGEdge* dfgEdge;
-        if (hasNode(tempInst)) {
-          if (hasDFGEdge(getNode(tempInst), node)) {
-            dfgEdge = getDFGEdge(getNode(tempInst), node);
-          }
-          else {
-            dfgEdge = new DFGEdge(dfgEdgeID++, getNode(tempInst), node);
-            if ((dfgEdge->getSrc()->getBBID() != dfgEdge->getDst()->getBBID())
-                or
-                ((dfgEdge->getSrc()->getBBID() == dfgEdge->getDst()->getBBID())
-                 and
-                 (dfgEdge->getSrc()->getID()) > (dfgEdge->getDst()->getID()))) {
-              dfgEdge->setInterEdge(true);
-            }
-            m_DFGEdges.push_back(dfgEdge);
-          }
-      }
-      else {
-        if(!node->isBranch()) {
-          node->addConst();
-        }
-      }
-    }
-    }
+  CGRA_LOG(LOG_DFG, LOG_INFO)<<"[reorder DFG in "<<t_order<<"]\n";
+  for (DFGNode* node: tempNodes) {
+    nodes.push_back(node);
+    if (CGRA_LOG_ENABLED(LOG_DFG, LOG_DEBUG)) cerr<<"("<<node->getID()<<") "<<node->getInstText()<<"\n";
   }
+}
 
-  connectDFGNodes();
-
-  calculateCycles();
-
-  // The mapping algorithm works on the DFG that is ordered in ASAP.
-  // reorderInASAP();
-  // The mapping algorithm works on the DFG that is ordered in ALAP.
-  // reorderInALAP();
-  // The mapping algorithm works on the DFG that is ordered along with the longest path.
-  reorderInLongest();
+void DFG::reorderInDFS() {
+  reorderInTraversal(getDFSOrderedNodes(), "DFS");
+}
 
+void DFG::reorderInBFS() {
+  reorderInTraversal(getBFSOrderedNodes(), "BFS");
 }
 
 // Reorder the DFG nodes in ASAP based on original sequential execution order.
@@ -899,113 +827,171 @@ void DFG::reorderInASAP() {
   }
 
   nodes.clear();
-  cout<<"[reorder DFG in ASAP]\n";
+  CGRA_LOG(LOG_DFG, LOG_INFO)<<"[reorder DFG in ASAP]\n";
   for (DFGNode* node: tempNodes) {
     nodes.push_back(node);
-    errs()<<"("<<node->getID()<<") "<<*(node->getInst())<<", level: "<<node->getLevel()<<"\n";
+    if (CGRA_LOG_ENABLED(LOG_DFG, LOG_DEBUG)) cerr<<"("<<node->getID()<<") "<<node->getInstText()<<", level: "<<node->getLevel()<<"\n";
   }
 }
 
-bool DFG::isMinimumAndHasNotBeenVisited(set<DFGNode*>* t_visited, map<DFGNode*, int>* t_map, DFGNode* t_node) {
-  if (t_visited->find(t_node) != t_visited->end()) {
-    return false;
-  }
-  for (DFGNode* e_node: nodes) {
-    if (e_node != t_node and t_visited->find(e_node) == t_visited->end() and (*t_map)[e_node] < (*t_map)[t_node]) {
-      return false;
+// Reorder the DFG nodes based on the longest path.
+void DFG::reorderInLongest() {
+  ScopedTimer timer("dfg.reorder");
+  vector<DFGNode*> indexedNodes;
+  vector<vector<int>> succs;
+  indexSuccNodes(&indexedNodes, &succs);
+  int nodeCount = indexedNodes.size();
+
+  // The longest simple path, i.e., the first of the longest ones found by
+  // a DFS from every node in the node order (following the successors in
+  // their order, and taking a path only if it is longer than the ones
+  // found before). A path is not extended any further once it cannot get
+  // longer than the longest one so far, bounding the nodes a path can
+  // still visit from a node by the longest chain of the strongly connected
+  // components reachable from it (each counting its size).
+  vector<vector<pair<int, int>>> sccSuccs(nodeCount);
+  for (int v=0; v<nodeCount; ++v) {
+    for (int w: succs[v]) {
+      sccSuccs[v].push_back(make_pair(w, 0));
+    }
+  }
+  vector<int> component;
+  getSCCs(&sccSuccs, &component);
+  // The components are numbered in the reverse topological order.
+  int componentCount = 0;
+  for (int c: component) {
+    componentCount = max(componentCount, c + 1);
+  }
+  vector<vector<int>> componentNodes(componentCount);
+  for (int v=0; v<nodeCount; ++v) {
+    componentNodes[component[v]].push_back(v);
+  }
+  vector<int> componentBound(componentCount, 0);
+  int maxBound = 0;
+  for (int c=0; c<componentCount; ++c) {
+    int succBound = 0;
+    for (int v: componentNodes[c]) {
+      for (int w: succs[v]) {
+        if (component[w] != c) {
+          succBound = max(succBound, componentBound[component[w]]);
+        }
+      }
     }
+    componentBound[c] = componentNodes[c].size() + succBound;
+    maxBound = max(maxBound, componentBound[c]);
   }
-  return true;
-}
 
-// Reorder the DFG nodes based on the longest path.
-void DFG::reorderInLongest() {
-  list<DFGNode*>* longestPath = new list<DFGNode*>();
-  list<DFGNode*>* currentPath = new list<DFGNode*>();
-  set<DFGNode*>* visited = new set<DFGNode*>();
-  map<DFGNode*, int> indegree;
-  for (DFGNode* node: nodes) {
-    indegree[node] = node->getPredNodes()->size();
-    currentPath->clear();
-    visited->clear();
-    reorderDFS(visited, longestPath, currentPath, node);
+  list<int> longestPath;
+  vector<bool> onPath(nodeCount, false);
+  // Each frame is a node of the current path together with the next
+  // successor to follow.
+  vector<pair<int, int>> frames;
+  for (int start=0; start<nodeCount; ++start) {
+    if ((int)longestPath.size() == maxBound) {
+      break;
+    }
+    if (componentBound[component[start]] <= (int)longestPath.size()) {
+      continue;
+    }
+    frames.push_back(make_pair(start, 0));
+    onPath[start] = true;
+    while (!frames.empty()) {
+      if ((int)frames.size() > (int)longestPath.size()) {
+        longestPath.clear();
+        for (pair<int, int>& frame: frames) {
+          longestPath.push_back(frame.first);
+        }
+      }
+      int v = frames.back().first;
+      if (frames.back().second < (int)succs[v].size()) {
+        int w = succs[v][frames.back().second++];
+        if (!onPath[w] and (int)frames.size() +
+            componentBound[component[w]] > (int)longestPath.size()) {
+          onPath[w] = true;
+          frames.push_back(make_pair(w, 0));
+        }
+        continue;
+      }
+      onPath[v] = false;
+      frames.pop_back();
+    }
   }
 
-  visited->clear();
+  vector<int> indegree(nodeCount);
+  vector<bool> visited(nodeCount, false);
+  for (int i=0; i<nodeCount; ++i) {
+    indegree[i] = indexedNodes[i]->getPredNodes()->size();
+  }
   int level = 0;
-  for (DFGNode* node: *longestPath) {
-    node->setLevel(level);
-    visited->insert(node);
-    //cout<<"check longest path node: "<<node->getID()<<endl;
-    for (DFGNode* succNode: *(node->getSuccNodes())) {
-      indegree[succNode] -= 1;
+  for (int v: longestPath) {
+    indexedNodes[v]->setLevel(level);
+    visited[v] = true;
+    for (int w: succs[v]) {
+      indegree[w] -= 1;
     }
     level += 1;
   }
   int maxLevel = level;
 
-  while (visited->size() < nodes.size()) {
-    for (DFGNode* node: nodes) {
-      // if (visited->find(node) == visited->end() and indegree[node] <= 0) {
-      if (isMinimumAndHasNotBeenVisited(visited, &indegree, node)) {
-        level = 0;
-        for (DFGNode* preNode: *(node->getPredNodes())) {
-          if (level < preNode->getLevel() + 1) {
-            level = preNode->getLevel() + 1;
-          }
-        }
-        node->setLevel(level);
-        visited->insert(node);
-        for (DFGNode* succNode: *(node->getSuccNodes())) {
-          indegree[succNode] -= 1;
-        }
+  // The remaining nodes are levelled in the order of their in-degree
+  // counting down. Among the nodes having the minimum in-degree, the one
+  // following the last levelled node in the node order goes first
+  // (wrapping around to the front).
+  set<pair<int, int>> ready;
+  for (int i=0; i<nodeCount; ++i) {
+    if (!visited[i]) {
+      ready.insert(make_pair(indegree[i], i));
+    }
+  }
+  int position = 0;
+  while (!ready.empty()) {
+    int minIndegree = ready.begin()->first;
+    auto next = ready.lower_bound(make_pair(minIndegree, position));
+    if (next == ready.end() or next->first != minIndegree) {
+      next = ready.begin();
+    }
+    int v = next->second;
+    ready.erase(next);
+    DFGNode* node = indexedNodes[v];
+    level = 0;
+    for (DFGNode* preNode: *(node->getPredNodes())) {
+      if (level < preNode->getLevel() + 1) {
+        level = preNode->getLevel() + 1;
       }
     }
-  }
-
-  list<DFGNode*> tempNodes;
-  for (int l=0; l<maxLevel+1; ++l) {
-    for (DFGNode* node: nodes) {
-      if (node->getLevel() == l) {
-        tempNodes.push_back(node);
+    node->setLevel(level);
+    if (maxLevel < level) {
+      maxLevel = level;
+    }
+    visited[v] = true;
+    for (int w: succs[v]) {
+      if (!visited[w]) {
+        ready.erase(make_pair(indegree[w], w));
+        ready.insert(make_pair(indegree[w] - 1, w));
       }
+      indegree[w] -= 1;
     }
+    position = v + 1;
   }
 
-  nodes.clear();
-  cout<<"[reorder DFG along with the longest path]\n";
-  for (DFGNode* node: tempNodes) {
-    nodes.push_back(node);
-    errs()<<"("<<node->getID()<<") "<<*(node->getInst())<<", level: "<<node->getLevel()<<"\n";
-  }
-
-}
-
-void DFG::reorderDFS(set<DFGNode*>* t_visited, list<DFGNode*>* t_targetPath,
-                     list<DFGNode*>* t_curPath, DFGNode* targetDFGNode) {
-
-  t_visited->insert(targetDFGNode);
-  t_curPath->push_back(targetDFGNode);
-
-  // Update target longest path if current one is longer.
-  if (t_curPath->size() > t_targetPath->size()) {
-    t_targetPath->clear();
-    for (DFGNode* node: *t_curPath) {
-      t_targetPath->push_back(node);
-    }
+  vector<list<DFGNode*>> levelNodes(maxLevel + 1);
+  for (DFGNode* node: indexedNodes) {
+    levelNodes[node->getLevel()].push_back(node);
   }
 
-  for (DFGNode* succNode: *(targetDFGNode->getSuccNodes())) {
-    if (t_visited->find(succNode) == t_visited->end()) { // not visited yet
-      reorderDFS(t_visited, t_targetPath, t_curPath, succNode);
-      t_visited->erase(succNode);
-      t_curPath->pop_back();
+  nodes.clear();
+  CGRA_LOG(LOG_DFG, LOG_INFO)<<"[reorder DFG along with the longest path]\n";
+  for (list<DFGNode*>& sameLevelNodes: levelNodes) {
+    for (DFGNode* node: sameLevelNodes) {
+      nodes.push_back(node);
+      if (CGRA_LOG_ENABLED(LOG_DFG, LOG_DEBUG)) cerr<<"("<<node->getID()<<") "<<node->getInstText()<<", level: "<<node->getLevel()<<"\n";
     }
   }
 
 }
 
 void DFG::reorderInCriticalFirst() {
+  ScopedTimer timer("dfg.reorder");
   // Step 1: Uses longest path ordering to initialize levels.
   reorderInLongest();
 
@@ -1025,14 +1011,14 @@ void DFG::reorderInCriticalFirst() {
   nodes.clear();
   for (DFGNode* node : criticalNodes) {
     nodes.push_back(node);
-    errs() << "[CRITICAL] (" << node->getID() << ") " << *(node->getInst()) << "\n";
+    if (CGRA_LOG_ENABLED(LOG_DFG, LOG_DEBUG)) cerr << "[CRITICAL] (" << node->getID() << ") " << node->getInstText() << "\n";
   }
   for (DFGNode* node : nonCriticalNodes) {
     nodes.push_back(node);
-    errs() << "[NON-CRITICAL] (" << node->getID() << ") " << *(node->getInst()) << "\n";
+    if (CGRA_LOG_ENABLED(LOG_DFG, LOG_DEBUG)) cerr << "[NON-CRITICAL] (" << node->getID() << ") " << node->getInstText() << "\n";
   }
 
-  std::cout << "[reorder DFG with critical path nodes first]\n";
+  CGRA_LOG(LOG_DFG, LOG_INFO) << "[reorder DFG with critical path nodes first]\n";
 }
 
 bool DFG::isNodeOnCriticalPath(DFGNode* t_node) {
@@ -1086,10 +1072,10 @@ void DFG::reorderInALAP() {
   }
 
   nodes.clear();
-  cout<<"[reorder DFG in ALAP]\n";
+  CGRA_LOG(LOG_DFG, LOG_INFO)<<"[reorder DFG in ALAP]\n";
   for (DFGNode* node: tempNodes) {
     nodes.push_back(node);
-    errs()<<"("<<node->getID()<<") "<<*(node->getInst())<<", level: "<<node->getLevel()<<"\n";
+    if (CGRA_LOG_ENABLED(LOG_DFG, LOG_DEBUG)) cerr<<"("<<node->getID()<<") "<<node->getInstText()<<", level: "<<node->getLevel()<<"\n";
   }
 }
 
@@ -1138,91 +1124,6 @@ void DFG::initPipelinedOpt(list<string>* t_pipelinedOpt) {
   }
 }
 
- bool DFG::isLiveInInst(BasicBlock* t_bb, Instruction* t_inst) {
-   // FOR DEBUG
- //  errs()<<"[FOR DEBUG] "<<"current inst: "<<*t_inst<<"\n";
- //  errs()<<"            "<<"op used:"<<"\n";
- //  for (Instruction::op_iterator op = t_inst->op_begin(), opEnd = t_inst->op_end(); op != opEnd; ++op) {
- //    Value *operand = *op;
- //    if(operand->hasName()) {
- //      errs()<<"            "<<operand->getName()<<"\n";
- //    }
- //    else {
- //      errs()<<"            ";
- //      operand->print(errs());
- //      errs()<<"\n";
- //    }
- //    Instruction* tempInst = dyn_cast<Instruction>(*op);
- //    if(tempInst) {
- //      cout<<"            "<<"This op is Instruction type."<<endl;
- //    }
- //    else {
- //      cout<<"            "<<"This op is not Instruction type."<<endl;
- //    }
- //  }
-   //
-
-   // type 1
-   if(t_inst == &(t_bb->front())) {
-     errs()<<"│   │   ├── Type: first inst of a BB."<<"\n";
-     errs()<<"│   │   ├── ctrl flow point to: "<<*t_inst<<"; In BB: "<<t_bb->getName().str()<<"\n";
-     return true;
-   }
-
-   // type 2 & 3
-   bool isLonelyInst = true;
-   bool isUsingIntraIterationData = false;
-   for (Instruction::op_iterator op = t_inst->op_begin(), opEnd = t_inst->op_end(); op != opEnd; ++op) {
-     if(isa<Instruction>(*op)) {
-       Instruction* tempInst = dyn_cast<Instruction>(*op);
-       isLonelyInst = false;
-       if(containsInst(t_bb, tempInst) and (getNode(tempInst)->getID() < getNode(t_inst)->getID())) {
-         isUsingIntraIterationData = true;
-       }
-     }
-   }
-   if(isLonelyInst) {
-     errs()<<"│   │   ├── Type: lonely inst."<<"\n";
-     errs()<<"│   │   ├── ctrl flow point to: "<<*t_inst<<"; In BB: "<<t_bb->getName().str()<<"\n";
-     return true;
-   }
-   else if(!isUsingIntraIterationData) {
-     errs()<<"│   │   ├── Type: inst without [intra-basicblock & intra-iteration data flow] nor [ctrl flow] pointed to it."<<"\n";
-     errs()<<"│   │   ├── ctrl flow point to: "<<*t_inst<<"; In BB: "<<t_bb->getName().str()<<"\n";
-     return true;
-   }
-
-   return false;
- }
-
-bool DFG::containsInst(BasicBlock* t_bb, Instruction* t_inst) {
-
-  for (BasicBlock::iterator II=t_bb->begin(),
-       IEnd=t_bb->end(); II!=IEnd; ++II) {
-    Instruction* inst = &*II;
-    if ((inst) == (t_inst)) {
-      return true;
-    }
-  }
-  return false;
-}
-
-int DFG::getInstID(BasicBlock* t_bb, Instruction* t_inst) {
-
-  int id = 0;
-  for (BasicBlock::iterator II=t_bb->begin(),
-       IEnd=t_bb->end(); II!=IEnd; ++II) {
-    Instruction* inst = &*II;
-    if ((inst) == (t_inst)) {
-      return id;
-    }
-    id += 1;
-  }
-  // This never gonna happen.
-  assert(false);
-  return -1;
-}
-
 void DFG::connectDFGNodes() {
   for (DFGNode* node: nodes)
     node->cutEdges();
@@ -1230,7 +1131,7 @@ void DFG::connectDFGNodes() {
   // Incorporate ctrl flow into data flow.
   if (!m_CDFGFused) {
     for (DFGEdge* edge: m_ctrlEdges) {
-      m_DFGEdges.push_back(edge);
+      addDFGEdge(edge);
     }
     m_CDFGFused = true;
   }
@@ -1253,61 +1154,249 @@ void DFG::connectDFGNodes() {
 }
 
 void DFG::generateJSON() {
-  ofstream jsonFile;
-  jsonFile.open("dfg.json");
-  jsonFile<<"[\n";
-  int node_index = 0;
-  int node_size = nodes.size();
+  ScopedTimer timer("output.dfg");
+  ordered_json nodesJson = ordered_json::array();
   for (DFGNode* node: nodes) {
-    jsonFile<<"  {\n";
-    jsonFile<<"    \"fu\"         : \""<<node->getFuType()<<"\",\n";
-    jsonFile<<"    \"id\"         : "<<node->getID()<<",\n";
-    jsonFile<<"    \"org_opt\"    : \""<<node->getOpcodeName()<<"\",\n";
-    jsonFile<<"    \"JSON_opt\"   : \""<<node->getJSONOpt()<<"\",\n";
-    jsonFile<<"    \"in_const\"   : [";
-    int const_size = node->getNumConst();
-    for (int const_index=0; const_index < const_size; ++const_index) {
-      jsonFile<<const_index;
-      if (const_index < const_size - 1)
-        jsonFile<<",";
-    }
-    jsonFile<<"],\n";
-    jsonFile<<"    \"pre\"         : [";
-    int in_size = node->getPredNodes()->size();
-    int in_index = 0;
+    ordered_json nodeJson;
+    nodeJson["fu"] = node->getFuType();
+    nodeJson["id"] = node->getID();
+    nodeJson["org_opt"] = node->getOpcodeName();
+    nodeJson["JSON_opt"] = node->getJSONOpt();
+    // The properties the mapping needs to read the DFG back, see
+    // readJSON(). The opcode is only written if it is not shown as is.
+    if (node->getRawOpcodeName() != node->getOpcodeName())
+      nodeJson["opcode"] = node->getRawOpcodeName();
+    nodeJson["vectorized"] = node->isVectorized();
+    nodeJson["complex"] = node->getComplexType();
+    nodeJson["latency"] = node->getExecLatency(1);
+    nodeJson["pipelinable"] = node->isPipelinable();
+    if (node->isPredicater()) {
+      vector<int> predicateeIDs;
+      for (DFGNode* predicatee: *(node->getPredicatees())) {
+        predicateeIDs.push_back(predicatee->getID());
+      }
+      nodeJson["predicatees"] = predicateeIDs;
+    }
+    if (node->isPatternRoot()) {
+      vector<int> partnerIDs;
+      for (DFGNode* patternNode: *(node->getPatternNodes())) {
+        partnerIDs.push_back(patternNode->getID());
+      }
+      nodeJson["pattern"] = partnerIDs;
+    }
+    vector<int> constIndexes;
+    for (int const_index=0; const_index < node->getNumConst(); ++const_index) {
+      constIndexes.push_back(const_index);
+    }
+    nodeJson["in_const"] = constIndexes;
+    vector<int> predIDs;
+    vector<int> ctrlPredIDs;
     for (DFGNode* predNode: *(node->getPredNodes())) {
-      jsonFile<<predNode->getID();
-      in_index += 1;
-      if (in_index < in_size)
-        jsonFile<<",";
-    }
-    jsonFile<<"],\n";
-    jsonFile<<"    \"succ\"       : [[";
-    int out_size = node->getSuccNodes()->size();
-    int out_index = 0;
+      predIDs.push_back(predNode->getID());
+      if (hasCtrlEdge(predNode, node))
+        ctrlPredIDs.push_back(predNode->getID());
+    }
+    nodeJson["pre"] = predIDs;
+    nodeJson["ctrl_pre"] = ctrlPredIDs;
+    vector<int> succIDs;
     for (DFGNode* succNode: *(node->getSuccNodes())) {
-      jsonFile<<succNode->getID();
-      out_index += 1;
-      if (out_index < out_size)
-        jsonFile<<",";
-    }
-    jsonFile<<"]]\n";
-    node_index += 1;
-    if (node_index < node_size)
-      jsonFile<<"  },\n";
-    else
-      jsonFile<<"  }\n";
-  }
-  jsonFile<<"]\n";
+      succIDs.push_back(succNode->getID());
+    }
+    nodeJson["succ"] = vector<vector<int>>(1, succIDs);
+    nodesJson.push_back(nodeJson);
+  }
+  ofstream jsonFile;
+  jsonFile.open("dfg.json");
+  jsonFile<<nodesJson.dump(2)<<"\n";
   jsonFile.close();
 }
 
-void DFG::generateDot(Function &t_F, bool t_isTrimmedDemo) {
+// Finds the node that the t_index-th reference of t_owner to the ID
+// stands for. Distinct nodes can share an ID (e.g., the ones split by
+// splitNodes()), the one listing the owner in turn (as a successor for a
+// predecessor, and vice versa) is taken then.
+static DFGNode* resolveNode(int t_id, DFGNode* t_owner, bool t_isPred,
+    map<int, list<pair<DFGNode*, json*>>>* t_nodesByID,
+    map<int, DFGNode*>* t_partners, int t_index) {
+  auto it = t_nodesByID->find(t_id);
+  if (it == t_nodesByID->end()) {
+    auto partner = t_partners->find(t_id);
+    return partner == t_partners->end() ? NULL : partner->second;
+  }
+  if (it->second.size() == 1)
+    return it->second.front().first;
+  vector<DFGNode*> candidates;
+  for (auto& node: it->second) {
+    json& refs = t_isPred ? (*node.second)["succ"][0] : (*node.second)["pre"];
+    for (int refID: refs) {
+      if (refID == t_owner->getID()) {
+        candidates.push_back(node.first);
+        break;
+      }
+    }
+  }
+  if (candidates.empty())
+    return it->second.front().first;
+  return candidates[t_index % candidates.size()];
+}
+
+// The nodes are read in the order of the file, i.e., the one they are
+// mapped in, and are connected as listed in "pre" and "succ". The
+// partners of the fused nodes are only kept for their edges, as when the
+// DFG is constructed. The cycles are recalculated.
+bool DFG::readJSON(string t_fileName) {
+  ifstream jsonFile(t_fileName);
+  if (!jsonFile.good())
+    return false;
+  json dfgJson;
+  try {
+    jsonFile>>dfgJson;
+  } catch (json::exception& e) {
+    cerr<<"Error: cannot parse "<<t_fileName<<": "<<e.what()<<"\n";
+    return false;
+  }
+
+  m_DFGEdges.clear();
+  nodes.clear();
+  m_ctrlEdges.clear();
+  m_nodeIndex.clear();
+  m_DFGEdgeIndex.clear();
+  m_ctrlEdgeIndex.clear();
+
+  map<int, list<pair<DFGNode*, json*>>> nodesByID;
+  for (json& nodeJson: dfgJson) {
+    string displayName = nodeJson["org_opt"];
+    string opcodeName = nodeJson.value("opcode", displayName);
+    string calleeName = opcodeName == "call" ? displayName : "";
+    DFGNode* node = new DFGNode(nodeJson["id"].get<int>(), m_precisionAware,
+                                opcodeName, nodeJson.value("vectorized", false),
+                                calleeName, "val" + to_string(m_num++),
+                                m_supportDVFS);
+    for (int i=0; i<(int)nodeJson["in_const"].size(); ++i) {
+      node->addConst();
+    }
+    string complexType = nodeJson.value("complex", "None");
+    if (complexType != "None") {
+      node->setCombine(complexType);
+    }
+    string optType = nodeJson["JSON_opt"];
+    if (optType.size() > 6 and
+        optType.compare(optType.size() - 6, 6, "_CONST") == 0) {
+      optType.erase(optType.size() - 6);
+    }
+    node->setTypes(optType, nodeJson["fu"].get<string>());
+    node->setExecLatency(nodeJson.value("latency", 1));
+    if (nodeJson.value("pipelinable", false)) {
+      node->setPipelinable();
+    }
+    nodesByID[node->getID()].push_back(make_pair(node, &nodeJson));
+    appendNode(node);
+  }
+
+  map<int, DFGNode*> partners;
+  for (auto& node: nodesByID) {
+    for (auto& sameID: node.second) {
+      DFGNode* root = sameID.first;
+      for (int partnerID: sameID.second->value("pattern", vector<int>())) {
+        if (nodesByID.count(partnerID) or partners.count(partnerID))
+          continue;
+        DFGNode* partner = new DFGNode(partnerID, m_precisionAware,
+                                       root->getRawOpcodeName(),
+                                       root->isVectorized(), "",
+                                       "val" + to_string(m_num++),
+                                       m_supportDVFS);
+        partner->setCombine(root->getComplexType());
+        root->linkPatternPartner(partner);
+        partners[partnerID] = partner;
+      }
+    }
+  }
+
+  // Adds the edges in the order of the predecessors, and hooks them up to
+  // the successors in the order of the successors.
+  int dfgEdgeID = 0;
+  int ctrlEdgeID = 0;
+  int nodeIndex = 0;
+  for (DFGNode* node: nodes) {
+    json& nodeJson = dfgJson[nodeIndex++];
+    set<int> ctrlPreds;
+    for (int predID: nodeJson.value("ctrl_pre", vector<int>())) {
+      ctrlPreds.insert(predID);
+    }
+    map<int, int> visits;
+    for (int predID: nodeJson["pre"]) {
+      DFGNode* predNode = resolveNode(predID, node, true, &nodesByID,
+                                      &partners, visits[predID]++);
+      if (predNode == NULL)
+        continue;
+      DFGEdge* edge;
+      if (ctrlPreds.count(predID)) {
+        edge = new DFGEdge(ctrlEdgeID++, predNode, node, true);
+        addCtrlEdge(edge);
+      } else {
+        edge = new DFGEdge(dfgEdgeID++, predNode, node);
+      }
+      addDFGEdge(edge);
+      node->setInEdge(edge);
+      if (partners.count(predID))
+        predNode->setOutEdge(edge);
+    }
+  }
+  m_CDFGFused = true;
+  nodeIndex = 0;
+  for (DFGNode* node: nodes) {
+    json& nodeJson = dfgJson[nodeIndex++];
+    map<int, int> visits;
+    map<DFGNode*, int> edgeVisits;
+    for (int succID: nodeJson["succ"][0]) {
+      DFGNode* succNode = resolveNode(succID, node, false, &nodesByID,
+                                      &partners, visits[succID]++);
+      if (succNode == NULL)
+        continue;
+      if (partners.count(succID)) {
+        DFGEdge* edge = new DFGEdge(dfgEdgeID++, node, succNode);
+        addDFGEdge(edge);
+        succNode->setInEdge(edge);
+      }
+      auto it = m_DFGEdgeIndex.find(make_pair(node, succNode));
+      if (it == m_DFGEdgeIndex.end() or (int)it->second.size() <= edgeVisits[succNode])
+        continue;
+      node->setOutEdge(*next(it->second.begin(), edgeVisits[succNode]++));
+    }
+  }
+
+  // The predicatees are not only the destinations of the ctrl edges, e.g.,
+  // they are kept by the edges of the fused and split nodes.
+  nodeIndex = 0;
+  for (DFGNode* node: nodes) {
+    json& nodeJson = dfgJson[nodeIndex++];
+    if (nodeJson.find("predicatees") == nodeJson.end())
+      continue;
+    list<DFGNode*>* predicatees = new list<DFGNode*>();
+    map<int, int> visits;
+    for (int predicateeID: nodeJson["predicatees"]) {
+      DFGNode* predicatee = resolveNode(predicateeID, node, false, &nodesByID,
+                                        &partners, visits[predicateeID]++);
+      if (predicatee != NULL)
+        predicatees->push_back(predicatee);
+    }
+    node->setPredicatees(predicatees);
+  }
+  calculateCycles();
+
+  for (DFGNode* node: nodes) {
+    node->getPredNodes();
+    node->getSuccNodes();
+  }
+  return true;
+}
+
+void DFG::generateDot(string t_functionName, bool t_isTrimmedDemo) {
+  ScopedTimer timer("output.dot");
 
   error_code error;
 //  sys::fs::OpenFlags F_Excl;
-  string func_name = t_F.getName().str();
-  string file_name = func_name + ".dot";
+  string file_name = t_functionName + ".dot";
   std::ofstream file;
   file.open(file_name);
   // StringRef fileName(file_name);
@@ -1315,7 +1404,7 @@ void DFG::generateDot(Function &t_F, bool t_isTrimmedDemo) {
 
   // TODO: support t_isTrimmedDemo = false, i.e., fix bugs of raw_fd_ostream
   assert(t_isTrimmedDemo == true);
-  file << "digraph \"DFG for'" + string(t_F.getName().data()) + "\' function\" {\n";
+  file << "digraph \"DFG for'" + t_functionName + "\' function\" {\n";
 
   //Dump DFG nodes.
   for (DFGNode* node: nodes) {
@@ -1383,64 +1472,170 @@ void DFG::generateDot(Function &t_F, bool t_isTrimmedDemo) {
 
 }
 
-void DFG::DFS_on_DFG(DFGNode* t_head, DFGNode* t_current,
-    list<DFGNode*>* t_visitedNodes, list<DFGEdge*>* t_erasedEdges,
-    list<DFGEdge*>* t_currentCycle, list<list<DFGEdge*>*>* t_cycles) {
-  for (DFGEdge* edge: m_DFGEdges) {
-    if (find(t_erasedEdges->begin(), t_erasedEdges->end(), edge) != t_erasedEdges->end())
+// Tarjan's strongly connected components over the adjacency arrays,
+// unrolled onto an explicit stack so that deep DFGs cannot overflow the
+// call stack. Each node gets the ID of its component in t_component.
+void DFG::getSCCs(vector<vector<pair<int, int>>>* t_succs,
+    vector<int>* t_component) {
+  int nodeCount = t_succs->size();
+  vector<int> index(nodeCount, -1);
+  vector<int> lowLink(nodeCount, 0);
+  vector<bool> onStack(nodeCount, false);
+  vector<int> sccStack;
+  // Each frame is a node together with the next successor to visit.
+  vector<pair<int, int>> frames;
+  int nextIndex = 0;
+  int componentCount = 0;
+  t_component->assign(nodeCount, -1);
+  for (int root=0; root<nodeCount; ++root) {
+    if (index[root] != -1) {
       continue;
-    // check whether the IR is equal
-    if (edge->getSrc() == t_current) {
-      // skip the visited nodes/edges:
-      if (find(t_currentCycle->begin(), t_currentCycle->end(), edge) != t_currentCycle->end()) {
+    }
+    frames.push_back(make_pair(root, 0));
+    while (!frames.empty()) {
+      int v = frames.back().first;
+      if (frames.back().second == 0 and index[v] == -1) {
+        index[v] = lowLink[v] = nextIndex++;
+        sccStack.push_back(v);
+        onStack[v] = true;
+      }
+      if (frames.back().second < (int)(*t_succs)[v].size()) {
+        int w = (*t_succs)[v][frames.back().second++].first;
+        if (index[w] == -1) {
+          frames.push_back(make_pair(w, 0));
+        } else if (onStack[w]) {
+          lowLink[v] = min(lowLink[v], index[w]);
+        }
+        continue;
+      }
+      frames.pop_back();
+      if (!frames.empty()) {
+        int parent = frames.back().first;
+        lowLink[parent] = min(lowLink[parent], lowLink[v]);
+      }
+      if (lowLink[v] == index[v]) {
+        int w;
+        do {
+          w = sccStack.back();
+          sccStack.pop_back();
+          onStack[w] = false;
+          (*t_component)[w] = componentCount;
+        } while (w != v);
+        ++componentCount;
+      }
+    }
+  }
+}
+
+// Searches the cycles through t_head inside t_head's component. A node
+// stays blocked once it has been expanded from t_head, and an edge that
+// closes a cycle is erased for the later heads, so that the rotations of
+// a cycle are not reported over and over. Unrolled onto an explicit stack
+// like getSCCs().
+void DFG::searchCyclesFrom(int t_head,
+    vector<vector<pair<int, int>>>* t_succs, vector<int>* t_component,
+    vector<DFGEdge*>* t_edges, vector<bool>* t_erasedEdges,
+    vector<int>* t_visitedStamp, list<list<DFGEdge*>*>* t_cycles) {
+  int component = (*t_component)[t_head];
+  vector<int> path;
+  // Each frame is a node together with the next successor to visit.
+  vector<pair<int, int>> frames;
+  frames.push_back(make_pair(t_head, 0));
+  (*t_visitedStamp)[t_head] = t_head;
+  while (!frames.empty()) {
+    int v = frames.back().first;
+    if (frames.back().second < (int)(*t_succs)[v].size()) {
+      pair<int, int> succ = (*t_succs)[v][frames.back().second++];
+      int w = succ.first;
+      int edgeID = succ.second;
+      if ((*t_erasedEdges)[edgeID] or (*t_component)[w] != component) {
         continue;
       }
-      t_currentCycle->push_back(edge);
-
-//      cout << ".. add current cycle edge: {" << *edge->getSrc()->getInst() << "  } -> {"<< *edge->getDst()->getInst() << "  } ("<<edge->getSrc()->getID()<<" -> "<<edge->getDst()->getID()<<")\n";
-      if (edge->getDst() == t_head) {
-        cout << "==================================\n";
-        errs() << "[detected one cycle] head: "<<*(t_head->getInst())<<"\n";
-        list<DFGEdge*>* temp_cycle = new list<DFGEdge*>();
-        for (DFGEdge* currentEdge: *t_currentCycle) {
-          temp_cycle->push_back(currentEdge);
-          // break the cycle to avoid future repeated detection
-          errs() << "cycle edge: {" << *((currentEdge)->getSrc()->getInst()) << "  } -> {"<< *((currentEdge)->getDst()->getInst()) << "  } ("<<currentEdge->getSrc()->getID()<<" -> "<<currentEdge->getDst()->getID()<<")\n";
+      if (w == t_head) {
+        list<DFGEdge*>* cycle = new list<DFGEdge*>();
+        for (int pathEdgeID: path) {
+          cycle->push_back((*t_edges)[pathEdgeID]);
         }
-        t_erasedEdges->push_back(edge);
-        t_cycles->push_back(temp_cycle);
-        t_currentCycle->remove(edge);
-      } else {
-        if (find(t_visitedNodes->begin(), t_visitedNodes->end(), edge->getDst()) == t_visitedNodes->end()) {
-          t_visitedNodes->push_back(edge->getDst());
-          // Only continue when the path size is less than the node count.
-          if (t_currentCycle->size() <= nodes.size()) {
-            DFS_on_DFG(t_head, edge->getDst(), t_visitedNodes, t_erasedEdges, t_currentCycle, t_cycles);
-          }
-        } else {
-          t_currentCycle->remove(edge);
+        cycle->push_back((*t_edges)[edgeID]);
+        CGRA_LOG(LOG_DFG, LOG_DEBUG) << "==================================\n";
+        if (CGRA_LOG_ENABLED(LOG_DFG, LOG_DEBUG)) cerr << "[detected one cycle] head: "<<(*t_edges)[edgeID]->getDst()->getInstText()<<"\n";
+        for (DFGEdge* currentEdge: *cycle) {
+          if (CGRA_LOG_ENABLED(LOG_DFG, LOG_DEBUG)) cerr << "cycle edge: {" << currentEdge->getSrc()->getInstText() << "  } -> {"<< currentEdge->getDst()->getInstText() << "  } ("<<currentEdge->getSrc()->getID()<<" -> "<<currentEdge->getDst()->getID()<<")\n";
+        }
+        // break the cycle to avoid future repeated detection
+        (*t_erasedEdges)[edgeID] = true;
+        t_cycles->push_back(cycle);
+        if (m_maxCycleCount > 0 and (int)t_cycles->size() >= m_maxCycleCount) {
+          return;
         }
+      } else if ((*t_visitedStamp)[w] != t_head) {
+        (*t_visitedStamp)[w] = t_head;
+        path.push_back(edgeID);
+        frames.push_back(make_pair(w, 0));
       }
+      continue;
+    }
+    frames.pop_back();
+    if (!path.empty()) {
+      path.pop_back();
     }
-  }
-  if (t_currentCycle->size()!=0) {
-    t_currentCycle->pop_back();
   }
 }
 
+// Detects the cycles of the DFG. The nodes are split into strongly
+// connected components first so that the search from each head never
+// leaves the head's component, and the heads that are not on any cycle
+// are skipped altogether. At most m_maxCycleCount cycles are detected if
+// the bound is set.
 list<list<DFGEdge*>*>* DFG::calculateCycles() {
+  ScopedTimer timer("dfg.cycles");
   list<list<DFGEdge*>*>* cycleLists = new list<list<DFGEdge*>*>();
-  list<DFGEdge*>* currentCycle = new list<DFGEdge*>();
-  list<DFGNode*>* visitedNodes = new list<DFGNode*>();
-  list<DFGEdge*>* erasedEdges = new list<DFGEdge*>();
-  cycleLists->clear();
-  for (DFGNode* node: nodes) {
-    currentCycle->clear();
-    visitedNodes->clear();
-    visitedNodes->push_back(node);
-    DFS_on_DFG(node, node, visitedNodes, erasedEdges, currentCycle, cycleLists);
+  vector<DFGNode*> indexedNodes(nodes.begin(), nodes.end());
+  unordered_map<DFGNode*, int> nodeIndex;
+  for (int i=0; i<(int)indexedNodes.size(); ++i) {
+    nodeIndex[indexedNodes[i]] = i;
+  }
+  // Successor arrays of (node, edge) in the edge order.
+  vector<DFGEdge*> edges;
+  vector<vector<pair<int, int>>> succs(indexedNodes.size());
+  for (DFGEdge* edge: m_DFGEdges) {
+    auto src = nodeIndex.find(edge->getSrc());
+    auto dst = nodeIndex.find(edge->getDst());
+    if (src == nodeIndex.end() or dst == nodeIndex.end()) {
+      continue;
+    }
+    succs[src->second].push_back(make_pair(dst->second, (int)edges.size()));
+    edges.push_back(edge);
+  }
+
+  vector<int> component;
+  getSCCs(&succs, &component);
+  vector<int> componentSize(indexedNodes.size(), 0);
+  for (int c: component) {
+    ++componentSize[c];
+  }
+  vector<bool> erasedEdges(edges.size(), false);
+  vector<int> visitedStamp(indexedNodes.size(), -1);
+  for (int i=0; i<(int)indexedNodes.size(); ++i) {
+    // A single node only forms a cycle with a self-loop.
+    bool selfLoop = false;
+    for (pair<int, int>& succ: succs[i]) {
+      selfLoop = selfLoop or succ.first == i;
+    }
+    if (componentSize[component[i]] > 1 or selfLoop) {
+      searchCyclesFrom(i, &succs, &component, &edges, &erasedEdges,
+                       &visitedStamp, cycleLists);
+    }
+    if (m_maxCycleCount > 0 and (int)cycleLists->size() >= m_maxCycleCount) {
+      CGRA_LOG(LOG_DFG, LOG_INFO) << "[cycle detection stopped at " << m_maxCycleCount << " cycles]\n";
+      break;
+    }
   }
+
   int cycleID = 0;
+  for (list<DFGNode*>* nodeCycle: *m_cycleNodeLists) {
+    delete nodeCycle;
+  }
   m_cycleNodeLists->clear();
   for (list<DFGEdge*>* cycle: *cycleLists) {
     list<DFGNode*>* nodeCycle = new list<DFGNode*>();
@@ -1459,6 +1654,10 @@ list<list<DFGNode*>*>* DFG::getCycleLists() {
   return m_cycleNodeLists;
 }
 
+list<DFGEdge*>* DFG::getDFGEdges() {
+  return &m_DFGEdges;
+}
+
 void DFG::showOpcodeDistribution() {
 
   map<string, int> opcodeMap;
@@ -1467,7 +1666,7 @@ void DFG::showOpcodeDistribution() {
   }
   for (map<string, int>::iterator opcodeItr=opcodeMap.begin();
       opcodeItr!=opcodeMap.end(); ++opcodeItr) {
-    cout << (*opcodeItr).first << " : " << (*opcodeItr).second << "\n";
+    CGRA_LOG(LOG_DFG, LOG_INFO) << (*opcodeItr).first << " : " << (*opcodeItr).second << "\n";
   }
   int simdNodeCount = 0;
   for (DFGNode* node: nodes) {
@@ -1475,7 +1674,7 @@ void DFG::showOpcodeDistribution() {
       simdNodeCount++;
     }
   }
-  cout << "DFG node count: "<<nodes.size()<<"; DFG edge count: "<<m_DFGEdges.size()<<"; SIMD node count: "<<simdNodeCount<<"\n";
+  CGRA_LOG(LOG_DFG, LOG_INFO) << "DFG node count: "<<nodes.size()<<"; DFG edge count: "<<m_DFGEdges.size()<<"; SIMD node count: "<<simdNodeCount<<"\n";
 }
 
 int DFG::getID(DFGNode* t_node) {
@@ -1483,53 +1682,72 @@ int DFG::getID(DFGNode* t_node) {
   return t_node->getID();
 }
 
-DFGNode* DFG::getNode(Value* t_value) {
-  for (DFGNode* node: nodes) {
-    if (node->getInst() == t_value) {
-      return node;
-    }
-  }
-  assert("ERROR cannot find the corresponding DFG node.");
-  return NULL;
+void DFG::appendNode(DFGNode* t_node) {
+  nodes.push_back(t_node);
+  // Keeps the first node of the instruction, as the lookup did by
+  // scanning the nodes.
+  if (t_node->getInst() != NULL)
+    m_nodeIndex.emplace(t_node->getInst(), t_node);
 }
 
-bool DFG::hasNode(Value* t_value) {
+void DFG::removeNode(DFGNode* t_node) {
+  nodes.remove(t_node);
+  if (t_node->getInst() == NULL)
+    return;
+  unordered_map<llvm::Instruction*, DFGNode*>::iterator it = m_nodeIndex.find(t_node->getInst());
+  if (it == m_nodeIndex.end() or it->second != t_node)
+    return;
+  m_nodeIndex.erase(it);
+  // Another node (e.g., split from the removed one) can stand for the
+  // same instruction.
   for (DFGNode* node: nodes) {
-    if (node->getInst() == t_value) {
-      return true;
+    if (node->getInst() == t_node->getInst()) {
+      m_nodeIndex[node->getInst()] = node;
+      break;
     }
   }
-  return false;
+}
+
+void DFG::addDFGEdge(DFGEdge* t_edge) {
+  m_DFGEdges.push_back(t_edge);
+  m_DFGEdgeIndex[make_pair(t_edge->getSrc(), t_edge->getDst())].push_back(t_edge);
+}
+
+void DFG::removeDFGEdge(DFGEdge* t_edge) {
+  if (t_edge == NULL)
+    return;
+  m_DFGEdges.remove(t_edge);
+  pair<DFGNode*, DFGNode*> key = make_pair(t_edge->getSrc(), t_edge->getDst());
+  auto it = m_DFGEdgeIndex.find(key);
+  if (it == m_DFGEdgeIndex.end())
+    return;
+  it->second.remove(t_edge);
+  if (it->second.empty())
+    m_DFGEdgeIndex.erase(it);
+}
+
+void DFG::addCtrlEdge(DFGEdge* t_edge) {
+  m_ctrlEdges.push_back(t_edge);
+  m_ctrlEdgeIndex[make_pair(t_edge->getSrc(), t_edge->getDst())].push_back(t_edge);
 }
 
 DFGEdge* DFG::getCtrlEdge(DFGNode* t_src, DFGNode* t_dst) {
-  for (DFGEdge* edge: m_ctrlEdges) {
-    if (edge->getSrc() == t_src and
-        edge->getDst() == t_dst) {
-      return edge;
-    }
+  auto it = m_ctrlEdgeIndex.find(make_pair(t_src, t_dst));
+  if (it != m_ctrlEdgeIndex.end()) {
+    return it->second.front();
   }
   assert("ERROR cannot find the corresponding Ctrl edge.");
   return NULL;
 }
 
 bool DFG::hasCtrlEdge(DFGNode* t_src, DFGNode* t_dst) {
-  for (DFGEdge* edge: m_ctrlEdges) {
-    if (edge->getSrc() == t_src and
-        edge->getDst() == t_dst) {
-      return true;
-    }
-  }
-  return false;
+  return m_ctrlEdgeIndex.find(make_pair(t_src, t_dst)) != m_ctrlEdgeIndex.end();
 }
 
 DFGEdge* DFG::getDFGEdge(DFGNode* t_src, DFGNode* t_dst) {
-  for (DFGEdge* edge: m_DFGEdges) {
-    if (edge->getSrc() == t_src and
-        edge->getDst() == t_dst) {
-      return edge;
-    }
-
+  auto it = m_DFGEdgeIndex.find(make_pair(t_src, t_dst));
+  if (it != m_DFGEdgeIndex.end()) {
+    return it->second.front();
   }
   assert("ERROR cannot find the corresponding DFG edge.");
   return NULL;
@@ -1537,48 +1755,34 @@ DFGEdge* DFG::getDFGEdge(DFGNode* t_src, DFGNode* t_dst) {
 
 void DFG::replaceDFGEdge(DFGNode* t_old_src, DFGNode* t_old_dst,
                          DFGNode* t_new_src, DFGNode* t_new_dst) {
-  DFGEdge* target = NULL;
-  cout<<"replace edge: [delete] "<<t_old_src->getID()<<"->"<<t_old_dst->getID()<<" [new] "<<t_new_src->getID()<<"->"<<t_new_dst->getID()<<"\n";
-  for (DFGEdge* edge: m_DFGEdges) {
-    if (edge->getSrc() == t_old_src and
-        edge->getDst() == t_old_dst) {
-      target = edge;
-      break;
-    }
-  }
+  CGRA_LOG(LOG_DFG, LOG_DEBUG)<<"replace edge: [delete] "<<t_old_src->getID()<<"->"<<t_old_dst->getID()<<" [new] "<<t_new_src->getID()<<"->"<<t_new_dst->getID()<<"\n";
+  DFGEdge* target = getDFGEdge(t_old_src, t_old_dst);
   if (target == NULL) {
     assert("ERROR cannot find the corresponding DFG edge.");
     cout << "ERROR cannot find the corresponding DFG edge\n";
     return;
   }
-  m_DFGEdges.remove(target);
+  removeDFGEdge(target);
   // Keeps the ctrl property of the original edge on the newly added edge.
   DFGEdge* newEdge = new DFGEdge(target->getID(), t_new_src, t_new_dst, target->isCtrlEdge());
-  m_DFGEdges.push_back(newEdge);
+  addDFGEdge(newEdge);
   if (newEdge->isCtrlEdge()){
-    m_ctrlEdges.push_back(newEdge);
+    addCtrlEdge(newEdge);
   }
 }
 
 // used for the case of tuning division patterns
 void DFG::replaceMultipleDFGEdge(DFGNode* t_old_src, DFGNode* t_old_dst,
                          DFGNode** t_new_src, DFGNode** t_new_dst) {
-  cout << "replace multiple dfg edges" << "\n";
-  DFGEdge* target = NULL;
-  cout<<"replace edge: [delete] "<<t_old_src->getID()<<"->"<<t_old_dst->getID()<<"\n";
-  for (DFGEdge* edge: m_DFGEdges) {
-    if (edge->getSrc() == t_old_src and
-        edge->getDst() == t_old_dst) {
-      target = edge;
-      break;
-    }
-  }
+  CGRA_LOG(LOG_DFG, LOG_DEBUG) << "replace multiple dfg edges\n";
+  CGRA_LOG(LOG_DFG, LOG_DEBUG)<<"replace edge: [delete] "<<t_old_src->getID()<<"->"<<t_old_dst->getID()<<"\n";
+  DFGEdge* target = getDFGEdge(t_old_src, t_old_dst);
   if (target == NULL) {
     cout << "ERROR cannot find the corresponding DFG edge\n";
     return;
   }
   int dfgEdgeID = m_DFGEdges.size();
-  m_DFGEdges.remove(target);
+  removeDFGEdge(target);
   // Keeps the ctrl property of the original edge on the newly added edge.
   for (int i = 0; i < m_vectorFactorForIdiv; i++) {
     DFGEdge* newEdge;
@@ -1588,48 +1792,20 @@ void DFG::replaceMultipleDFGEdge(DFGNode* t_old_src, DFGNode* t_old_dst,
     else {
       newEdge = new DFGEdge(dfgEdgeID++, t_new_src[i], t_new_dst[i], target->isCtrlEdge());
     }
-    m_DFGEdges.push_back(newEdge);
+    addDFGEdge(newEdge);
     if (newEdge->isCtrlEdge()){
-      m_ctrlEdges.push_back(newEdge);
+      addCtrlEdge(newEdge);
     }
   }
 }
 
 void DFG::deleteDFGEdge(DFGNode* t_src, DFGNode* t_dst) {
   if (!hasDFGEdge(t_src, t_dst)) return;
-  m_DFGEdges.remove(getDFGEdge(t_src, t_dst));
+  removeDFGEdge(getDFGEdge(t_src, t_dst));
 }
 
 bool DFG::hasDFGEdge(DFGNode* t_src, DFGNode* t_dst) {
-  for (DFGEdge* edge: m_DFGEdges) {
-    if (edge->getSrc() == t_src and
-        edge->getDst() == t_dst) {
-      return true;
-    }
-  }
-  return false;
-}
-
-string DFG::changeIns2Str(Instruction* t_ins) {
-  string temp_str;
-  raw_string_ostream os(temp_str);
-  t_ins->print(os);
-  return os.str();
-}
-
-//get value's name or inst's content
-StringRef DFG::getValueName(Value* t_value) {
-  string temp_result = "val";
-  if (t_value->getName().empty()) {
-    temp_result += to_string(m_num);
-    m_num++;
-  }
-  else {
-    temp_result = t_value->getName().str();
-  }
-  StringRef result(temp_result);
-//  cout << "" << result;
-  return result;
+  return m_DFGEdgeIndex.find(make_pair(t_src, t_dst)) != m_DFGEdgeIndex.end();
 }
 
 int DFG::getNodeCount() {
@@ -1660,13 +1836,13 @@ void DFG::tuneForBitcast() {
   }
 
   for (DFGNode* dfgNode: unnecessaryDFGNodes)
-    nodes.remove(dfgNode);
+    removeNode(dfgNode);
 
   for (DFGEdge* dfgEdge: replaceDFGEdges)
-    m_DFGEdges.remove(dfgEdge);
+    removeDFGEdge(dfgEdge);
 
   for (DFGEdge* dfgEdge: newDFGEdges)
-    m_DFGEdges.push_back(dfgEdge);
+    addDFGEdge(dfgEdge);
 
   connectDFGNodes();
 }
@@ -1698,84 +1874,15 @@ void DFG::tuneForLoad() {
   }
 
   for (DFGNode* dfgNode: unnecessaryDFGNodes)
-    nodes.remove(dfgNode);
+    removeNode(dfgNode);
 
   for (DFGEdge* dfgEdge: removeDFGEdges)
-    m_DFGEdges.remove(dfgEdge);
+    removeDFGEdge(dfgEdge);
 
   for (DFGEdge* dfgEdge: newDFGEdges)
-    m_DFGEdges.push_back(dfgEdge);
-
-  connectDFGNodes();
-}
-
-// This is necessary to handle the control flow.
-// Each one would have their own implementation about control
-// flow handling. We simply connect 'br' to the entry ('phi')
-// of the corresponding basic blocks (w/o including additional
-// DFG nodes).
-void DFG::tuneForBranch() {
-  list<DFGNode*> processedDFGBrNodes;
-  list<DFGEdge*> replaceDFGEdges;
-  list<DFGEdge*> newBrDFGEdges;
-  int newDFGEdgeID = m_DFGEdges.size();
-  for (DFGEdge* dfgEdge: m_ctrlEdges) {
-    DFGNode* left = dfgEdge->getSrc();
-    DFGNode* right = dfgEdge->getDst();
-    assert(left->isBranch());
-    assert(right->isPhi());
-    if (find(processedDFGBrNodes.begin(), processedDFGBrNodes.end(), left) ==
-        processedDFGBrNodes.end()) {
-      processedDFGBrNodes.push_back(left);
-    } else {
-      DFGNode* newDFGBrNode = new DFGNode(nodes.size(), m_precisionAware, left->getInst(),
-          getValueName(left->getInst()), m_supportDVFS);
-      for (DFGNode* predDFGNode: *(left->getPredNodes())) {
-        DFGEdge* newDFGBrEdge = new DFGEdge(newDFGEdgeID++,
-            predDFGNode, newDFGBrNode);
-        m_DFGEdges.push_back(newDFGBrEdge);
-      }
-      nodes.push_back(newDFGBrNode);
-      left = newDFGBrNode;
-    }
-    list<DFGNode*>* predNodes = right->getPredNodes();
-    for (DFGNode* predNode: *predNodes) {
-      DFGEdge* replaceDFGEdge = getDFGEdge(predNode, right);
-      DFGEdge* brDataDFGEdge = new DFGEdge(replaceDFGEdge->getID(), predNode, left);
-      DFGEdge* brCtrlDFGEdge = new DFGEdge(newDFGEdgeID++, left, right);
-      // FIXME: Only consider one predecessor for 'phi' node for now.
-      //        Need to care about true/false and make proper connection.
-      replaceDFGEdges.push_back(replaceDFGEdge);
-      newBrDFGEdges.push_back(brDataDFGEdge);
-      newBrDFGEdges.push_back(brCtrlDFGEdge);
-      break;
-    }
-  }
-  for (DFGEdge* dfgEdge: replaceDFGEdges) {
-    m_DFGEdges.remove(dfgEdge);
-  }
-  for (DFGEdge* dfgEdge: newBrDFGEdges) {
-    m_DFGEdges.push_back(dfgEdge);
-  }
+    addDFGEdge(dfgEdge);
 
   connectDFGNodes();
-//    DFGEdge* brCtrlDFGEdge = new DFGEdge(m_DFGEdges.size(), left, right);
-//    DFGEdge* replaceDFGEdge;
-//    for (list<DFGNode*>::iterator predNodeItr=predNodes->begin();
-//        predNodeItr!=predNodes->end(); ++predNodeItr) {
-//      DFGNode* predNode = *predNodeItr;
-//      list<DFGNode*>* visitedNodes = new list<DFGNode*>();
-//      // Found one predNode is one the same control/data path as the 'br'.
-//      if (searchDFS(left, predNode, visitedNodes)) {
-//        replaceDFGEdge = getDFGEdge(predNode, right);
-//        DFGEdge* brDataDFGEdge = new DFGEdge(replaceDFGEdge->getID(), predNode, left);
-//        m_DFGEdges.remove(replaceDFGEdge);
-//        m_DFGEdges.push_back(brDataDFGEdge);
-//        break;
-//      }
-//    }
-//    m_DFGEdges.push_back(brCtrlDFGEdge);
-//  }
 }
 
 void DFG::trimForStandalone() {
@@ -1786,7 +1893,7 @@ void DFG::trimForStandalone() {
       removeNodes.push_back(dfgNode);
 
   for (DFGNode* dfgNode: removeNodes)
-    nodes.remove(dfgNode);
+    removeNode(dfgNode);
 }
 
 bool DFG::searchDFS(DFGNode* t_target, DFGNode* t_head,
@@ -8,26 +8,34 @@
  *   Date : July 16, 2019
  */
 
-#include <llvm/IR/Function.h>
-#include <llvm/IR/BasicBlock.h>
-#include <llvm/IR/Value.h>
-#include <llvm/IR/Instruction.h>
-#include <llvm/IR/Instructions.h>
-#include <llvm/Support/raw_ostream.h>
-#include <llvm/Support/FileSystem.h>
-#include <llvm/IR/Use.h>
-#include <llvm/Analysis/CFG.h>
-#include <llvm/Analysis/LoopInfo.h>
 #include <list>
+#include <vector>
 #include <set>
 #include <map>
+#include <unordered_map>
 #include <iostream>
 #include <algorithm>
 
 #include "DFGNode.h"
 #include "DFGEdge.h"
 
-using namespace llvm;
+// The DFG is either constructed from the LLVM IR of a function (see
+// DFGLLVM.cpp, only built along with the pass) or read from a file.
+namespace llvm {
+  class Function;
+  class Loop;
+  class BasicBlock;
+}
+
+// See DFGFormat.h.
+struct DFGImage;
+
+// Hashes the (source, destination) pair of an edge for the edge indexes.
+struct DFGNodePairHash {
+  size_t operator()(const pair<DFGNode*, DFGNode*>& t_pair) const {
+    return hash<DFGNode*>()(t_pair.first) * 31 + hash<DFGNode*>()(t_pair.second);
+  }
+};
 using namespace std;
 
 class DFG {
@@ -37,24 +45,42 @@ class DFG {
     bool m_targetFunction;
     bool m_precisionAware;
     list<DFGNode*>* m_orderedNodes;
-    list<Loop*>* m_targetLoops;
-    list<BasicBlock*> m_targetBBs;
+    list<llvm::Loop*>* m_targetLoops;
+    list<llvm::BasicBlock*> m_targetBBs;
     int m_vectorFactorForIdiv;
 
     //edges of data flow
     list<DFGEdge*> m_DFGEdges;
     list<DFGEdge*> m_ctrlEdges;
 
+    // Indexes of the nodes (by instruction) and of the edges (by source
+    // and destination, in the order of the edge lists) to make the lookups
+    // O(1). The edge lists and the nodes are only updated via the helpers
+    // below, which keep the indexes consistent.
+    unordered_map<llvm::Instruction*, DFGNode*> m_nodeIndex;
+    unordered_map<pair<DFGNode*, DFGNode*>, list<DFGEdge*>, DFGNodePairHash> m_DFGEdgeIndex;
+    unordered_map<pair<DFGNode*, DFGNode*>, list<DFGEdge*>, DFGNodePairHash> m_ctrlEdgeIndex;
+    void appendNode(DFGNode*);
+    void removeNode(DFGNode*);
+    void addDFGEdge(DFGEdge*);
+    void removeDFGEdge(DFGEdge*);
+    void addCtrlEdge(DFGEdge*);
+
     bool m_supportDVFS;
     bool m_DVFSAwareMapping;
 
-    string changeIns2Str(Instruction* ins);
+    string changeIns2Str(llvm::Instruction* ins);
     //get value's name or inst's content
-    StringRef getValueName(Value* v);
-    void DFS_on_DFG(DFGNode*, DFGNode*, list<DFGNode*>*, list<DFGEdge*>*,
-        list<DFGEdge*>*, list<list<DFGEdge*>*>*);
-    DFGNode* getNode(Value*);
-    bool hasNode(Value*);
+    string getValueName(llvm::Instruction* v);
+    // Upper bound on the number of cycles calculateCycles() detects, 0
+    // means unbounded.
+    int m_maxCycleCount;
+    void getSCCs(vector<vector<pair<int, int>>>*, vector<int>*);
+    void searchCyclesFrom(int, vector<vector<pair<int, int>>>*, vector<int>*,
+        vector<DFGEdge*>*, vector<bool>*, vector<int>*,
+        list<list<DFGEdge*>*>*);
+    DFGNode* getNode(llvm::Instruction*);
+    bool hasNode(llvm::Instruction*);
     DFGEdge* getDFGEdge(DFGNode*, DFGNode*);
     void deleteDFGEdge(DFGNode*, DFGNode*);
     void replaceDFGEdge(DFGNode*, DFGNode*, DFGNode*, DFGNode*);
@@ -62,7 +88,7 @@ class DFG {
     bool hasDFGEdge(DFGNode*, DFGNode*);
     DFGEdge* getCtrlEdge(DFGNode*, DFGNode*);
     bool hasCtrlEdge(DFGNode*, DFGNode*);
-    bool shouldIgnore(Instruction*);
+    bool shouldIgnore(llvm::Instruction*);
     void tuneForBranch();
     void tuneForBitcast();
     void tuneForLoad();
@@ -83,29 +109,35 @@ class DFG {
     void eliminateOpcode(string);
     bool searchDFS(DFGNode*, DFGNode*, list<DFGNode*>*);
     void connectDFGNodes();
-    bool isLiveInInst(BasicBlock*, Instruction*);
-    bool containsInst(BasicBlock*, Instruction*);
-    int getInstID(BasicBlock*, Instruction*);
+    bool isLiveInInst(llvm::BasicBlock*, llvm::Instruction*);
+    bool containsInst(llvm::BasicBlock*, llvm::Instruction*);
+    int getInstID(llvm::BasicBlock*, llvm::Instruction*);
     // Reorder the DFG nodes (initial CPU execution ordering) in
     // ASAP (as soon as possible) or ALAP (as last as possible)
     // for mapping.
     void reorderInASAP();
     void reorderInALAP();
-    void reorderInLongest();
-    void reorderDFS(set<DFGNode*>*, list<DFGNode*>*,
-                    list<DFGNode*>*, DFGNode*);
+    void reorderInTraversal(list<DFGNode*>*, string);
+    void indexSuccNodes(vector<DFGNode*>*, vector<vector<int>>*);
     void initExecLatency(map<string, int>*);
     void initPipelinedOpt(list<string>*);
-    bool isMinimumAndHasNotBeenVisited(set<DFGNode*>*, map<DFGNode*, int>*, DFGNode*);
     // target nonlinear ops
     void nonlinear_combine();
     // target control flows
     void ctrlFlow_combine(map<string, list<string>*>*);
     void splitNodes();
+    void init(bool, bool, bool, int, int);
+    void transform(list<string>*, map<string, int>*, list<string>*,
+        map<string, list<string>*>*, bool);
+    void toImage(DFGImage*);
+    bool fromImage(DFGImage*);
 
   public:
-    DFG(Function&, list<Loop*>*, bool, bool, list<string>*, map<string, int>*,
-        list<string>*, map<string, list<string>*>*, bool, bool, int t_vectorFactorForIdiv = 4, bool enableDistributed = false);
+    DFG(llvm::Function&, list<llvm::Loop*>*, bool, bool, list<string>*, map<string, int>*,
+        list<string>*, map<string, list<string>*>*, bool, bool, int t_vectorFactorForIdiv = 4, bool enableDistributed = false,
+        int t_maxCycleCount = 0);
+    // An empty DFG to be read from a file, see readJSON().
+    DFG(bool, bool, bool, int t_maxCycleCount = 0);
     list<list<DFGNode*>*>* m_cycleNodeLists;
     //initial ordering of insts
     list<DFGNode*> nodes;
@@ -114,15 +146,28 @@ class DFG {
     list<DFGNode*>* getDFSOrderedNodes();
     int getNodeCount();
     int getMaxExecLatency();
-    void construct(Function&);
+    void construct(llvm::Function&);
     void setupCycles();
     list<list<DFGEdge*>*>* calculateCycles();
     list<list<DFGNode*>*>* getCycleLists();
+    list<DFGEdge*>* getDFGEdges();
     int getID(DFGNode*);
     void showOpcodeDistribution();
-    void generateDot(Function&, bool);
+    void generateDot(string, bool);
     void generateJSON();
+    // Reads the DFG written by generateJSON(), returns false if the file
+    // cannot be read.
+    bool readJSON(string);
+    // Writes everything the mapping reads from the DFG, in JSON or, if the
+    // file name ends with ".bin", in binary (see DFGFormat.h).
+    bool saveDFG(string);
+    // Reads the DFG written by saveDFG() (or by generateJSON()) as it was,
+    // returns false if the file cannot be read.
+    bool loadDFG(string);
     void initDVFSLatencyMultiple(int, int, int);
+    void reorderInLongest();
+    void reorderInDFS();
+    void reorderInBFS();
     void reorderInCriticalFirst();
     bool isNodeOnCriticalPath(DFGNode*);
 };
@@ -11,13 +11,8 @@
 #ifndef DFGEdge_H
 #define DFGEdge_H
 
-#include <llvm/Support/raw_ostream.h>
-#include <llvm/Support/FileSystem.h>
-
 #include "DFGNode.h"
 
-using namespace llvm;
-
 class DFGNode;
 
 class DFGEdge
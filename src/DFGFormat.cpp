@@ -0,0 +1,779 @@
+/*
+ * ======================================================================
+ * DFGFormat.cpp
+ * ======================================================================
+ * Serialized DFG (JSON and binary encodings) implementation.
+ *
+ * Date : October 16, 2026
+ */
+
+#include <fstream>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "DFG.h"
+#include "DFGFormat.h"
+#include "Profiler.h"
+#include "json.hpp"
+
+using ordered_json = nlohmann::ordered_json;
+
+// The binary encoding. All the offsets are in bytes from the start of the
+// file, except the ones of the lists (in 4-byte words from the start of
+// the list pool) and of the strings (in bytes from the start of the
+// string pool).
+struct DFGBinaryHeader {
+  char magic[8];
+  uint32_t version;
+  uint32_t flags;
+  uint32_t nodeCount;
+  uint32_t edgeCount;
+  uint32_t nodeOffset;
+  uint32_t edgeOffset;
+  uint32_t listOffset;
+  uint32_t listSize;
+  uint32_t stringOffset;
+  uint32_t stringSize;
+  uint32_t dfgEdges;
+  uint32_t ctrlEdges;
+  // A list of the offsets of the lists of the nodes of each cycle.
+  uint32_t cycles;
+};
+
+#define DFG_BINARY_PRECISION_AWARE (1u << 0)
+#define DFG_BINARY_SUPPORT_DVFS    (1u << 1)
+
+struct DFGBinaryNode {
+  int32_t id;
+  uint32_t flags;
+  int32_t numConst;
+  int32_t bbID;
+  int32_t level;
+  int32_t execLatency;
+  int32_t DVFSLatencyMultiple;
+  int32_t patternRoot;
+  uint32_t opcode;
+  uint32_t callee;
+  uint32_t value;
+  uint32_t inst;
+  uint32_t optType;
+  uint32_t fuType;
+  uint32_t combinedType;
+  uint32_t patternNodes;
+  uint32_t predicatees;
+  uint32_t predNodes;
+  uint32_t succNodes;
+  uint32_t inEdges;
+  uint32_t outEdges;
+  uint32_t cycleIDs;
+};
+
+struct DFGBinaryEdge {
+  int32_t id;
+  int32_t src;
+  int32_t dst;
+  uint32_t flags;
+};
+
+// ----------------------------------------------------------------------
+// JSON encoding.
+// ----------------------------------------------------------------------
+
+bool writeDFGImageJSON(DFGImage* t_image, string t_fileName) {
+  ordered_json imageJson;
+  imageJson["version"] = DFG_FORMAT_VERSION;
+  imageJson["precisionAware"] = t_image->precisionAware;
+  imageJson["supportDVFS"] = t_image->supportDVFS;
+  ordered_json nodesJson = ordered_json::array();
+  for (DFGNodeRecord& node: t_image->nodes) {
+    ordered_json nodeJson;
+    nodeJson["id"] = node.id;
+    nodeJson["inDFG"] = (node.flags & DFG_RECORD_IN_DFG) != 0;
+    nodeJson["opcode"] = node.opcode;
+    nodeJson["callee"] = node.callee;
+    nodeJson["value"] = node.value;
+    nodeJson["inst"] = node.inst;
+    nodeJson["vectorized"] = (node.flags & DFG_RECORD_VECTORIZED) != 0;
+    nodeJson["constantAddSub"] = (node.flags & DFG_RECORD_CONSTANT_ADDSUB) != 0;
+    nodeJson["optType"] = node.optType;
+    nodeJson["fuType"] = node.fuType;
+    nodeJson["numConst"] = node.numConst;
+    nodeJson["combined"] = (node.flags & DFG_RECORD_COMBINED) != 0;
+    nodeJson["combinedType"] = node.combinedType;
+    nodeJson["patternRoot"] = node.patternRoot;
+    nodeJson["isPatternRoot"] = (node.flags & DFG_RECORD_PATTERN_ROOT) != 0;
+    nodeJson["patternNodes"] = node.patternNodes;
+    nodeJson["bb"] = node.bbID;
+    nodeJson["level"] = node.level;
+    nodeJson["latency"] = node.execLatency;
+    nodeJson["DVFSLatencyMultiple"] = node.DVFSLatencyMultiple;
+    nodeJson["pipelinable"] = (node.flags & DFG_RECORD_PIPELINABLE) != 0;
+    nodeJson["critical"] = (node.flags & DFG_RECORD_CRITICAL) != 0;
+    nodeJson["cycleIDs"] = node.cycleIDs;
+    nodeJson["predicatee"] = (node.flags & DFG_RECORD_PREDICATEE) != 0;
+    nodeJson["predicater"] = (node.flags & DFG_RECORD_PREDICATER) != 0;
+    nodeJson["predicatees"] = node.predicatees;
+    nodeJson["predNodes"] = node.predNodes;
+    nodeJson["succNodes"] = node.succNodes;
+    nodeJson["inEdges"] = node.inEdges;
+    nodeJson["outEdges"] = node.outEdges;
+    nodesJson.push_back(nodeJson);
+  }
+  imageJson["nodes"] = nodesJson;
+  ordered_json edgesJson = ordered_json::array();
+  for (DFGEdgeRecord& edge: t_image->edges) {
+    ordered_json edgeJson;
+    edgeJson["id"] = edge.id;
+    edgeJson["src"] = edge.src;
+    edgeJson["dst"] = edge.dst;
+    edgeJson["ctrl"] = (edge.flags & DFG_RECORD_CTRL_EDGE) != 0;
+    edgeJson["inter"] = (edge.flags & DFG_RECORD_INTER_EDGE) != 0;
+    edgesJson.push_back(edgeJson);
+  }
+  imageJson["edges"] = edgesJson;
+  imageJson["dfgEdges"] = t_image->dfgEdges;
+  imageJson["ctrlEdges"] = t_image->ctrlEdges;
+  imageJson["cycles"] = t_image->cycles;
+
+  ofstream jsonFile(t_fileName);
+  if (!jsonFile.good())
+    return false;
+  jsonFile<<imageJson.dump(2)<<"\n";
+  return jsonFile.good();
+}
+
+static unsigned readFlag(ordered_json& t_json, const char* t_key,
+                         unsigned t_flag) {
+  return t_json.at(t_key).get<bool>() ? t_flag : 0;
+}
+
+bool readDFGImageJSON(string t_fileName, DFGImage* t_image) {
+  ifstream jsonFile(t_fileName);
+  if (!jsonFile.good())
+    return false;
+  try {
+    ordered_json imageJson;
+    jsonFile>>imageJson;
+    int version = imageJson.at("version");
+    if (version > DFG_FORMAT_VERSION) {
+      cerr<<"Error: "<<t_fileName<<" is of version "<<version
+          <<", only up to "<<DFG_FORMAT_VERSION<<" is supported\n";
+      return false;
+    }
+    t_image->precisionAware = imageJson.at("precisionAware");
+    t_image->supportDVFS = imageJson.at("supportDVFS");
+    t_image->nodes.clear();
+    for (ordered_json& nodeJson: imageJson.at("nodes")) {
+      DFGNodeRecord node;
+      node.id = nodeJson.at("id");
+      node.flags = readFlag(nodeJson, "inDFG", DFG_RECORD_IN_DFG) |
+                   readFlag(nodeJson, "vectorized", DFG_RECORD_VECTORIZED) |
+                   readFlag(nodeJson, "constantAddSub", DFG_RECORD_CONSTANT_ADDSUB) |
+                   readFlag(nodeJson, "combined", DFG_RECORD_COMBINED) |
+                   readFlag(nodeJson, "isPatternRoot", DFG_RECORD_PATTERN_ROOT) |
+                   readFlag(nodeJson, "critical", DFG_RECORD_CRITICAL) |
+                   readFlag(nodeJson, "pipelinable", DFG_RECORD_PIPELINABLE) |
+                   readFlag(nodeJson, "predicatee", DFG_RECORD_PREDICATEE) |
+                   readFlag(nodeJson, "predicater", DFG_RECORD_PREDICATER);
+      node.opcode = nodeJson.at("opcode");
+      node.callee = nodeJson.at("callee");
+      node.value = nodeJson.at("value");
+      node.inst = nodeJson.at("inst");
+      node.optType = nodeJson.at("optType");
+      node.fuType = nodeJson.at("fuType");
+      node.combinedType = nodeJson.at("combinedType");
+      node.numConst = nodeJson.at("numConst");
+      node.bbID = nodeJson.at("bb");
+      node.level = nodeJson.at("level");
+      node.execLatency = nodeJson.at("latency");
+      node.DVFSLatencyMultiple = nodeJson.at("DVFSLatencyMultiple");
+      node.patternRoot = nodeJson.at("patternRoot");
+      node.patternNodes = nodeJson.at("patternNodes").get<vector<int>>();
+      node.predicatees = nodeJson.at("predicatees").get<vector<int>>();
+      node.predNodes = nodeJson.at("predNodes").get<vector<int>>();
+      node.succNodes = nodeJson.at("succNodes").get<vector<int>>();
+      node.inEdges = nodeJson.at("inEdges").get<vector<int>>();
+      node.outEdges = nodeJson.at("outEdges").get<vector<int>>();
+      node.cycleIDs = nodeJson.at("cycleIDs").get<vector<int>>();
+      t_image->nodes.push_back(node);
+    }
+    t_image->edges.clear();
+    for (ordered_json& edgeJson: imageJson.at("edges")) {
+      DFGEdgeRecord edge;
+      edge.id = edgeJson.at("id");
+      edge.src = edgeJson.at("src");
+      edge.dst = edgeJson.at("dst");
+      edge.flags = readFlag(edgeJson, "ctrl", DFG_RECORD_CTRL_EDGE) |
+                   readFlag(edgeJson, "inter", DFG_RECORD_INTER_EDGE);
+      t_image->edges.push_back(edge);
+    }
+    t_image->dfgEdges = imageJson.at("dfgEdges").get<vector<int>>();
+    t_image->ctrlEdges = imageJson.at("ctrlEdges").get<vector<int>>();
+    t_image->cycles = imageJson.at("cycles").get<vector<vector<int>>>();
+  } catch (nlohmann::json::exception& e) {
+    cerr<<"Error: cannot parse "<<t_fileName<<": "<<e.what()<<"\n";
+    return false;
+  }
+  return true;
+}
+
+// ----------------------------------------------------------------------
+// Binary encoding.
+// ----------------------------------------------------------------------
+
+static uint32_t appendList(vector<int32_t>* t_pool, vector<int>& t_list) {
+  uint32_t offset = t_pool->size();
+  t_pool->push_back(t_list.size());
+  t_pool->insert(t_pool->end(), t_list.begin(), t_list.end());
+  return offset;
+}
+
+// Identical strings (e.g., the opcodes and the FU types) are stored once.
+static uint32_t appendString(vector<char>* t_pool,
+                             map<string, uint32_t>* t_offsets,
+                             string& t_string) {
+  auto it = t_offsets->find(t_string);
+  if (it != t_offsets->end())
+    return it->second;
+  uint32_t offset = t_pool->size();
+  t_pool->insert(t_pool->end(), t_string.begin(), t_string.end());
+  t_pool->push_back('\0');
+  (*t_offsets)[t_string] = offset;
+  return offset;
+}
+
+bool writeDFGImageBinary(DFGImage* t_image, string t_fileName) {
+  vector<DFGBinaryNode> nodes;
+  vector<DFGBinaryEdge> edges;
+  vector<int32_t> lists;
+  vector<char> strings;
+  map<string, uint32_t> stringOffsets;
+  for (DFGNodeRecord& node: t_image->nodes) {
+    DFGBinaryNode record;
+    record.id = node.id;
+    record.flags = node.flags;
+    record.numConst = node.numConst;
+    record.bbID = node.bbID;
+    record.level = node.level;
+    record.execLatency = node.execLatency;
+    record.DVFSLatencyMultiple = node.DVFSLatencyMultiple;
+    record.patternRoot = node.patternRoot;
+    record.opcode = appendString(&strings, &stringOffsets, node.opcode);
+    record.callee = appendString(&strings, &stringOffsets, node.callee);
+    record.value = appendString(&strings, &stringOffsets, node.value);
+    record.inst = appendString(&strings, &stringOffsets, node.inst);
+    record.optType = appendString(&strings, &stringOffsets, node.optType);
+    record.fuType = appendString(&strings, &stringOffsets, node.fuType);
+    record.combinedType = appendString(&strings, &stringOffsets,
+                                       node.combinedType);
+    record.patternNodes = appendList(&lists, node.patternNodes);
+    record.predicatees = appendList(&lists, node.predicatees);
+    record.predNodes = appendList(&lists, node.predNodes);
+    record.succNodes = appendList(&lists, node.succNodes);
+    record.inEdges = appendList(&lists, node.inEdges);
+    record.outEdges = appendList(&lists, node.outEdges);
+    record.cycleIDs = appendList(&lists, node.cycleIDs);
+    nodes.push_back(record);
+  }
+  for (DFGEdgeRecord& edge: t_image->edges) {
+    DFGBinaryEdge record;
+    record.id = edge.id;
+    record.src = edge.src;
+    record.dst = edge.dst;
+    record.flags = edge.flags;
+    edges.push_back(record);
+  }
+
+  DFGBinaryHeader header;
+  memset(&header, 0, sizeof(header));
+  memcpy(header.magic, DFG_BINARY_MAGIC, sizeof(header.magic));
+  header.version = DFG_FORMAT_VERSION;
+  header.flags = (t_image->precisionAware ? DFG_BINARY_PRECISION_AWARE : 0) |
+                 (t_image->supportDVFS ? DFG_BINARY_SUPPORT_DVFS : 0);
+  header.dfgEdges = appendList(&lists, t_image->dfgEdges);
+  header.ctrlEdges = appendList(&lists, t_image->ctrlEdges);
+  vector<int> cycleOffsets;
+  for (vector<int>& cycle: t_image->cycles) {
+    cycleOffsets.push_back(appendList(&lists, cycle));
+  }
+  header.cycles = appendList(&lists, cycleOffsets);
+  header.nodeCount = nodes.size();
+  header.edgeCount = edges.size();
+  header.nodeOffset = sizeof(DFGBinaryHeader);
+  header.edgeOffset = header.nodeOffset + nodes.size() * sizeof(DFGBinaryNode);
+  header.listOffset = header.edgeOffset + edges.size() * sizeof(DFGBinaryEdge);
+  header.listSize = lists.size();
+  header.stringOffset = header.listOffset + lists.size() * sizeof(int32_t);
+  header.stringSize = strings.size();
+
+  ofstream binFile(t_fileName, ios::binary);
+  if (!binFile.good())
+    return false;
+  binFile.write((const char*)&header, sizeof(header));
+  binFile.write((const char*)nodes.data(), nodes.size() * sizeof(DFGBinaryNode));
+  binFile.write((const char*)edges.data(), edges.size() * sizeof(DFGBinaryEdge));
+  binFile.write((const char*)lists.data(), lists.size() * sizeof(int32_t));
+  binFile.write(strings.data(), strings.size());
+  return binFile.good();
+}
+
+// Reads the list at the offset of the pool, returns false if it does not
+// fit into the pool.
+static bool readList(const int32_t* t_pool, uint32_t t_poolSize,
+                     uint32_t t_offset, vector<int>* t_list) {
+  if (t_offset >= t_poolSize or t_pool[t_offset] < 0 or
+      (uint32_t)t_pool[t_offset] > t_poolSize - t_offset - 1)
+    return false;
+  t_list->assign(t_pool + t_offset + 1, t_pool + t_offset + 1 + t_pool[t_offset]);
+  return true;
+}
+
+static bool readString(const char* t_pool, uint32_t t_poolSize,
+                       uint32_t t_offset, string* t_string) {
+  if (t_offset >= t_poolSize)
+    return false;
+  const char* end = (const char*)memchr(t_pool + t_offset, '\0',
+                                        t_poolSize - t_offset);
+  if (end == NULL)
+    return false;
+  t_string->assign(t_pool + t_offset, end);
+  return true;
+}
+
+static bool decodeBinary(const char* t_data, size_t t_size,
+                         DFGImage* t_image) {
+  if (t_size < sizeof(DFGBinaryHeader))
+    return false;
+  const DFGBinaryHeader* header = (const DFGBinaryHeader*)t_data;
+  if (memcmp(header->magic, DFG_BINARY_MAGIC, sizeof(header->magic)) != 0)
+    return false;
+  if (header->version > DFG_FORMAT_VERSION) {
+    cerr<<"Error: the binary DFG is of version "<<header->version
+        <<", only up to "<<DFG_FORMAT_VERSION<<" is supported\n";
+    return false;
+  }
+  if (header->nodeOffset % 4 != 0 or header->edgeOffset % 4 != 0 or
+      header->listOffset % 4 != 0 or
+      header->nodeOffset + (uint64_t)header->nodeCount * sizeof(DFGBinaryNode) > t_size or
+      header->edgeOffset + (uint64_t)header->edgeCount * sizeof(DFGBinaryEdge) > t_size or
+      header->listOffset + (uint64_t)header->listSize * sizeof(int32_t) > t_size or
+      header->stringOffset + (uint64_t)header->stringSize > t_size)
+    return false;
+  const DFGBinaryNode* nodes = (const DFGBinaryNode*)(t_data + header->nodeOffset);
+  const DFGBinaryEdge* edges = (const DFGBinaryEdge*)(t_data + header->edgeOffset);
+  const int32_t* lists = (const int32_t*)(t_data + header->listOffset);
+  const char* strings = t_data + header->stringOffset;
+  uint32_t listSize = header->listSize;
+  uint32_t stringSize = header->stringSize;
+
+  t_image->precisionAware = header->flags & DFG_BINARY_PRECISION_AWARE;
+  t_image->supportDVFS = header->flags & DFG_BINARY_SUPPORT_DVFS;
+  t_image->nodes.assign(header->nodeCount, DFGNodeRecord());
+  for (uint32_t i=0; i<header->nodeCount; ++i) {
+    const DFGBinaryNode& record = nodes[i];
+    DFGNodeRecord& node = t_image->nodes[i];
+    node.id = record.id;
+    node.flags = record.flags;
+    node.numConst = record.numConst;
+    node.bbID = record.bbID;
+    node.level = record.level;
+    node.execLatency = record.execLatency;
+    node.DVFSLatencyMultiple = record.DVFSLatencyMultiple;
+    node.patternRoot = record.patternRoot;
+    if (!readString(strings, stringSize, record.opcode, &node.opcode) or
+        !readString(strings, stringSize, record.callee, &node.callee) or
+        !readString(strings, stringSize, record.value, &node.value) or
+        !readString(strings, stringSize, record.inst, &node.inst) or
+        !readString(strings, stringSize, record.optType, &node.optType) or
+        !readString(strings, stringSize, record.fuType, &node.fuType) or
+        !readString(strings, stringSize, record.combinedType, &node.combinedType) or
+        !readList(lists, listSize, record.patternNodes, &node.patternNodes) or
+        !readList(lists, listSize, record.predicatees, &node.predicatees) or
+        !readList(lists, listSize, record.predNodes, &node.predNodes) or
+        !readList(lists, listSize, record.succNodes, &node.succNodes) or
+        !readList(lists, listSize, record.inEdges, &node.inEdges) or
+        !readList(lists, listSize, record.outEdges, &node.outEdges) or
+        !readList(lists, listSize, record.cycleIDs, &node.cycleIDs))
+      return false;
+  }
+  t_image->edges.assign(header->edgeCount, DFGEdgeRecord());
+  for (uint32_t i=0; i<header->edgeCount; ++i) {
+    t_image->edges[i].id = edges[i].id;
+    t_image->edges[i].src = edges[i].src;
+    t_image->edges[i].dst = edges[i].dst;
+    t_image->edges[i].flags = edges[i].flags;
+  }
+  vector<int> cycleOffsets;
+  if (!readList(lists, listSize, header->dfgEdges, &t_image->dfgEdges) or
+      !readList(lists, listSize, header->ctrlEdges, &t_image->ctrlEdges) or
+      !readList(lists, listSize, header->cycles, &cycleOffsets))
+    return false;
+  t_image->cycles.assign(cycleOffsets.size(), vector<int>());
+  for (int i=0; i<(int)cycleOffsets.size(); ++i) {
+    if (!readList(lists, listSize, cycleOffsets[i], &t_image->cycles[i]))
+      return false;
+  }
+  return true;
+}
+
+bool readDFGImageBinary(string t_fileName, DFGImage* t_image) {
+  int fd = open(t_fileName.c_str(), O_RDONLY);
+  if (fd < 0)
+    return false;
+  struct stat fileStat;
+  if (fstat(fd, &fileStat) != 0 or fileStat.st_size == 0) {
+    close(fd);
+    return false;
+  }
+  size_t size = fileStat.st_size;
+  void* data = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+  close(fd);
+  if (data == MAP_FAILED)
+    return false;
+  bool success = decodeBinary((const char*)data, size, t_image);
+  munmap(data, size);
+  if (!success)
+    cerr<<"Error: "<<t_fileName<<" is not a valid binary DFG\n";
+  return success;
+}
+
+bool isDFGImageBinary(string t_fileName) {
+  ifstream binFile(t_fileName, ios::binary);
+  char magic[8];
+  if (!binFile.read(magic, sizeof(magic)))
+    return false;
+  return memcmp(magic, DFG_BINARY_MAGIC, sizeof(magic)) == 0;
+}
+
+// ----------------------------------------------------------------------
+// Conversion between the DFG and its image.
+// ----------------------------------------------------------------------
+
+static int indexNode(DFGNode* t_node, vector<DFGNode*>* t_nodes,
+                     unordered_map<DFGNode*, int>* t_nodeIndex) {
+  if (t_node == NULL)
+    return -1;
+  auto it = t_nodeIndex->find(t_node);
+  if (it != t_nodeIndex->end())
+    return it->second;
+  int index = t_nodes->size();
+  t_nodes->push_back(t_node);
+  (*t_nodeIndex)[t_node] = index;
+  return index;
+}
+
+static int indexEdge(DFGEdge* t_edge, vector<DFGEdge*>* t_edges,
+                     unordered_map<DFGEdge*, int>* t_edgeIndex) {
+  auto it = t_edgeIndex->find(t_edge);
+  if (it != t_edgeIndex->end())
+    return it->second;
+  int index = t_edges->size();
+  t_edges->push_back(t_edge);
+  (*t_edgeIndex)[t_edge] = index;
+  return index;
+}
+
+// The nodes of the DFG come first, followed by the other nodes reachable
+// from them (via the edges, the patterns, and the predicatees).
+void DFG::toImage(DFGImage* t_image) {
+  t_image->precisionAware = m_precisionAware;
+  t_image->supportDVFS = m_supportDVFS;
+  vector<DFGNode*> indexedNodes;
+  unordered_map<DFGNode*, int> nodeIndex;
+  vector<DFGEdge*> indexedEdges;
+  unordered_map<DFGEdge*, int> edgeIndex;
+  for (DFGNode* node: nodes) {
+    indexNode(node, &indexedNodes, &nodeIndex);
+  }
+  for (DFGEdge* edge: m_DFGEdges) {
+    t_image->dfgEdges.push_back(indexEdge(edge, &indexedEdges, &edgeIndex));
+  }
+  for (DFGEdge* edge: m_ctrlEdges) {
+    t_image->ctrlEdges.push_back(indexEdge(edge, &indexedEdges, &edgeIndex));
+  }
+
+  for (list<DFGNode*>* cycle: *m_cycleNodeLists) {
+    vector<int> cycleNodes;
+    for (DFGNode* node: *cycle) {
+      cycleNodes.push_back(indexNode(node, &indexedNodes, &nodeIndex));
+    }
+    t_image->cycles.push_back(cycleNodes);
+  }
+
+  int nodeCount = nodes.size();
+  int nodePos = 0;
+  int edgePos = 0;
+  while (nodePos < (int)indexedNodes.size() or
+         edgePos < (int)indexedEdges.size()) {
+    for (; edgePos < (int)indexedEdges.size(); ++edgePos) {
+      DFGEdge* edge = indexedEdges[edgePos];
+      DFGEdgeRecord record;
+      record.id = edge->getID();
+      record.src = indexNode(edge->getSrc(), &indexedNodes, &nodeIndex);
+      record.dst = indexNode(edge->getDst(), &indexedNodes, &nodeIndex);
+      record.flags = (edge->isCtrlEdge() ? DFG_RECORD_CTRL_EDGE : 0) |
+                     (edge->isInterEdge() ? DFG_RECORD_INTER_EDGE : 0);
+      t_image->edges.push_back(record);
+    }
+    for (; nodePos < (int)indexedNodes.size(); ++nodePos) {
+      DFGNode* node = indexedNodes[nodePos];
+      DFGNodeRecord record;
+      record.id = node->getID();
+      record.flags = (nodePos < nodeCount ? DFG_RECORD_IN_DFG : 0) |
+                     (node->isVectorized() ? DFG_RECORD_VECTORIZED : 0) |
+                     (node->isConstantAddSub() ? DFG_RECORD_CONSTANT_ADDSUB : 0) |
+                     (node->hasCombined() ? DFG_RECORD_COMBINED : 0) |
+                     (node->isPatternRoot() ? DFG_RECORD_PATTERN_ROOT : 0) |
+                     (node->isCritical() ? DFG_RECORD_CRITICAL : 0) |
+                     (node->isPipelinable() ? DFG_RECORD_PIPELINABLE : 0) |
+                     (node->isPredicatee() ? DFG_RECORD_PREDICATEE : 0) |
+                     (node->isPredicater() ? DFG_RECORD_PREDICATER : 0);
+      record.opcode = node->getRawOpcodeName();
+      record.callee = node->getCalleeName();
+      record.value = node->getValueName();
+      record.inst = node->getInst() == NULL ? "" : node->getInstText();
+      record.optType = node->getOptType();
+      record.fuType = node->getFuType();
+      record.combinedType = node->hasCombined() ? node->getComplexType() : "";
+      record.numConst = node->getNumConst();
+      record.bbID = node->getBBID();
+      record.level = node->getLevel();
+      record.execLatency = node->getRawExecLatency();
+      record.DVFSLatencyMultiple = node->getDVFSLatencyMultiple();
+      record.patternRoot = indexNode(node->getPatternRoot(), &indexedNodes,
+                                     &nodeIndex);
+      for (DFGNode* patternNode: *(node->getPatternNodes())) {
+        record.patternNodes.push_back(indexNode(patternNode, &indexedNodes,
+                                                &nodeIndex));
+      }
+      if (node->getPredicatees() != NULL) {
+        for (DFGNode* predicatee: *(node->getPredicatees())) {
+          record.predicatees.push_back(indexNode(predicatee, &indexedNodes,
+                                                 &nodeIndex));
+        }
+      }
+      if (nodePos < nodeCount) {
+        for (DFGNode* predNode: *(node->getPredNodes())) {
+          record.predNodes.push_back(indexNode(predNode, &indexedNodes,
+                                               &nodeIndex));
+        }
+        for (DFGNode* succNode: *(node->getSuccNodes())) {
+          record.succNodes.push_back(indexNode(succNode, &indexedNodes,
+                                               &nodeIndex));
+        }
+      }
+      for (DFGEdge* edge: *(node->getInEdges())) {
+        record.inEdges.push_back(indexEdge(edge, &indexedEdges, &edgeIndex));
+      }
+      for (DFGEdge* edge: *(node->getOutEdges())) {
+        record.outEdges.push_back(indexEdge(edge, &indexedEdges, &edgeIndex));
+      }
+      for (int cycleID: *(node->getCycleIDs())) {
+        record.cycleIDs.push_back(cycleID);
+      }
+      t_image->nodes.push_back(record);
+    }
+  }
+
+}
+
+static bool inRange(vector<int>& t_indexes, int t_size) {
+  for (int index: t_indexes) {
+    if (index < 0 or index >= t_size)
+      return false;
+  }
+  return true;
+}
+
+// Rebuilds the DFG as it was written, i.e., without recalculating anything
+// (the cycles, the fusion, the latencies, ...) and without any LLVM
+// instruction.
+bool DFG::fromImage(DFGImage* t_image) {
+  int nodeCount = t_image->nodes.size();
+  int edgeCount = t_image->edges.size();
+  for (DFGNodeRecord& record: t_image->nodes) {
+    if ((record.patternRoot < -1 or record.patternRoot >= nodeCount) or
+        !inRange(record.patternNodes, nodeCount) or
+        !inRange(record.predicatees, nodeCount) or
+        !inRange(record.predNodes, nodeCount) or
+        !inRange(record.succNodes, nodeCount) or
+        !inRange(record.inEdges, edgeCount) or
+        !inRange(record.outEdges, edgeCount) or
+        (record.DVFSLatencyMultiple != 1 and
+         record.DVFSLatencyMultiple != 2 and
+         record.DVFSLatencyMultiple != 4))
+      return false;
+  }
+  for (DFGEdgeRecord& record: t_image->edges) {
+    if (record.src < 0 or record.src >= nodeCount or
+        record.dst < 0 or record.dst >= nodeCount)
+      return false;
+  }
+  if (!inRange(t_image->dfgEdges, edgeCount) or
+      !inRange(t_image->ctrlEdges, edgeCount))
+    return false;
+  for (vector<int>& cycle: t_image->cycles) {
+    if (!inRange(cycle, nodeCount))
+      return false;
+  }
+  if (t_image->precisionAware != m_precisionAware or
+      t_image->supportDVFS != m_supportDVFS) {
+    cerr<<"Warning: the DFG was written with precisionAware: "
+        <<t_image->precisionAware<<", supportDVFS: "<<t_image->supportDVFS
+        <<", which differ from the ones of the mapping\n";
+  }
+
+  m_DFGEdges.clear();
+  nodes.clear();
+  m_ctrlEdges.clear();
+  m_nodeIndex.clear();
+  m_DFGEdgeIndex.clear();
+  m_ctrlEdgeIndex.clear();
+
+  vector<DFGNode*> indexedNodes;
+  for (DFGNodeRecord& record: t_image->nodes) {
+    DFGNode* node = new DFGNode(record.id, m_precisionAware, record.opcode,
+                                record.flags & DFG_RECORD_VECTORIZED,
+                                record.callee, record.value, m_supportDVFS);
+    if (!record.inst.empty())
+      node->setInstText(record.inst);
+    if (record.flags & DFG_RECORD_CONSTANT_ADDSUB)
+      node->setConstantAddSub();
+    for (int i=0; i<record.numConst; ++i) {
+      node->addConst();
+    }
+    if (record.flags & DFG_RECORD_COMBINED)
+      node->setCombine(record.combinedType);
+    node->setTypes(record.optType, record.fuType);
+    node->setBBID(record.bbID);
+    node->setLevel(record.level);
+    node->setDVFSLatencyMultiple(record.DVFSLatencyMultiple);
+    node->setExecLatency(record.execLatency);
+    if (record.flags & DFG_RECORD_PIPELINABLE)
+      node->setPipelinable();
+    if (record.flags & DFG_RECORD_CRITICAL)
+      node->setCritical();
+    for (int cycleID: record.cycleIDs) {
+      node->addCycleID(cycleID);
+    }
+    if (record.flags & DFG_RECORD_PREDICATEE)
+      node->setPredicatee();
+    indexedNodes.push_back(node);
+    if (record.flags & DFG_RECORD_IN_DFG)
+      appendNode(node);
+  }
+  m_num = nodeCount;
+
+  vector<DFGEdge*> indexedEdges;
+  for (DFGEdgeRecord& record: t_image->edges) {
+    DFGNode* src = indexedNodes[record.src];
+    DFGNode* dst = indexedNodes[record.dst];
+    DFGEdge* edge;
+    if (record.flags & DFG_RECORD_CTRL_EDGE) {
+      edge = new DFGEdge(record.id, src, dst, true);
+    } else {
+      edge = new DFGEdge(record.id, src, dst);
+      if (record.flags & DFG_RECORD_INTER_EDGE)
+        edge->setInterEdge(true);
+    }
+    indexedEdges.push_back(edge);
+  }
+  for (int edge: t_image->dfgEdges) {
+    addDFGEdge(indexedEdges[edge]);
+  }
+  for (int edge: t_image->ctrlEdges) {
+    addCtrlEdge(indexedEdges[edge]);
+  }
+  m_CDFGFused = true;
+
+  for (int i=0; i<nodeCount; ++i) {
+    DFGNodeRecord& record = t_image->nodes[i];
+    DFGNode* node = indexedNodes[i];
+    for (int edge: record.inEdges) {
+      node->setInEdge(indexedEdges[edge]);
+    }
+    for (int edge: record.outEdges) {
+      node->setOutEdge(indexedEdges[edge]);
+    }
+    if (record.flags & DFG_RECORD_PATTERN_ROOT) {
+      for (int patternNode: record.patternNodes) {
+        node->linkPatternPartner(indexedNodes[patternNode]);
+      }
+    }
+    // The ctrl edges above already added their destinations.
+    if ((record.flags & DFG_RECORD_PREDICATER) or node->isPredicater()) {
+      list<DFGNode*>* predicatees = new list<DFGNode*>();
+      for (int predicatee: record.predicatees) {
+        predicatees->push_back(indexedNodes[predicatee]);
+      }
+      node->setPredicatees(predicatees);
+    }
+    if (record.flags & DFG_RECORD_IN_DFG) {
+      list<DFGNode*>* predNodes = new list<DFGNode*>();
+      for (int predNode: record.predNodes) {
+        predNodes->push_back(indexedNodes[predNode]);
+      }
+      node->setPredNodes(predNodes);
+      list<DFGNode*>* succNodes = new list<DFGNode*>();
+      for (int succNode: record.succNodes) {
+        succNodes->push_back(indexedNodes[succNode]);
+      }
+      node->setSuccNodes(succNodes);
+    }
+  }
+  // The roots are only set once all the patterns are linked, e.g., the
+  // nodes split from a fused node share its partners.
+  for (int i=0; i<nodeCount; ++i) {
+    int patternRoot = t_image->nodes[i].patternRoot;
+    indexedNodes[i]->setPatternRoot(patternRoot == -1 ? NULL :
+                                    indexedNodes[patternRoot]);
+  }
+
+  for (list<DFGNode*>* nodeCycle: *m_cycleNodeLists) {
+    delete nodeCycle;
+  }
+  m_cycleNodeLists->clear();
+  for (vector<int>& cycle: t_image->cycles) {
+    list<DFGNode*>* nodeCycle = new list<DFGNode*>();
+    for (int node: cycle) {
+      nodeCycle->push_back(indexedNodes[node]);
+    }
+    m_cycleNodeLists->push_back(nodeCycle);
+  }
+  return true;
+}
+
+bool DFG::saveDFG(string t_fileName) {
+  ScopedTimer timer("output.dfg");
+  DFGImage image;
+  toImage(&image);
+  bool isBinary = t_fileName.size() > 4 and
+                  t_fileName.compare(t_fileName.size() - 4, 4, ".bin") == 0;
+  return isBinary ? writeDFGImageBinary(&image, t_fileName) :
+                    writeDFGImageJSON(&image, t_fileName);
+}
+
+bool DFG::loadDFG(string t_fileName) {
+  DFGImage image;
+  if (isDFGImageBinary(t_fileName)) {
+    if (!readDFGImageBinary(t_fileName, &image))
+      return false;
+  } else {
+    // The dfg.json written by generateJSON() is a list of the nodes.
+    ifstream jsonFile(t_fileName);
+    char first = '\0';
+    jsonFile>>first;
+    if (first == '[')
+      return readJSON(t_fileName);
+    if (!readDFGImageJSON(t_fileName, &image))
+      return false;
+  }
+  if (!fromImage(&image)) {
+    cerr<<"Error: "<<t_fileName<<" refers to the nodes/edges out of range\n";
+    return false;
+  }
+  return true;
+}
@@ -0,0 +1,110 @@
+/*
+ * ======================================================================
+ * DFGFormat.h
+ * ======================================================================
+ * Serialized DFG (JSON and binary encodings) header file.
+ *
+ * Date : October 16, 2026
+ */
+
+#ifndef DFGFormat_H
+#define DFGFormat_H
+
+#include <string>
+#include <vector>
+#include <stdint.h>
+
+using namespace std;
+
+// Bumped whenever a field of the serialized DFG is added, removed, or
+// changes its meaning. The readers reject the newer versions.
+#define DFG_FORMAT_VERSION 1
+
+// Leading bytes of the binary encoding (including the terminating '\0').
+#define DFG_BINARY_MAGIC "CGRADFG"
+
+// Flags of a serialized node.
+#define DFG_RECORD_IN_DFG          (1u << 0)
+#define DFG_RECORD_VECTORIZED      (1u << 1)
+#define DFG_RECORD_CONSTANT_ADDSUB (1u << 2)
+#define DFG_RECORD_COMBINED        (1u << 3)
+#define DFG_RECORD_PATTERN_ROOT    (1u << 4)
+#define DFG_RECORD_CRITICAL        (1u << 5)
+#define DFG_RECORD_PIPELINABLE     (1u << 6)
+#define DFG_RECORD_PREDICATEE      (1u << 7)
+#define DFG_RECORD_PREDICATER      (1u << 8)
+
+// Flags of a serialized edge.
+#define DFG_RECORD_CTRL_EDGE       (1u << 0)
+#define DFG_RECORD_INTER_EDGE      (1u << 1)
+
+// A node of the serialized DFG. The nodes and the edges refer to each
+// other by their positions in the tables of the DFGImage, as the IDs of
+// the nodes are not unique (e.g., the ones split by DFG::splitNodes()).
+// Besides the nodes of the DFG (DFG_RECORD_IN_DFG, in the order they are
+// mapped), the tables hold the nodes only kept for their edges, e.g., the
+// partners of the fused nodes.
+struct DFGNodeRecord {
+  int id;
+  unsigned flags;
+  // The raw opcode (see DFGNode::getRawOpcodeName()).
+  string opcode;
+  string callee;
+  string value;
+  // The instruction as printed, empty unless the DFG debug log is on.
+  string inst;
+  string optType;
+  string fuType;
+  string combinedType;
+  int numConst;
+  int bbID;
+  int level;
+  int execLatency;
+  int DVFSLatencyMultiple;
+  // -1 if the node is not fused.
+  int patternRoot;
+  vector<int> patternNodes;
+  vector<int> predicatees;
+  // Only kept for the nodes of the DFG, the others derive them from their
+  // edges on demand.
+  vector<int> predNodes;
+  vector<int> succNodes;
+  vector<int> inEdges;
+  vector<int> outEdges;
+  vector<int> cycleIDs;
+};
+
+struct DFGEdgeRecord {
+  int id;
+  int src;
+  int dst;
+  unsigned flags;
+};
+
+// The DFG as plain tables, i.e., everything the mapping reads from it.
+struct DFGImage {
+  bool precisionAware;
+  bool supportDVFS;
+  vector<DFGNodeRecord> nodes;
+  vector<DFGEdgeRecord> edges;
+  // The data flow edges (incl. the fused ctrl flow) and the ctrl flow
+  // edges, in their order in the DFG.
+  vector<int> dfgEdges;
+  vector<int> ctrlEdges;
+  // The nodes of each cycle, in the order of the cycle IDs.
+  vector<vector<int>> cycles;
+};
+
+// The JSON encoding, i.e., an object with the version and the tables.
+bool writeDFGImageJSON(DFGImage*, string);
+bool readDFGImageJSON(string, DFGImage*);
+
+// The binary encoding, i.e., a header followed by the fixed-size node and
+// edge records, a pool of the lists (each as its length followed by its
+// items), and a pool of the '\0'-terminated strings. The records are
+// 4-byte aligned and read in place from the memory-mapped file.
+bool writeDFGImageBinary(DFGImage*, string);
+bool readDFGImageBinary(string, DFGImage*);
+bool isDFGImageBinary(string);
+
+#endif
@@ -0,0 +1,464 @@
+/*
+ * ======================================================================
+ * DFGLLVM.cpp
+ * ======================================================================
+ * DFG construction from the LLVM IR implementation.
+ *
+ * Date : October 16, 2026
+ */
+
+#include <llvm/IR/Function.h>
+#include <llvm/IR/BasicBlock.h>
+#include <llvm/IR/Value.h>
+#include <llvm/IR/Constants.h>
+#include <llvm/IR/Instruction.h>
+#include <llvm/IR/Instructions.h>
+#include <llvm/Support/raw_ostream.h>
+#include <llvm/IR/CFG.h>
+#include <llvm/Analysis/LoopInfo.h>
+#include <llvm/Demangle/Demangle.h>
+#include "DFG.h"
+#include "Log.h"
+#include "Profiler.h"
+
+using namespace llvm;
+
+int testing_opcode_offset = 0;
+string initOpcodeNameHelper(Instruction* inst);
+
+// The name of the function called by a precision-unaware DFG node, which
+// the node is shown as.
+static string initCalleeName(Instruction* t_inst) {
+  Function *func = ((CallInst*)t_inst)->getCalledFunction();
+  if (!func)
+    return "indirect call";
+  string newName = func->getName().str();
+  if (t_inst->getType()->isVectorTy()) {
+    string removingPattern = "llvm.vector.";
+    int pos = newName.find(removingPattern);
+    if (pos == -1)
+    pos = newName.find("llvm.");
+	  newName.erase(pos, removingPattern.length());
+    string delimiter = ".v";
+    newName = newName.substr(0, newName.find(delimiter));
+	  replace(newName.begin(), newName.end(), '.', '_');
+    return newName;
+  }
+  newName = demangle(newName);
+  return newName.substr(0, newName.find("("));
+}
+
+static string initOpcodeName(Instruction* t_inst) {
+  if (testing_opcode_offset == 0) {
+    return t_inst->getOpcodeName();
+  }
+  return initOpcodeNameHelper(t_inst);
+}
+
+DFGNode::DFGNode(int t_id, bool t_precisionAware, Instruction* t_inst,
+                 string t_valueName, bool t_supportDVFS) :
+    DFGNode(t_id, t_precisionAware, initOpcodeName(t_inst),
+            t_inst->getType()->isVectorTy(),
+            (!t_precisionAware and initOpcodeName(t_inst) == "call") ?
+                initCalleeName(t_inst) : "",
+            t_valueName, t_supportDVFS) {
+  m_inst = t_inst;
+  if (auto* addInst = dyn_cast<BinaryOperator>(t_inst)) {
+    if (addInst->getOpcode() == Instruction::Add) {
+      Value* op1 = addInst->getOperand(0);
+      Value* op2 = addInst->getOperand(1);
+      m_constantAddSub = isa<ConstantInt>(op1) || isa<ConstantInt>(op2);
+    }
+  }
+  if (CGRA_LOG_ENABLED(LOG_DFG, LOG_DEBUG)) {
+    raw_string_ostream os(m_instText);
+    t_inst->print(os);
+  }
+}
+
+DFG::DFG(Function& t_F, list<Loop*>* t_loops, bool t_targetFunction,
+         bool t_precisionAware, list<string>* t_fusionStrategy,
+         map<string, int>* t_execLatency, list<string>* t_pipelinedOpt,
+         map<string, list<string>*>* t_fusionPattern,
+	      bool t_supportDVFS, bool t_DVFSAwareMapping,
+	      int t_vectorFactorForIdiv, bool enableDistributed,
+	      int t_maxCycleCount) {
+  init(t_precisionAware, t_supportDVFS, t_DVFSAwareMapping,
+       t_vectorFactorForIdiv, t_maxCycleCount);
+  m_targetFunction = t_targetFunction;
+  m_targetLoops = t_loops;
+
+  construct(t_F);
+  transform(t_fusionStrategy, t_execLatency, t_pipelinedOpt, t_fusionPattern,
+            enableDistributed);
+}
+
+bool DFG::shouldIgnore(Instruction* t_inst) {
+  if (m_targetFunction) {
+    return false;
+  }
+  if (m_targetLoops->size() == 0)
+    return false;
+  for (Loop* current_loop: *m_targetLoops) {
+    if (current_loop->contains(t_inst)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+ // extract DFG from specific function
+ void DFG::construct(Function& t_F) {
+  ScopedTimer timer("dfg.construct");
+
+  m_DFGEdges.clear();
+  nodes.clear();
+  m_ctrlEdges.clear();
+  m_targetBBs.clear();
+  m_nodeIndex.clear();
+  m_DFGEdgeIndex.clear();
+  m_ctrlEdgeIndex.clear();
+
+  int nodeID = 0;
+  int ctrlEdgeID = 0;
+  int dfgEdgeID = 0;
+  int bbID =0;
+
+  CGRA_LOG(LOG_DFG, LOG_INFO)<<"*** current function: "<<t_F.getName().str()<<"\n";
+
+  // construct DFG Nodes.
+  for (Function::iterator BB=t_F.begin(), BEnd=t_F.end(); BB!=BEnd; ++BB) {
+    BasicBlock *curBB = &*BB;
+    bool isTargetBB = false;
+    if (CGRA_LOG_ENABLED(LOG_DFG, LOG_DEBUG)) errs()<<"└── *** current basic block: "<<curBB->getName().str()<<"; First Inst: "<<*curBB->begin()<<"\n";
+    for (BasicBlock::iterator II=curBB->begin(), IEnd=curBB->end(); II!=IEnd; ++II) {
+      Instruction* curII = &*II;
+      if (shouldIgnore(curII)) {
+        if (CGRA_LOG_ENABLED(LOG_DFG, LOG_DEBUG)) errs()<<"│   └── *** ignored by pass because instruction \""<<*curII<<"\" is out of the scope (target loop).\n";
+        continue;
+      }
+      else {
+        isTargetBB = true;
+        DFGNode* dfgNode;
+        dfgNode = new DFGNode(nodeID++, m_precisionAware, curII, getValueName(curII), m_supportDVFS);
+        dfgNode->setBBID(bbID);
+        appendNode(dfgNode);
+        if (CGRA_LOG_ENABLED(LOG_DFG, LOG_DEBUG)) errs()<<"│   └── +++ \""<<*curII<<"\" (ID: "<<dfgNode->getID()<<")\n";
+      }
+    }
+    if(isTargetBB) {
+      if (CGRA_LOG_ENABLED(LOG_DFG, LOG_DEBUG)) errs()<<"└── +++ basic block \""<<curBB->getName().str()<<"\" got ID: "<<bbID<<"\n│\n";
+      m_targetBBs.push_back(curBB);
+      bbID += 1;
+    }
+    else{
+      if (CGRA_LOG_ENABLED(LOG_DFG, LOG_DEBUG)) errs()<<"└── *** ignored by pass because basic block \""<<curBB->getName().str()<<"\" is out of the scope (target loop)."<<"\n│\n";
+    }
+  }
+
+  // construct ctrl flows.
+  // consider 3 types in function "isLiveInInst".
+  // 1. pointed to "sucBB->front()"
+  // 2. pointed to "lonely inst"(i.e. an inst without any flow pointed to it)
+  // 3. pointed to an inst without [intra-iteration & intra-basicblock] data flow pointed to it.
+  for (BasicBlock* curBB : m_targetBBs) {
+    if (CGRA_LOG_ENABLED(LOG_DFG, LOG_DEBUG)) errs()<<"│\n";
+    if (CGRA_LOG_ENABLED(LOG_DFG, LOG_DEBUG)) errs()<<"└── *** curBB: "<<curBB->getName().str()<<"; First Inst: "<<*curBB->begin()<<"\n";
+    Instruction* terminator = curBB->getTerminator();
+    if(shouldIgnore(terminator)) {
+      if (CGRA_LOG_ENABLED(LOG_DFG, LOG_DEBUG)) errs()<<"│   └── *** ignore terminator instruction \""<<*terminator<<"\"\n";
+      continue;
+    }
+    else {
+      if (CGRA_LOG_ENABLED(LOG_DFG, LOG_DEBUG)) errs()<<"│   ├── *** find terminator instruction of curBB: "<<*terminator<<"\n";
+      for(BasicBlock* sucBB : successors(curBB)) {
+        auto it = find(m_targetBBs.begin(), m_targetBBs.end(), sucBB);
+        if(it == m_targetBBs.end()) {
+          if (CGRA_LOG_ENABLED(LOG_DFG, LOG_DEBUG)) errs()<<"│   └── *** ignore sucBB \""<<sucBB->getName().str()<<"\"\n";
+          continue;
+        }
+        else {
+          if (CGRA_LOG_ENABLED(LOG_DFG, LOG_DEBUG)) errs()<<"│   ├── *** into sucBB \""<<sucBB->getName().str()<<"\"\n";
+          for(BasicBlock::iterator II = sucBB->begin(), IEnd = sucBB->end(); II != IEnd; ++II) {
+            Instruction* instruction = &*II;
+            if(isLiveInInst(sucBB,instruction)) {
+              if (CGRA_LOG_ENABLED(LOG_DFG, LOG_DEBUG)) errs()<<"│   │   └── +++ construct ctrl flow: "<<*terminator<<"->"<<*instruction<<"\n";
+              DFGEdge* ctrlEdge;
+              if (hasCtrlEdge(getNode(terminator), getNode(instruction))) {
+                ctrlEdge = getCtrlEdge(getNode(terminator), getNode(instruction));
+              }
+              else {
+                ctrlEdge = new DFGEdge(ctrlEdgeID++, getNode(terminator), getNode(instruction), true);
+                addCtrlEdge(ctrlEdge);
+              }
+            }
+          }
+        }
+      }
+    }
+  }
+
+  // construct data flow edges.
+  for (DFGNode* node: nodes) {
+    Instruction* curII = node->getInst();
+    for (Instruction::op_iterator op = curII->op_begin(), opEnd = curII->op_end(); op != opEnd; ++op) {
+      Instruction* tempInst = dyn_cast<Instruction>(*op);
+      if (tempInst and !shouldIgnore(tempInst)) {
+        DFGEdge* dfgEdge;
+        if (hasNode(tempInst)) {
+          if (hasDFGEdge(getNode(tempInst), node)) {
+            dfgEdge = getDFGEdge(getNode(tempInst), node);
+          }
+          else {
+            dfgEdge = new DFGEdge(dfgEdgeID++, getNode(tempInst), node);
+            if ((dfgEdge->getSrc()->getBBID() != dfgEdge->getDst()->getBBID())
+                or
+                ((dfgEdge->getSrc()->getBBID() == dfgEdge->getDst()->getBBID())
+                 and
+                 (dfgEdge->getSrc()->getID()) > (dfgEdge->getDst()->getID()))) {
+              dfgEdge->setInterEdge(true);
+            }
+            addDFGEdge(dfgEdge);
+          }
+      }
+      else {
+        if(!node->isBranch()) {
+          node->addConst();
+        }
+      }
+    }
+    }
+  }
+
+  connectDFGNodes();
+
+  calculateCycles();
+
+  // The mapping algorithm works on the DFG that is ordered in ASAP.
+  // reorderInASAP();
+  // The mapping algorithm works on the DFG that is ordered in ALAP.
+  // reorderInALAP();
+  // The mapping algorithm works on the DFG that is ordered along with the longest path.
+  reorderInLongest();
+
+}
+
+ bool DFG::isLiveInInst(BasicBlock* t_bb, Instruction* t_inst) {
+   // FOR DEBUG
+ //  errs()<<"[FOR DEBUG] "<<"current inst: "<<*t_inst<<"\n";
+ //  errs()<<"            "<<"op used:"<<"\n";
+ //  for (Instruction::op_iterator op = t_inst->op_begin(), opEnd = t_inst->op_end(); op != opEnd; ++op) {
+ //    Value *operand = *op;
+ //    if(operand->hasName()) {
+ //      errs()<<"            "<<operand->getName()<<"\n";
+ //    }
+ //    else {
+ //      errs()<<"            ";
+ //      operand->print(errs());
+ //      errs()<<"\n";
+ //    }
+ //    Instruction* tempInst = dyn_cast<Instruction>(*op);
+ //    if(tempInst) {
+ //      cout<<"            "<<"This op is Instruction type."<<endl;
+ //    }
+ //    else {
+ //      cout<<"            "<<"This op is not Instruction type."<<endl;
+ //    }
+ //  }
+   //
+
+   // type 1
+   if(t_inst == &(t_bb->front())) {
+     if (CGRA_LOG_ENABLED(LOG_DFG, LOG_DEBUG)) errs()<<"│   │   ├── Type: first inst of a BB.\n";
+     if (CGRA_LOG_ENABLED(LOG_DFG, LOG_DEBUG)) errs()<<"│   │   ├── ctrl flow point to: "<<*t_inst<<"; In BB: "<<t_bb->getName().str()<<"\n";
+     return true;
+   }
+
+   // type 2 & 3
+   bool isLonelyInst = true;
+   bool isUsingIntraIterationData = false;
+   for (Instruction::op_iterator op = t_inst->op_begin(), opEnd = t_inst->op_end(); op != opEnd; ++op) {
+     if(isa<Instruction>(*op)) {
+       Instruction* tempInst = dyn_cast<Instruction>(*op);
+       isLonelyInst = false;
+       if(containsInst(t_bb, tempInst) and (getNode(tempInst)->getID() < getNode(t_inst)->getID())) {
+         isUsingIntraIterationData = true;
+       }
+     }
+   }
+   if(isLonelyInst) {
+     if (CGRA_LOG_ENABLED(LOG_DFG, LOG_DEBUG)) errs()<<"│   │   ├── Type: lonely inst.\n";
+     if (CGRA_LOG_ENABLED(LOG_DFG, LOG_DEBUG)) errs()<<"│   │   ├── ctrl flow point to: "<<*t_inst<<"; In BB: "<<t_bb->getName().str()<<"\n";
+     return true;
+   }
+   else if(!isUsingIntraIterationData) {
+     if (CGRA_LOG_ENABLED(LOG_DFG, LOG_DEBUG)) errs()<<"│   │   ├── Type: inst without [intra-basicblock & intra-iteration data flow] nor [ctrl flow] pointed to it.\n";
+     if (CGRA_LOG_ENABLED(LOG_DFG, LOG_DEBUG)) errs()<<"│   │   ├── ctrl flow point to: "<<*t_inst<<"; In BB: "<<t_bb->getName().str()<<"\n";
+     return true;
+   }
+
+   return false;
+ }
+
+bool DFG::containsInst(BasicBlock* t_bb, Instruction* t_inst) {
+  return t_inst->getParent() == t_bb;
+}
+
+int DFG::getInstID(BasicBlock* t_bb, Instruction* t_inst) {
+
+  int id = 0;
+  for (BasicBlock::iterator II=t_bb->begin(),
+       IEnd=t_bb->end(); II!=IEnd; ++II) {
+    Instruction* inst = &*II;
+    if ((inst) == (t_inst)) {
+      return id;
+    }
+    id += 1;
+  }
+  // This never gonna happen.
+  assert(false);
+  return -1;
+}
+
+DFGNode* DFG::getNode(Instruction* t_value) {
+  unordered_map<Instruction*, DFGNode*>::iterator it = m_nodeIndex.find(t_value);
+  if (it != m_nodeIndex.end()) {
+    return it->second;
+  }
+  assert("ERROR cannot find the corresponding DFG node.");
+  return NULL;
+}
+
+bool DFG::hasNode(Instruction* t_value) {
+  return m_nodeIndex.find(t_value) != m_nodeIndex.end();
+}
+
+string DFG::changeIns2Str(Instruction* t_ins) {
+  string temp_str;
+  raw_string_ostream os(temp_str);
+  t_ins->print(os);
+  return os.str();
+}
+
+//get value's name or inst's content
+string DFG::getValueName(Instruction* t_value) {
+  string temp_result = "val";
+  if (t_value->getName().empty()) {
+    temp_result += to_string(m_num);
+    m_num++;
+  }
+  else {
+    temp_result = t_value->getName().str();
+  }
+//  cout << "" << temp_result;
+  return temp_result;
+}
+
+// This is necessary to handle the control flow.
+// Each one would have their own implementation about control
+// flow handling. We simply connect 'br' to the entry ('phi')
+// of the corresponding basic blocks (w/o including additional
+// DFG nodes).
+void DFG::tuneForBranch() {
+  list<DFGNode*> processedDFGBrNodes;
+  list<DFGEdge*> replaceDFGEdges;
+  list<DFGEdge*> newBrDFGEdges;
+  int newDFGEdgeID = m_DFGEdges.size();
+  for (DFGEdge* dfgEdge: m_ctrlEdges) {
+    DFGNode* left = dfgEdge->getSrc();
+    DFGNode* right = dfgEdge->getDst();
+    assert(left->isBranch());
+    assert(right->isPhi());
+    if (find(processedDFGBrNodes.begin(), processedDFGBrNodes.end(), left) ==
+        processedDFGBrNodes.end()) {
+      processedDFGBrNodes.push_back(left);
+    } else {
+      DFGNode* newDFGBrNode = new DFGNode(nodes.size(), m_precisionAware, left->getInst(),
+          getValueName(left->getInst()), m_supportDVFS);
+      for (DFGNode* predDFGNode: *(left->getPredNodes())) {
+        DFGEdge* newDFGBrEdge = new DFGEdge(newDFGEdgeID++,
+            predDFGNode, newDFGBrNode);
+        addDFGEdge(newDFGBrEdge);
+      }
+      appendNode(newDFGBrNode);
+      left = newDFGBrNode;
+    }
+    list<DFGNode*>* predNodes = right->getPredNodes();
+    for (DFGNode* predNode: *predNodes) {
+      DFGEdge* replaceDFGEdge = getDFGEdge(predNode, right);
+      DFGEdge* brDataDFGEdge = new DFGEdge(replaceDFGEdge->getID(), predNode, left);
+      DFGEdge* brCtrlDFGEdge = new DFGEdge(newDFGEdgeID++, left, right);
+      // FIXME: Only consider one predecessor for 'phi' node for now.
+      //        Need to care about true/false and make proper connection.
+      replaceDFGEdges.push_back(replaceDFGEdge);
+      newBrDFGEdges.push_back(brDataDFGEdge);
+      newBrDFGEdges.push_back(brCtrlDFGEdge);
+      break;
+    }
+  }
+  for (DFGEdge* dfgEdge: replaceDFGEdges) {
+    removeDFGEdge(dfgEdge);
+  }
+  for (DFGEdge* dfgEdge: newBrDFGEdges) {
+    addDFGEdge(dfgEdge);
+  }
+
+  connectDFGNodes();
+//    DFGEdge* brCtrlDFGEdge = new DFGEdge(m_DFGEdges.size(), left, right);
+//    DFGEdge* replaceDFGEdge;
+//    for (list<DFGNode*>::iterator predNodeItr=predNodes->begin();
+//        predNodeItr!=predNodes->end(); ++predNodeItr) {
+//      DFGNode* predNode = *predNodeItr;
+//      list<DFGNode*>* visitedNodes = new list<DFGNode*>();
+//      // Found one predNode is one the same control/data path as the 'br'.
+//      if (searchDFS(left, predNode, visitedNodes)) {
+//        replaceDFGEdge = getDFGEdge(predNode, right);
+//        DFGEdge* brDataDFGEdge = new DFGEdge(replaceDFGEdge->getID(), predNode, left);
+//        m_DFGEdges.remove(replaceDFGEdge);
+//        m_DFGEdges.push_back(brDataDFGEdge);
+//        break;
+//      }
+//    }
+//    m_DFGEdges.push_back(brCtrlDFGEdge);
+//  }
+}
+
+string initOpcodeNameHelper(Instruction* inst) {
+  // For a vectorized multiplication, getOpcodeName() in LLVM will return "mul", not "vmul".
+  // In LLVM Intermediate Representation (IR), the same opcode is used for both scalar
+  // and vector operations. So we explicitly add "v" as prefix inside
+  // getOpcodeName().
+  unsigned opcode = inst->getOpcode();
+  opcode -= testing_opcode_offset;
+  if (opcode == Instruction::Mul) return "mul";
+  if (opcode == Instruction::FMul) return "fmul";
+  if (opcode == Instruction::Add) return "add";
+  if (opcode == Instruction::FAdd) return "fadd";
+  if (opcode == Instruction::Sub) return "sub";
+  if (opcode == Instruction::FSub) return "fsub";
+  if (opcode == Instruction::Xor) return "xor";
+  if (opcode == Instruction::Or) return "or";
+  if (opcode == Instruction::And) return "and";
+  if (opcode == Instruction::SDiv) return "sdiv";
+  if (opcode == Instruction::UDiv) return "udiv";
+  if (opcode == Instruction::SRem) return "srem";
+  if (opcode == Instruction::URem) return "urem";
+  if (opcode == Instruction::Trunc) return "trunc";
+  if (opcode == Instruction::ZExt) return "zext";
+  if (opcode == Instruction::SExt) return "sext";
+  if (opcode == Instruction::LShr) return "lshr";
+  if (opcode == Instruction::AShr) return "ashr";
+  if (opcode == Instruction::Load) return "load";
+  if (opcode == Instruction::Store) return "store";
+  if (opcode == Instruction::Br) return "br";
+  if (opcode == Instruction::PHI) return "phi";
+  if (opcode == Instruction::ICmp) return "icmp";
+  if (opcode == Instruction::FCmp) return "fcmp";
+  if (opcode == Instruction::BitCast) return "bitcast";
+  if (opcode == Instruction::GetElementPtr) return "getelementptr";
+  if (opcode == Instruction::Select) return "select";
+  if (opcode == Instruction::ExtractElement) return "extractelement";
+  if (opcode == Instruction::Call) return "call";
+
+  return "unknown";
+}
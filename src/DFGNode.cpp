@@ -9,24 +9,26 @@
  */
 
 #include "DFGNode.h"
-#include "llvm/Demangle/Demangle.h"
-
-int testing_opcode_offset = 0;
-string initOpcodeNameHelper(Instruction* inst);
-
-DFGNode::DFGNode(int t_id, bool t_precisionAware, Instruction* t_inst,
-                 StringRef t_stringRef, bool t_supportDVFS) {
+#include "Log.h"
+#include <algorithm>
+#include <assert.h>
+#include <map>
+
+// The node of an operation without any instruction, see the one from an
+// instruction in DFGLLVM.cpp.
+DFGNode::DFGNode(int t_id, bool t_precisionAware, string t_opcodeName,
+                 bool t_vectorized, string t_calleeName, string t_valueName,
+                 bool t_supportDVFS) {
   m_id = t_id;
   m_precisionAware = t_precisionAware;
-  m_inst = t_inst;
-  m_stringRef = t_stringRef;
+  m_inst = NULL;
+  m_valueName = t_valueName;
   m_predNodes = NULL;
   m_succNodes = NULL;
-  if (testing_opcode_offset == 0) {
-    m_opcodeName = t_inst->getOpcodeName();
-  } else {
-    m_opcodeName = initOpcodeNameHelper(t_inst);
-  }
+  m_opcodeName = t_opcodeName;
+  m_vectorized = t_vectorized;
+  m_constantAddSub = false;
+  m_calleeName = t_calleeName;
   m_isMapped = false;
   m_numConst = 0;
   m_optType = "";
@@ -43,9 +45,11 @@ DFGNode::DFGNode(int t_id, bool t_precisionAware, Instruction* t_inst,
   m_predicatees = NULL;
   m_isPredicater = false;
   m_patternNodes = new list<DFGNode*>();
+  classify();
   initType();
   m_supportDVFS = t_supportDVFS;
   m_DVFSLatencyMultiple = 1;
+  m_bbID = -1;
   // if (isMul()) {
   // if (!isPhi() and !isCmp() and !isScalarAdd() and !isBranch()) {
   //   m_DVFSLatencyMultiple = 2;
@@ -57,7 +61,8 @@ DFGNode::DFGNode(int t_id, DFGNode* old_node) {
   m_id = t_id;
   m_precisionAware = old_node->m_precisionAware;
   m_inst = old_node->m_inst;
-  m_stringRef = old_node->m_stringRef;
+  m_valueName = old_node->m_valueName;
+  m_instText = old_node->m_instText;
   m_predNodes = new list<DFGNode*>();
   for (DFGNode* predNode: *old_node->getPredNodes()) {
     m_predNodes->push_back(predNode);
@@ -67,6 +72,11 @@ DFGNode::DFGNode(int t_id, DFGNode* old_node) {
     m_succNodes->push_back(succNode);
   }
   m_opcodeName = old_node->m_opcodeName;
+  m_vectorized = old_node->m_vectorized;
+  m_constantAddSub = old_node->m_constantAddSub;
+  m_calleeName = old_node->m_calleeName;
+  m_optClasses = old_node->m_optClasses;
+  m_displayName = old_node->m_displayName;
   m_isMapped = old_node->m_isMapped;
   m_numConst = old_node->m_numConst;
   m_optType = old_node->m_optType;
@@ -84,8 +94,10 @@ DFGNode::DFGNode(int t_id, DFGNode* old_node) {
   m_isPredicater = old_node->m_isPredicater;
   m_patternNodes = old_node->m_patternNodes;
   m_fuType = old_node->m_fuType;
+  m_fuTypeID = old_node->m_fuTypeID;
   m_supportDVFS = old_node->m_supportDVFS;
   m_DVFSLatencyMultiple = old_node->m_DVFSLatencyMultiple;
+  m_bbID = old_node->m_bbID;
 }
 
 int DFGNode::getID() {
@@ -121,7 +133,7 @@ bool DFGNode::shareSameCycle(DFGNode* t_node) {
   for (int cycleID: *m_cycleID) {
     bool found = (find(my_list->begin(), my_list->end(), cycleID) != my_list->end());
     if (found) {
-      cout<<"[DEBUG] in shareSameCycle is true: node "<<t_node->getID()<<endl;
+      CGRA_LOG(LOG_DFG, LOG_DEBUG)<<"[DEBUG] in shareSameCycle is true: node "<<t_node->getID()<<"\n";
       return true;
     }
   }
@@ -153,6 +165,14 @@ void DFGNode::addPredicatee(DFGNode* t_node) {
   t_node->setPredicatee();
 }
 
+void DFGNode::setPredicatees(list<DFGNode*>* t_nodes) {
+  m_isPredicater = !t_nodes->empty();
+  m_predicatees = t_nodes;
+  for (DFGNode* node: *t_nodes) {
+    node->setPredicatee();
+  }
+}
+
 list<DFGNode*>* DFGNode::getPredicatees() {
   return m_predicatees;
 }
@@ -169,55 +189,59 @@ void DFGNode::clearMapped() {
   m_isMapped = false;
 }
 
-Instruction* DFGNode::getInst() {
+llvm::Instruction* DFGNode::getInst() {
   return m_inst;
 }
 
-StringRef DFGNode::getStringRef() {
-  return m_stringRef;
+string DFGNode::getValueName() {
+  return m_valueName;
+}
+
+void DFGNode::setInstText(string t_instText) {
+  m_instText = t_instText;
+}
+
+string DFGNode::getCalleeName() {
+  return m_calleeName;
+}
+
+// Falls back on the opcode for the nodes without any instruction.
+const string& DFGNode::getInstText() {
+  return m_instText.empty() ? m_displayName : m_instText;
 }
 
 string DFGNode::isCall() {
-  string op = getOpcodeName();
-  if (m_opcodeName.compare("call") != 0 || isVectorized() )
+  if (!(m_optClasses & DFG_OPT_CALL))
     return "None";
-  return op;
+  return m_displayName;
+}
+
+bool DFGNode::isCallOpt() {
+  return m_optClasses & DFG_OPT_CALL;
 }
 
 bool DFGNode::isVectorized() {
-  // TODO: need a more robust way to recognize vectorized instructions.
-  Value* psVal = cast<Value>(m_inst);
-  return psVal->getType()->isVectorTy();
+  return m_optClasses & DFG_OPT_VECTORIZED;
 }
 
 bool DFGNode::isLoad() {
-  if (m_opcodeName.compare("load") == 0)
-    return true;
-  return false;
+  return m_optClasses & DFG_OPT_LOAD;
 }
 
 bool DFGNode::isReturn() {
-  if (m_opcodeName.compare("ret") == 0)
-    return true;
-  return false;
+  return m_optClasses & DFG_OPT_RETURN;
 }
 
 bool DFGNode::isStore() {
-  if (m_opcodeName.compare("store") == 0)
-    return true;
-  return false;
+  return m_optClasses & DFG_OPT_STORE;
 }
 
 bool DFGNode::isBranch() {
-  if (m_opcodeName.compare("br") == 0)
-    return true;
-  return false;
+  return m_optClasses & DFG_OPT_BRANCH;
 }
 
 bool DFGNode::isPhi() {
-  if (m_opcodeName.compare("phi") == 0)
-    return true;
-  return false;
+  return m_optClasses & DFG_OPT_PHI;
 }
 
 bool DFGNode::isOpt(string t_opt) {
@@ -227,102 +251,107 @@ bool DFGNode::isOpt(string t_opt) {
 }
 
 bool DFGNode::isMul() {
-  if (m_opcodeName.compare("fmul") == 0 or
-      m_opcodeName.compare("mul") == 0)
-    return true;
-  return false;
+  return m_optClasses & DFG_OPT_MUL;
 }
 
 bool DFGNode::isAddSub() {
-  if (m_opcodeName.compare("getelementptr") == 0 or
-      m_opcodeName.compare("add") == 0  or
-      m_opcodeName.compare("fadd") == 0 or
-      m_opcodeName.compare("sub") == 0  or
-      m_opcodeName.compare("fsub") == 0) {
-    return true;
-  }
-  return false;
+  return m_optClasses & DFG_OPT_ADDSUB;
 }
 
 // Only detect integer addition.
 bool DFGNode::isIaddIsub() {
-  if (m_opcodeName.compare("getelementptr") == 0 or
-      m_opcodeName.compare("add") == 0  or
-      m_opcodeName.compare("sub") == 0) {
-    return true;
-  }
-  return false;
+  return m_optClasses & DFG_OPT_IADD_ISUB;
 }
 
 // Checks whether the operation is a scalar addition.
 bool DFGNode::isScalarAddSub() {
-  if (m_opcodeName.compare("add") == 0 or
-      m_opcodeName.compare("sub") == 0)
-    return true;
-  return false;
+  return m_optClasses & DFG_OPT_SCALAR_ADDSUB;
 }
 
 bool DFGNode::isConstantAddSub() {
-  if (auto* addInst = dyn_cast<BinaryOperator>(m_inst)) {
-      if (addInst->getOpcode() == Instruction::Add) {
-          Value* op1 = addInst->getOperand(0);
-          Value* op2 = addInst->getOperand(1);
-          return isa<ConstantInt>(op1) || isa<ConstantInt>(op2);
-      }
-  }
-  return false;
+  return m_constantAddSub;
+}
+
+void DFGNode::setConstantAddSub() {
+  m_constantAddSub = true;
 }
 
 bool DFGNode::isCmp() {
-  if (m_opcodeName.compare("icmp") == 0 or m_opcodeName.compare("cmp") == 0)
-    return true;
-  return false;
+  return m_optClasses & DFG_OPT_CMP;
 }
 
 bool DFGNode::isBitcast() {
-  if (m_opcodeName.compare("bitcast") == 0)
-    return true;
-  return false;
+  return m_optClasses & DFG_OPT_BITCAST;
 }
 
 bool DFGNode::isGetptr() {
-  if (m_opcodeName.compare("getelementptr") == 0)
-    return true;
-  return false;
+  return m_optClasses & DFG_OPT_GETPTR;
 }
 
 bool DFGNode::isSel() {
-  if (m_opcodeName.compare("select") == 0)
-    return true;
-  return false;
+  return m_optClasses & DFG_OPT_SEL;
 }
 
 bool DFGNode::isMAC() {
-  if (m_opcodeName.compare("mulgetelementptr") == 0 or
-      m_opcodeName.compare("muladd") == 0  or
-      m_opcodeName.compare("mulfadd") == 0 or
-      m_opcodeName.compare("mulsub") == 0  or
-      m_opcodeName.compare("mulfsub") == 0  or
-      m_opcodeName.compare("fmulgetelementptr") == 0 or
-      m_opcodeName.compare("fmuladd") == 0  or
-      m_opcodeName.compare("fmulfadd") == 0 or
-      m_opcodeName.compare("fmulsub") == 0  or
-      m_opcodeName.compare("fmulfsub") == 0)
-    return true;
-  return false;
+  return m_optClasses & DFG_OPT_MAC;
 }
 
 bool DFGNode::isLogic() {
-  if (m_opcodeName.compare("or") == 0 or m_opcodeName.compare("and") == 0)
-    return true;
-  return false;
+  return m_optClasses & DFG_OPT_LOGIC;
 }
 
 // Divison can also be a special operation.
 bool DFGNode::isDiv() {
-  if (m_opcodeName.compare("fdiv") == 0 or m_opcodeName.compare("div") == 0)
-    return true;
-  return false;
+  return m_optClasses & DFG_OPT_DIV;
+}
+
+// Classifies the node based on its opcode name, which changes only when the
+// node is constructed or becomes the root of a fused pattern.
+void DFGNode::classify() {
+  static const map<string, unsigned> optClassesOfOpcode = {
+    {"load",              DFG_OPT_LOAD},
+    {"store",             DFG_OPT_STORE},
+    {"ret",               DFG_OPT_RETURN},
+    {"br",                DFG_OPT_BRANCH},
+    {"phi",               DFG_OPT_PHI},
+    {"getelementptr",     DFG_OPT_ADDSUB | DFG_OPT_IADD_ISUB | DFG_OPT_GETPTR},
+    {"add",               DFG_OPT_ADDSUB | DFG_OPT_IADD_ISUB | DFG_OPT_SCALAR_ADDSUB},
+    {"sub",               DFG_OPT_ADDSUB | DFG_OPT_IADD_ISUB | DFG_OPT_SCALAR_ADDSUB},
+    {"fadd",              DFG_OPT_ADDSUB},
+    {"fsub",              DFG_OPT_ADDSUB},
+    {"mul",               DFG_OPT_MUL},
+    {"fmul",              DFG_OPT_MUL},
+    {"icmp",              DFG_OPT_CMP},
+    {"cmp",               DFG_OPT_CMP},
+    {"bitcast",           DFG_OPT_BITCAST},
+    {"select",            DFG_OPT_SEL},
+    {"mulgetelementptr",  DFG_OPT_MAC},
+    {"muladd",            DFG_OPT_MAC},
+    {"mulfadd",           DFG_OPT_MAC},
+    {"mulsub",            DFG_OPT_MAC},
+    {"mulfsub",           DFG_OPT_MAC},
+    {"fmulgetelementptr", DFG_OPT_MAC},
+    {"fmuladd",           DFG_OPT_MAC},
+    {"fmulfadd",          DFG_OPT_MAC},
+    {"fmulsub",           DFG_OPT_MAC},
+    {"fmulfsub",          DFG_OPT_MAC},
+    {"or",                DFG_OPT_LOGIC},
+    {"and",               DFG_OPT_LOGIC},
+    {"fdiv",              DFG_OPT_DIV},
+    {"div",               DFG_OPT_DIV}
+  };
+  m_optClasses = 0;
+  map<string, unsigned>::const_iterator it = optClassesOfOpcode.find(m_opcodeName);
+  if (it != optClassesOfOpcode.end()) {
+    m_optClasses = it->second;
+  }
+  // TODO: need a more robust way to recognize vectorized instructions.
+  if (m_vectorized) {
+    m_optClasses |= DFG_OPT_VECTORIZED;
+  } else if (m_opcodeName.compare("call") == 0) {
+    m_optClasses |= DFG_OPT_CALL;
+  }
+  m_displayName = initDisplayName();
 }
 
 // used for specialized fusion (e.g. alu+mul and icmp+br can be regared as two kinds of complex nodes, so there are different tiles to support them)
@@ -350,6 +379,14 @@ void DFGNode::addPatternPartner(DFGNode* t_patternNode) {
   m_patternNodes->push_back(t_patternNode);
   t_patternNode->setPatternRoot(this);
   m_opcodeName += t_patternNode->getOpcodeName();
+  classify();
+}
+
+void DFGNode::linkPatternPartner(DFGNode* t_patternNode) {
+  m_isPatternRoot = true;
+  m_patternRoot = this;
+  m_patternNodes->push_back(t_patternNode);
+  t_patternNode->setPatternRoot(this);
 }
 
 list<DFGNode*>* DFGNode::getPatternNodes() {
@@ -368,7 +405,15 @@ bool DFGNode::isPatternRoot() {
   return m_isPatternRoot;
 }
 
-string DFGNode::getOpcodeName() {
+const string& DFGNode::getOpcodeName() {
+  return m_displayName;
+}
+
+const string& DFGNode::getRawOpcodeName() {
+  return m_opcodeName;
+}
+
+string DFGNode::initDisplayName() {
   // For a vectorized multiplication, getOpcodeName() in LLVM will return "mul", not "vmul".
   // In LLVM Intermediate Representation (IR), the same opcode is used for both scalar
   // and vector operations. So we explicitly add "v" as prefix inside
@@ -387,33 +432,10 @@ string DFGNode::getOpcodeName() {
       result = "cmp";
     } else if (m_opcodeName.compare("fdiv") == 0) {
       result = "div";
-    } else if (m_opcodeName.compare("call") == 0 && isVectorized()) {
-
-      Function *func = ((CallInst*)m_inst)->getCalledFunction();
-      if (func) {
-        string newName = func->getName().str();
-        string removingPattern = "llvm.vector.";
-        int pos = newName.find(removingPattern);
-        if (pos == -1)
-        pos = newName.find("llvm.");
-	      newName.erase(pos, removingPattern.length());
-        string delimiter = ".v";
-        newName = newName.substr(0, newName.find(delimiter));
-	      replace(newName.begin(), newName.end(), '.', '_');
-        return newName;
-      }
-      else
-        return "indirect call";
     }
-    // for the special operations
+    // for the special operations, named after the called function
     else if (m_opcodeName.compare("call") == 0) {
-      Function *func = ((CallInst*)m_inst)->getCalledFunction();
-      if (func) {
-        string newName = func->getName().str();
-        newName = demangle(newName);
-        return newName.substr(0, newName.find("("));
-      }
-      else return "indirect call";
+      return m_calleeName;
     }
   }
 
@@ -432,6 +454,10 @@ string DFGNode::getFuType() {
   return m_fuType;
 }
 
+string DFGNode::getOptType() {
+  return m_optType;
+}
+
 string DFGNode::getJSONOpt() {
 
   int numPred = 0;
@@ -480,6 +506,10 @@ int DFGNode::getExecLatency(int t_TileDVFSLatencyMultiple) {
   return m_execLatency;
 }
 
+int DFGNode::getRawExecLatency() {
+  return m_execLatency;
+}
+
 bool DFGNode::isMultiCycleExec(int t_DVFSLatencyMultiple) {
   if (m_supportDVFS and t_DVFSLatencyMultiple > 1) {
     return true;
@@ -500,10 +530,7 @@ bool DFGNode::isPipelinable() {
 }
 
 bool DFGNode::shareFU(DFGNode* t_dfgNode) {
-  if (t_dfgNode->getFuType().compare(m_fuType) == 0) {
-    return true;
-  }
-  return false;
+  return t_dfgNode->m_fuTypeID == m_fuTypeID;
 }
 
 void DFGNode::initType() {
@@ -614,6 +641,20 @@ void DFGNode::initType() {
     // printf("Fu Type:  \n");
     // cout << m_fuType << endl;
   }
+  setTypes(m_optType, m_fuType);
+}
+
+void DFGNode::setTypes(string t_optType, string t_fuType) {
+  m_optType = t_optType;
+  m_fuType = t_fuType;
+  // Interns the FU type so that shareFU() compares integers. The DFG is
+  // constructed before mapping, i.e., never concurrently.
+  static map<string, int> fuTypeIDs;
+  if (fuTypeIDs.find(m_fuType) == fuTypeIDs.end()) {
+    int fuTypeID = fuTypeIDs.size();
+    fuTypeIDs[m_fuType] = fuTypeID;
+  }
+  m_fuTypeID = fuTypeIDs[m_fuType];
 }
 
 list<DFGNode*>* DFGNode::getPredNodes() {
@@ -684,6 +725,22 @@ void DFGNode::addPredNode(DFGNode* node) {
   getPredNodes()->push_back(node);
 }
 
+void DFGNode::setPredNodes(list<DFGNode*>* t_nodes) {
+  m_predNodes = t_nodes;
+}
+
+void DFGNode::setSuccNodes(list<DFGNode*>* t_nodes) {
+  m_succNodes = t_nodes;
+}
+
+list<DFGEdge*>* DFGNode::getInEdges() {
+  return &m_inEdges;
+}
+
+list<DFGEdge*>* DFGNode::getOutEdges() {
+  return &m_outEdges;
+}
+
 void DFGNode::setInEdge(DFGEdge* t_dfgEdge) {
   if (find(m_inEdges.begin(), m_inEdges.end(), t_dfgEdge) ==
       m_inEdges.end())
@@ -740,46 +797,6 @@ int DFGNode::getNumConst() {
   return m_numConst;
 }
 
-string initOpcodeNameHelper(Instruction* inst) {
-  // For a vectorized multiplication, getOpcodeName() in LLVM will return "mul", not "vmul".
-  // In LLVM Intermediate Representation (IR), the same opcode is used for both scalar
-  // and vector operations. So we explicitly add "v" as prefix inside
-  // getOpcodeName().
-  unsigned opcode = inst->getOpcode();
-  opcode -= testing_opcode_offset;
-  if (opcode == Instruction::Mul) return "mul";
-  if (opcode == Instruction::FMul) return "fmul";
-  if (opcode == Instruction::Add) return "add";
-  if (opcode == Instruction::FAdd) return "fadd";
-  if (opcode == Instruction::Sub) return "sub";
-  if (opcode == Instruction::FSub) return "fsub";
-  if (opcode == Instruction::Xor) return "xor";
-  if (opcode == Instruction::Or) return "or";
-  if (opcode == Instruction::And) return "and";
-  if (opcode == Instruction::SDiv) return "sdiv";
-  if (opcode == Instruction::UDiv) return "udiv";
-  if (opcode == Instruction::SRem) return "srem";
-  if (opcode == Instruction::URem) return "urem";
-  if (opcode == Instruction::Trunc) return "trunc";
-  if (opcode == Instruction::ZExt) return "zext";
-  if (opcode == Instruction::SExt) return "sext";
-  if (opcode == Instruction::LShr) return "lshr";
-  if (opcode == Instruction::AShr) return "ashr";
-  if (opcode == Instruction::Load) return "load";
-  if (opcode == Instruction::Store) return "store";
-  if (opcode == Instruction::Br) return "br";
-  if (opcode == Instruction::PHI) return "phi";
-  if (opcode == Instruction::ICmp) return "icmp";
-  if (opcode == Instruction::FCmp) return "fcmp";
-  if (opcode == Instruction::BitCast) return "bitcast";
-  if (opcode == Instruction::GetElementPtr) return "getelementptr";
-  if (opcode == Instruction::Select) return "select";
-  if (opcode == Instruction::ExtractElement) return "extractelement";
-  if (opcode == Instruction::Call) return "call";
-
-  return "unknown";
-}
-
 void DFGNode::setBBID(int t_bbID) {
   m_bbID = t_bbID;
 }
@@ -11,13 +11,6 @@
 #ifndef DFGNode_H
 #define DFGNode_H
 
-#include <llvm/IR/Value.h>
-#include <llvm/IR/Constants.h>
-#include <llvm/IR/Instruction.h>
-#include <llvm/IR/Instructions.h>
-#include <llvm/Support/raw_ostream.h>
-#include <llvm/IR/BasicBlock.h>
-
 #include <string>
 #include <list>
 #include <stdio.h>
@@ -26,9 +19,37 @@
 #include "DFGEdge.h"
 #define MAXIMUM_COMBINED_TYPE 100
 
-using namespace llvm;
+// Operation classes of a DFG node, classified once its opcode name is
+// settled (see DFGNode::classify()), so that the checks on the hot paths
+// (canSupport(), canOccupy(), the cost model) are plain bit tests.
+#define DFG_OPT_LOAD           (1u << 0)
+#define DFG_OPT_STORE          (1u << 1)
+#define DFG_OPT_RETURN         (1u << 2)
+#define DFG_OPT_CALL           (1u << 3)
+#define DFG_OPT_BRANCH         (1u << 4)
+#define DFG_OPT_PHI            (1u << 5)
+#define DFG_OPT_ADDSUB         (1u << 6)
+#define DFG_OPT_SCALAR_ADDSUB  (1u << 7)
+#define DFG_OPT_IADD_ISUB      (1u << 8)
+#define DFG_OPT_MUL            (1u << 9)
+#define DFG_OPT_CMP            (1u << 10)
+#define DFG_OPT_BITCAST        (1u << 11)
+#define DFG_OPT_GETPTR         (1u << 12)
+#define DFG_OPT_SEL            (1u << 13)
+#define DFG_OPT_MAC            (1u << 14)
+#define DFG_OPT_LOGIC          (1u << 15)
+#define DFG_OPT_DIV            (1u << 16)
+#define DFG_OPT_VECTORIZED     (1u << 17)
+
 using namespace std;
 
+// The DFG nodes built from the LLVM IR keep their instruction, the ones
+// read from a file (see DFG::loadDFG()) have none. The mapping never
+// needs the instruction.
+namespace llvm {
+  class Instruction;
+}
+
 class DFGEdge;
 
 class DFGNode {
@@ -37,10 +58,21 @@ class DFGNode {
     // CPU/IR execution sequential ordering).
     int m_id;
     bool m_precisionAware;
-    Instruction* m_inst;
-    Value* m_value;
-    StringRef m_stringRef;
+    llvm::Instruction* m_inst;
+    string m_valueName;
+    // The instruction as printed for the debug messages, if enabled.
+    string m_instText;
     string m_opcodeName;
+    // Derived from the instruction: whether it yields a vector, whether it
+    // is an add with a constant operand, and the name of the called
+    // function (only for the calls of a precision-unaware DFG).
+    bool m_vectorized;
+    bool m_constantAddSub;
+    string m_calleeName;
+    // Derived from m_opcodeName by classify(), the names are only kept
+    // for the output.
+    unsigned m_optClasses;
+    string m_displayName;
     // m_pathName is derived from basic block of llvm
     string m_pathName;  
     list<DFGEdge*> m_inEdges;
@@ -53,6 +85,8 @@ class DFGNode {
     int m_numConst;
     string m_optType;
     string m_fuType;
+    // Interned m_fuType, compared by shareFU().
+    int m_fuTypeID;
     bool m_combined;
     // Used for specialized fusion (e.g. alu+mul and icmp+br can be regared as two kinds of complex nodes, so there are different tiles to support them)
     string m_combinedtype;
@@ -67,7 +101,8 @@ class DFGNode {
     list<DFGNode*>* m_predicatees;
     bool m_isPredicater;
     DFGNode* m_patternRoot;
-    void setPatternRoot(DFGNode*);
+    void classify();
+    string initDisplayName();
 
     int m_DVFSLatencyMultiple;
     bool m_supportDVFS;
@@ -76,7 +111,9 @@ class DFGNode {
     int m_bbID;
 
   public:
-    DFGNode(int, bool, Instruction*, StringRef, bool);
+    // Defined along with the DFG construction from the LLVM IR.
+    DFGNode(int, bool, llvm::Instruction*, string, bool);
+    DFGNode(int, bool, string, bool, string, string, bool);
     DFGNode(int, DFGNode* old_node);
     int getID();
     void setID(int);
@@ -89,11 +126,13 @@ class DFGNode {
     bool isStore();
     bool isReturn();
     string isCall();
+    bool isCallOpt();
     bool isBranch();
     bool isPhi();
     bool isAddSub();
     bool isScalarAddSub();
     bool isConstantAddSub();
+    void setConstantAddSub();
     // Detect integer addition.
     bool isIaddIsub();
     bool isMul();
@@ -111,9 +150,18 @@ class DFGNode {
     bool hasCombined();
     void setCombine(string type="");
     void addPatternPartner(DFGNode*);
-    Instruction* getInst();
-    StringRef getStringRef();
-    string getOpcodeName();
+    // Links the partner of a fused node read from a file, whose opcode
+    // already stands for the whole pattern.
+    void linkPatternPartner(DFGNode*);
+    llvm::Instruction* getInst();
+    string getValueName();
+    const string& getInstText();
+    void setInstText(string);
+    string getCalleeName();
+    const string& getOpcodeName();
+    // The opcode the node is classified by, e.g., "fadd" for the "add"
+    // shown by a precision-unaware DFG.
+    const string& getRawOpcodeName();
     string getPathName();
     list<DFGNode*>* getPredNodes();
     list<DFGNode*>* getSuccNodes();
@@ -126,17 +174,30 @@ class DFGNode {
     bool isSuccessorOf(DFGNode*);
     bool isPredecessorOf(DFGNode*);
     bool isOneOfThem(list<DFGNode*>*);
+    // Restores the predecessors/successors as they were, e.g., the ones
+    // read from a file, instead of deriving them from the edges.
+    void setPredNodes(list<DFGNode*>*);
+    void setSuccNodes(list<DFGNode*>*);
+    list<DFGEdge*>* getInEdges();
+    list<DFGEdge*>* getOutEdges();
     void setInEdge(DFGEdge*);
     void setOutEdge(DFGEdge*);
     void cutEdges();
+    // The operation type, and the one shown in the JSON (i.e., with the
+    // "_CONST" suffix if it takes a constant).
+    string getOptType();
     string getJSONOpt();
     string getFuType();
+    // Overrides the types derived by initType(), e.g., of a fused node
+    // read from a file.
+    void setTypes(string, string);
     void addConst();
     void removeConst();
     int getNumConst();
     void initType();
     bool isPatternRoot();
     DFGNode* getPatternRoot();
+    void setPatternRoot(DFGNode*);
     list<DFGNode*>* getPatternNodes();
     void setCritical();
     void addCycleID(int);
@@ -144,6 +205,8 @@ class DFGNode {
     int getCycleID();
     list<int>* getCycleIDs();
     void addPredicatee(DFGNode*);
+    // Replaces the predicatees, e.g., with the ones read from a file.
+    void setPredicatees(list<DFGNode*>*);
     list<DFGNode*>* getPredicatees();
     void setPredicatee();
     bool isPredicatee();
@@ -152,6 +215,8 @@ class DFGNode {
     void setExecLatency(int);
     bool isMultiCycleExec(int);
     int getExecLatency(int);
+    // The latency set by setExecLatency(), regardless of the DVFS.
+    int getRawExecLatency();
     void setPipelinable();
     bool isPipelinable();
     bool shareFU(DFGNode*);
@@ -0,0 +1,160 @@
+/*
+ * ======================================================================
+ * DFGView.cpp
+ * ======================================================================
+ * Frozen adjacency snapshot of the DFG implementation.
+ *
+ * Date : October 16, 2026
+ */
+
+#include "DFGView.h"
+#include "DFG.h"
+#include "Log.h"
+
+DFGView::DFGView(DFG* t_dfg) {
+  m_dfg = t_dfg;
+  for (DFGNode* node: t_dfg->nodes) {
+    m_index[node] = m_nodes.size();
+    m_nodes.push_back(node);
+  }
+  int nodeCount = m_nodes.size();
+
+  m_predOffsets.push_back(0);
+  m_succOffsets.push_back(0);
+  int maxCycleID = -1;
+  for (DFGNode* node: m_nodes) {
+    for (DFGNode* pred: *(node->getPredNodes())) {
+      int index = getIndex(pred);
+      if (index != -1)
+        m_preds.push_back(index);
+    }
+    m_predOffsets.push_back(m_preds.size());
+    for (DFGNode* succ: *(node->getSuccNodes())) {
+      int index = getIndex(succ);
+      if (index != -1)
+        m_succs.push_back(index);
+    }
+    m_succOffsets.push_back(m_succs.size());
+    m_execLatency.push_back(
+        node->getExecLatency(node->getDVFSLatencyMultiple()));
+    m_pipelinable.push_back(node->isPipelinable());
+    m_critical.push_back(node->isCritical());
+    for (int cycleID: *(node->getCycleIDs())) {
+      if (cycleID > maxCycleID)
+        maxCycleID = cycleID;
+    }
+  }
+
+  m_cycleIDWords = (maxCycleID + 64) / 64;
+  m_cycleIDs.assign(nodeCount * m_cycleIDWords, 0);
+  for (int i=0; i<nodeCount; ++i) {
+    for (int cycleID: *(m_nodes[i]->getCycleIDs())) {
+      if (cycleID >= 0)
+        m_cycleIDs[i*m_cycleIDWords + cycleID/64] |= 1ULL << (cycleID%64);
+    }
+  }
+
+  list<list<DFGNode*>*>* cycles = t_dfg->getCycleLists();
+  m_cycleOffsets.push_back(0);
+  for (list<DFGNode*>* cycle: *cycles) {
+    for (DFGNode* node: *cycle) {
+      m_cycleNodes.push_back(getIndex(node));
+    }
+    m_cycleOffsets.push_back(m_cycleNodes.size());
+  }
+  int cycleCount = cycles->size();
+  m_cycleWords = (cycleCount + 63) / 64;
+  m_cycleMembership.assign(nodeCount * m_cycleWords, 0);
+  for (int c=0; c<cycleCount; ++c) {
+    for (int k=m_cycleOffsets[c]; k<m_cycleOffsets[c+1]; ++k) {
+      int index = m_cycleNodes[k];
+      if (index != -1)
+        m_cycleMembership[index*m_cycleWords + c/64] |= 1ULL << (c%64);
+    }
+  }
+}
+
+DFG* DFGView::getDFG() {
+  return m_dfg;
+}
+
+int DFGView::getNodeCount() {
+  return m_nodes.size();
+}
+
+DFGNode* DFGView::getNode(int t_index) {
+  return m_nodes[t_index];
+}
+
+int DFGView::getIndex(DFGNode* t_node) {
+  unordered_map<DFGNode*, int>::iterator it = m_index.find(t_node);
+  if (it == m_index.end())
+    return -1;
+  return it->second;
+}
+
+int DFGView::getPredCount(int t_index) {
+  return m_predOffsets[t_index+1] - m_predOffsets[t_index];
+}
+
+const int* DFGView::getPreds(int t_index) {
+  return m_preds.data() + m_predOffsets[t_index];
+}
+
+int DFGView::getSuccCount(int t_index) {
+  return m_succOffsets[t_index+1] - m_succOffsets[t_index];
+}
+
+const int* DFGView::getSuccs(int t_index) {
+  return m_succs.data() + m_succOffsets[t_index];
+}
+
+int DFGView::getExecLatency(int t_index) {
+  return m_execLatency[t_index];
+}
+
+bool DFGView::isPipelinable(int t_index) {
+  return m_pipelinable[t_index];
+}
+
+bool DFGView::isCritical(int t_index) {
+  return m_critical[t_index];
+}
+
+bool DFGView::shareSameCycle(int t_index, int t_other) {
+  const uint64_t* mine = m_cycleIDs.data() + t_index*m_cycleIDWords;
+  const uint64_t* theirs = m_cycleIDs.data() + t_other*m_cycleIDWords;
+  for (int w=0; w<m_cycleIDWords; ++w) {
+    if (mine[w] & theirs[w]) {
+      CGRA_LOG(LOG_DFG, LOG_DEBUG)<<"[DEBUG] in shareSameCycle is true: node "<<m_nodes[t_other]->getID()<<"\n";
+      return true;
+    }
+  }
+  return false;
+}
+
+int DFGView::getCycleCount() {
+  return m_cycleOffsets.size() - 1;
+}
+
+int DFGView::getCycleSize(int t_cycle) {
+  return m_cycleOffsets[t_cycle+1] - m_cycleOffsets[t_cycle];
+}
+
+const int* DFGView::getCycle(int t_cycle) {
+  return m_cycleNodes.data() + m_cycleOffsets[t_cycle];
+}
+
+void DFGView::getCommonCycles(int t_index, int t_other,
+    vector<int>* t_cycles) {
+  t_cycles->clear();
+  const uint64_t* mine = m_cycleMembership.data() + t_index*m_cycleWords;
+  const uint64_t* theirs = m_cycleMembership.data() + t_other*m_cycleWords;
+  for (int w=0; w<m_cycleWords; ++w) {
+    uint64_t common = mine[w] & theirs[w];
+    while (common != 0) {
+      t_cycles->push_back(w*64 + __builtin_ctzll(common));
+      common &= common - 1;
+    }
+  }
+}
@@ -0,0 +1,84 @@
+/*
+ * ======================================================================
+ * DFGView.h
+ * ======================================================================
+ * Frozen adjacency snapshot of the DFG header file.
+ *
+ * Date : October 16, 2026
+ */
+
+#ifndef DFGView_H
+#define DFGView_H
+
+#include <vector>
+#include <unordered_map>
+#include <stdint.h>
+
+using namespace std;
+
+class DFG;
+class DFGNode;
+
+// Read-only snapshot of the DFG taken once the fusion and the reordering
+// are done, i.e., right before mapping. The nodes get dense indices in the
+// mapping order, and their predecessors and successors are stored in the
+// compressed sparse row (CSR) form, so the mapper walks contiguous index
+// arrays rather than the lazily built node lists. The lists are forced
+// while building the snapshot, so the concurrent probes only ever read it.
+// Predecessors or successors that are no longer in the DFG are left out.
+class DFGView {
+  private:
+    DFG* m_dfg;
+    vector<DFGNode*> m_nodes;
+    unordered_map<DFGNode*, int> m_index;
+
+    vector<int> m_predOffsets;
+    vector<int> m_preds;
+    vector<int> m_succOffsets;
+    vector<int> m_succs;
+
+    vector<int> m_execLatency;
+    vector<bool> m_pipelinable;
+    vector<bool> m_critical;
+
+    // The IDs of the cycles recorded on each node (see
+    // DFGNode::getCycleIDs()), flattened as [node][word].
+    int m_cycleIDWords;
+    vector<uint64_t> m_cycleIDs;
+
+    // The cycles of DFG::getCycleLists() in CSR form (the nodes that are no
+    // longer in the DFG are kept as -1), and the cycles each node belongs
+    // to, flattened as [node][word].
+    vector<int> m_cycleOffsets;
+    vector<int> m_cycleNodes;
+    int m_cycleWords;
+    vector<uint64_t> m_cycleMembership;
+
+  public:
+    DFGView(DFG*);
+    DFG* getDFG();
+    int getNodeCount();
+    DFGNode* getNode(int);
+    // Returns -1 if the node is not in the snapshot.
+    int getIndex(DFGNode*);
+
+    int getPredCount(int);
+    const int* getPreds(int);
+    int getSuccCount(int);
+    const int* getSuccs(int);
+
+    int getExecLatency(int);
+    bool isPipelinable(int);
+    bool isCritical(int);
+    // Same as DFGNode::shareSameCycle() on the two nodes.
+    bool shareSameCycle(int, int);
+
+    int getCycleCount();
+    int getCycleSize(int);
+    const int* getCycle(int);
+    // Fills the cycles containing both nodes, in the order of
+    // DFG::getCycleLists().
+    void getCommonCycles(int, int, vector<int>*);
+};
+
+#endif
@@ -0,0 +1,94 @@
+/*
+ * ======================================================================
+ * Log.cpp
+ * ======================================================================
+ * Leveled logging per category implementation.
+ *
+ * Date : October 16, 2026
+ */
+
+#include "Log.h"
+#include <cstdlib>
+#include <sstream>
+
+// Everything is printed unless configured otherwise.
+int Log::s_thresholds[LOG_CATEGORY_COUNT] = {
+    LOG_TRACE, LOG_TRACE, LOG_TRACE, LOG_TRACE, LOG_TRACE};
+
+static const char* s_categoryNames[LOG_CATEGORY_COUNT] = {
+    "mapper", "route", "mrrg", "dfg", "dvfs"};
+
+static const char* s_levelNames[] = {"quiet", "info", "debug", "trace"};
+
+static bool parseLevel(string t_name, LogLevel* t_level) {
+  for (int i=LOG_QUIET; i<=LOG_TRACE; ++i) {
+    if (t_name == s_levelNames[i]) {
+      *t_level = (LogLevel)i;
+      return true;
+    }
+  }
+  return false;
+}
+
+static bool parseCategory(string t_name, LogCategory* t_category) {
+  for (int i=0; i<LOG_CATEGORY_COUNT; ++i) {
+    if (t_name == s_categoryNames[i]) {
+      *t_category = (LogCategory)i;
+      return true;
+    }
+  }
+  return false;
+}
+
+void Log::setThreshold(LogCategory t_category, LogLevel t_level) {
+  s_thresholds[t_category] = t_level;
+}
+
+LogLevel Log::getThreshold(LogCategory t_category) {
+  return (LogLevel)s_thresholds[t_category];
+}
+
+bool Log::configure(string t_spec) {
+  bool valid = true;
+  stringstream items(t_spec);
+  string item;
+  while (getline(items, item, ',')) {
+    if (item.empty())
+      continue;
+    LogLevel level;
+    size_t equal = item.find('=');
+    if (equal == string::npos) {
+      if (parseLevel(item, &level)) {
+        for (int i=0; i<LOG_CATEGORY_COUNT; ++i) {
+          s_thresholds[i] = level;
+        }
+        continue;
+      }
+    } else {
+      LogCategory category;
+      if (parseCategory(item.substr(0, equal), &category) and
+          parseLevel(item.substr(equal+1), &level)) {
+        s_thresholds[category] = level;
+        continue;
+      }
+    }
+    cout << "Error: Unknown log setting '" << item << "'\n";
+    valid = false;
+  }
+  return valid;
+}
+
+bool Log::configureFromEnvironment() {
+  const char* spec = getenv("CGRA_LOG");
+  if (spec == NULL)
+    return true;
+  return configure(spec);
+}
+
+ostream& Log::stream() {
+  return cout;
+}
+
+void Log::flush() {
+  cout.flush();
+}
@@ -0,0 +1,80 @@
+/*
+ * ======================================================================
+ * Log.h
+ * ======================================================================
+ * Leveled logging per category header file.
+ *
+ * Date : October 16, 2026
+ */
+
+#ifndef Log_H
+#define Log_H
+
+#include <iostream>
+#include <string>
+
+using namespace std;
+
+enum LogCategory {
+  LOG_MAPPER,
+  LOG_ROUTE,
+  LOG_MRRG,
+  LOG_DFG,
+  LOG_DVFS,
+  LOG_CATEGORY_COUNT
+};
+
+// A message is printed if its level is at most the threshold of its
+// category. The summary lines (e.g., "[Mapping II: N]") and the errors are
+// always printed, which is all the quiet threshold leaves.
+enum LogLevel {
+  LOG_QUIET,
+  // Once per kernel or per II, e.g., the schedule of a mapping.
+  LOG_INFO,
+  // Once per DFG node, e.g., where it is scheduled or why it fails.
+  LOG_DEBUG,
+  // Once per hop or slot, e.g., the links and registers occupied.
+  LOG_TRACE
+};
+
+// The messages above this level are compiled out, e.g., with
+// -DCGRA_LOG_MAX_LEVEL=LOG_INFO (see CMakeLists.txt).
+#ifndef CGRA_LOG_MAX_LEVEL
+#define CGRA_LOG_MAX_LEVEL LOG_TRACE
+#endif
+
+// Whether to print the message, which folds into false at compile time
+// for the levels above CGRA_LOG_MAX_LEVEL.
+#define CGRA_LOG_ENABLED(t_category, t_level) \
+  ((t_level) <= CGRA_LOG_MAX_LEVEL and Log::isEnabled(t_category, t_level))
+
+// Usage: CGRA_LOG(LOG_ROUTE, LOG_TRACE) << "..." << "\n";
+// The operands are not even evaluated if the message is not printed.
+#define CGRA_LOG(t_category, t_level) \
+  if (!CGRA_LOG_ENABLED(t_category, t_level)) {} else Log::stream()
+
+class Log {
+  private:
+    static int s_thresholds[LOG_CATEGORY_COUNT];
+
+  public:
+    static bool isEnabled(LogCategory t_category, LogLevel t_level) {
+      return t_level <= s_thresholds[t_category];
+    }
+    static void setThreshold(LogCategory, LogLevel);
+    static LogLevel getThreshold(LogCategory);
+    // Applies a comma separated list, where a level (quiet, info, debug,
+    // or trace) sets all the categories and <category>=<level> sets one,
+    // e.g., "info,route=trace". Returns false on an unknown name, leaving
+    // the rest of the list applied.
+    static bool configure(string);
+    // Applies the CGRA_LOG environment variable if set, on top of
+    // param.json.
+    static bool configureFromEnvironment();
+    // The messages are buffered rather than flushed line by line, so
+    // they need to end with "\n" instead of endl.
+    static ostream& stream();
+    static void flush();
+};
+
+#endif
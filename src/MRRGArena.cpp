@@ -0,0 +1,96 @@
+/*
+ * ======================================================================
+ * MRRGArena.cpp
+ * ======================================================================
+ * Bump allocator of the MRRG state implementation.
+ *
+ * Date : October 16, 2026
+ */
+
+#include "MRRGArena.h"
+#include <algorithm>
+
+MRRGArena::MRRGArena() {
+  m_cursor.block = 0;
+  m_cursor.offset = 0;
+  m_highWaterMark = 0;
+}
+
+MRRGArena::~MRRGArena() {
+  releaseBlocks();
+}
+
+void MRRGArena::releaseBlocks() {
+  for (char* block: m_blocks) {
+    delete[] block;
+  }
+  m_blocks.clear();
+  m_blockSizes.clear();
+  m_blockStarts.clear();
+}
+
+char* MRRGArena::allocateBytes(int t_size, int t_alignment) {
+  while (true) {
+    if (m_cursor.block == (int)m_blocks.size()) {
+      long size = max((long)BLOCK_SIZE, getCapacity());
+      size = max(size, (long)t_size + t_alignment);
+      if (m_blocks.empty()) {
+        m_blockStarts.push_back(0);
+      }
+      m_blocks.push_back(new char[size]);
+      m_blockSizes.push_back(size);
+    }
+    char* block = m_blocks[m_cursor.block];
+    size_t address = (size_t)(block + m_cursor.offset);
+    int padding = (t_alignment - address % t_alignment) % t_alignment;
+    if (m_cursor.offset + padding + t_size <= m_blockSizes[m_cursor.block]) {
+      char* memory = block + m_cursor.offset + padding;
+      m_cursor.offset += padding + t_size;
+      if (getUsedBytes() > m_highWaterMark)
+        m_highWaterMark = getUsedBytes();
+      return memory;
+    }
+    // The rest of the block is skipped.
+    long usedBytes = getUsedBytes();
+    ++m_cursor.block;
+    m_cursor.offset = 0;
+    if (m_cursor.block == (int)m_blockStarts.size()) {
+      m_blockStarts.push_back(usedBytes);
+    } else {
+      m_blockStarts[m_cursor.block] = usedBytes;
+    }
+  }
+}
+
+void MRRGArena::reset() {
+  if (m_blocks.size() > 1) {
+    releaseBlocks();
+    m_blockStarts.push_back(0);
+    m_blocks.push_back(new char[m_highWaterMark]);
+    m_blockSizes.push_back(m_highWaterMark);
+  }
+  m_cursor.block = 0;
+  m_cursor.offset = 0;
+}
+
+ArenaCursor* MRRGArena::getCursor() {
+  return &m_cursor;
+}
+
+long MRRGArena::getUsedBytes() {
+  if (m_cursor.block == (int)m_blocks.size())
+    return m_blockStarts.empty() ? 0 : m_blockStarts[m_cursor.block];
+  return m_blockStarts[m_cursor.block] + m_cursor.offset;
+}
+
+long MRRGArena::getHighWaterMark() {
+  return m_highWaterMark;
+}
+
+long MRRGArena::getCapacity() {
+  long capacity = 0;
+  for (long size: m_blockSizes) {
+    capacity += size;
+  }
+  return capacity;
+}
@@ -0,0 +1,62 @@
+/*
+ * ======================================================================
+ * MRRGArena.h
+ * ======================================================================
+ * Bump allocator of the MRRG state header file.
+ *
+ * Date : October 16, 2026
+ */
+
+#ifndef MRRGArena_H
+#define MRRGArena_H
+
+#include <vector>
+#include <cstddef>
+
+using namespace std;
+
+// Position of the next allocation in the arena.
+struct ArenaCursor {
+  int block;
+  int offset;
+};
+
+// Bump allocator holding the MRRG state of one CGRA, i.e., the modulo
+// reservation tables of its tiles and links, and the operations placed
+// into the slots while mapping. Allocating moves the cursor through a
+// list of blocks that are kept across the II attempts, so the whole MRRG
+// is released in O(1) by reset() when it is constructed for another II.
+// A new block is at least as large as the ones before it together, and
+// reset() merges the blocks into a single one holding the most bytes
+// used so far, so the blocks outgrown by a larger II are not kept. The
+// undo log restores the cursor (see getCursor()), which takes back the
+// allocations of a rolled back schedule as well.
+class MRRGArena {
+  private:
+    static const int BLOCK_SIZE = 64 * 1024;
+    vector<char*> m_blocks;
+    vector<long> m_blockSizes;
+    // The bytes used before each block, i.e., without the skipped rest of
+    // the blocks before it.
+    vector<long> m_blockStarts;
+    ArenaCursor m_cursor;
+    long m_highWaterMark;
+    char* allocateBytes(int, int);
+    void releaseBlocks();
+
+  public:
+    MRRGArena();
+    ~MRRGArena();
+    // The memory is neither initialized nor ever destructed, so it is only
+    // meant for trivially copyable types.
+    template<typename T> T* allocate(int t_count) {
+      return (T*)allocateBytes(t_count * sizeof(T), alignof(T));
+    }
+    void reset();
+    ArenaCursor* getCursor();
+    long getUsedBytes();
+    long getHighWaterMark();
+    long getCapacity();
+};
+
+#endif
@@ -9,6 +9,9 @@
  */
 
 #include "Mapper.h"
+#include "Counters.h"
+#include "Log.h"
+#include "Profiler.h"
 #include "json.hpp"
 #include <cmath>
 #include <iostream>
@@ -18,376 +21,422 @@
 #include <vector>
 #include <fstream>
 #include <omp.h>
+#include <climits>
 
 //#include <nlohmann/json.hpp>
 using json = nlohmann::json;
 
 Mapper::Mapper(bool t_DVFSAwareMapping) {
   m_DVFSAwareMapping = t_DVFSAwareMapping;
+  m_lowestMappedII = NULL;
+  m_view = NULL;
+  m_ownsView = false;
 }
 
-int Mapper::getResMII(DFG* t_dfg, CGRA* t_cgra) {
-  int ResMII = ceil(float(t_dfg->getNodeCount()) / t_cgra->getFUCount());
-  // For exclusive strategy, the II max be not less than the maximum execution latency.
-  int max_exec_latency = t_dfg->getMaxExecLatency();
-  if (!t_cgra->getSupportInclusive() && max_exec_latency > ResMII) ResMII = max_exec_latency;
-  return ResMII;
+CostModel* Mapper::getCostModel() {
+  return &m_costModel;
 }
 
-int Mapper::getRecMII(DFG* t_dfg) {
-  float RecMII = 0.0;
-  float temp_RecMII = 0.0;
-  list<list<DFGNode*>*>* cycles = t_dfg->getCycleLists(); //calculateCycles();
-  // cout<<"... number of cycles: "<<cycles->size()<<" ..."<<endl;
-  // TODO: RecMII = MAX (delay(c) / distance(c))
-  for( list<DFGNode*>* cycle: *cycles) {
-    temp_RecMII = float(cycle->size()) / 1.0;
-    // cout << "... [DEBUG] cycle length " << temp_RecMII << "..." <<endl;
-    // for (DFGNode* dfgNode: *cycle){
-    //   cout << "... [DEBUG] cycle nodes " << dfgNode->getID() << " "<< dfgNode->getOpcodeName() << " ";
-    // }
-    if(temp_RecMII > RecMII)
-      RecMII = temp_RecMII;
-  }
-  return ceil(RecMII);
+Mapper::~Mapper() {
+  if (m_ownsView)
+    delete m_view;
 }
 
-int Mapper::getExpandableII(DFG* t_dfg, int t_ii) {
-  int rec_mii = getRecMII(t_dfg);
-  int ceiled = ceil((float)t_ii / 2.0);
-  return std::max(rec_mii, ceiled);
+// Takes the snapshot of the DFG the first time it is mapped. The DFG is
+// not modified while mapping, and the probes borrow the snapshot of the
+// mapper spawning them (see probeMap()).
+void Mapper::freezeDFG(DFG* t_dfg) {
+  if (m_view != NULL and m_view->getDFG() == t_dfg)
+    return;
+  if (m_ownsView)
+    delete m_view;
+  m_view = new DFGView(t_dfg);
+  m_ownsView = true;
 }
 
-void Mapper::constructMRRG(DFG* t_dfg, CGRA* t_cgra, int t_II) {
-  m_mapping.clear();
-  m_mappingTiming.clear();
-  t_cgra->constructMRRG(t_II);
-  m_maxMappingCycle = t_cgra->getFUCount()*t_II*t_II;
-  for (DFGNode* dfgNode: t_dfg->nodes) {
-    dfgNode->clearMapped();
+// Maps the DFG node onto the tile at the cycle (or unmaps it with a NULL
+// tile), keeping the per-tile index of the mapped nodes in order.
+void Mapper::setMapping(int t_index, CGRANode* t_tile, int t_cycle,
+    UndoLog* t_undoLog) {
+  CGRANode* previous = m_mappedTiles[t_index];
+  if (previous != t_tile) {
+    if (previous != NULL) {
+      vector<int>* tileNodes = &m_tileNodes[previous->getID()];
+      vector<int>::iterator it =
+          find(tileNodes->begin(), tileNodes->end(), t_index);
+      t_undoLog->recordErase(tileNodes, t_index, it - tileNodes->begin());
+      tileNodes->erase(it);
+      if (m_view->getSuccCount(t_index) > 2) {
+        t_undoLog->record(&m_tileFanoutCounts[previous->getID()]);
+        --m_tileFanoutCounts[previous->getID()];
+      }
+    }
+    if (t_tile != NULL) {
+      vector<int>* tileNodes = &m_tileNodes[t_tile->getID()];
+      tileNodes->insert(
+          lower_bound(tileNodes->begin(), tileNodes->end(), t_index), t_index);
+      t_undoLog->recordInsert(tileNodes, t_index);
+      if (m_view->getSuccCount(t_index) > 2) {
+        t_undoLog->record(&m_tileFanoutCounts[t_tile->getID()]);
+        ++m_tileFanoutCounts[t_tile->getID()];
+      }
+    }
   }
+  t_undoLog->record(&m_mappedTiles[t_index]);
+  m_mappedTiles[t_index] = t_tile;
+  t_undoLog->record(&m_mappedCycles[t_index]);
+  m_mappedCycles[t_index] = t_tile == NULL ? -1 : t_cycle;
 }
 
-// The arriving data can stay inside the input buffer
-map<CGRANode*, int>* Mapper::dijkstra_search(CGRA* t_cgra, DFG* t_dfg,
-    int t_II, DFGNode* t_srcDFGNode, DFGNode* t_targetDFGNode,
-    CGRANode* t_dstCGRANode) {
-  list<CGRANode*> searchPool;
-  map<CGRANode*, int> distance;
-  map<CGRANode*, int> timing;
-  map<CGRANode*, CGRANode*> previous;
-  CGRANode* srcCGRANode = m_mapping[t_srcDFGNode];
-  timing[srcCGRANode] = m_mappingTiming[t_srcDFGNode];
-  for (int i=0; i<t_cgra->getRows(); ++i) {
-    for (int j=0; j<t_cgra->getColumns(); ++j) {
-      CGRANode* node = t_cgra->nodes[i][j];
-      distance[node] = m_maxMappingCycle;
-      timing[node] = m_mappingTiming[t_srcDFGNode];
-      timing[node] += t_srcDFGNode->getExecLatency(node->getDVFSLatencyMultiple()) - 1;
-//      if (t_srcDFGNode->isLoad() or t_srcDFGNode->isStore()) {
-//        timing[node] += 1;
-//      }
-      // TODO: should also consider the xbar here?
-//      if (!cgra->nodes[i][j]->canOccupyFU(timing[node], II)) {
-//        int temp_cycle = timing[node];
-//        timing[node] = m_maxMappingCycle;
-//        while (temp_cycle < m_maxMappingCycle) {
-//          if (cgra->nodes[i][j]->canOccupyFU(temp_cycle, II)) {
-//            timing[node] = temp_cycle;
-//            break;
-//          }
-//          ++temp_cycle;
-//        }
-//      }
-      previous[node] = NULL;
-      searchPool.push_back(t_cgra->nodes[i][j]);
+CGRANode* Mapper::getMappedTile(DFGNode* t_dfgNode) {
+  int index = m_view->getIndex(t_dfgNode);
+  return index == -1 ? NULL : m_mappedTiles[index];
+}
+
+int Mapper::getMappedCycle(DFGNode* t_dfgNode) {
+  int index = m_view->getIndex(t_dfgNode);
+  return index == -1 ? -1 : m_mappedCycles[index];
+}
+
+// ResMII = MAX (demand(c) / tiles(c)) over the capability classes c, where
+// a class is the set of tiles supporting a DFG node (e.g., only the tiles
+// listed in additionalFunc can load/store, and the disabled tiles support
+// nothing). A class has to accommodate the nodes of all the classes it
+// contains, and a multi-cycle operation occupies its tile exclusively for
+// its whole latency unless the tiles support inclusive execution. The
+// opcodes of the limiting class are reported via t_limitingClass.
+int Mapper::getResMII(DFG* t_dfg, CGRA* t_cgra, string* t_limitingClass) {
+  ScopedTimer timer("mapper.ResMII");
+  int rows = t_cgra->getRows();
+  int columns = t_cgra->getColumns();
+  map<vector<bool>, int> classDemand;
+  map<vector<bool>, set<string>> classOpts;
+  vector<CGRANode*> supportingNodes;
+  for (DFGNode* dfgNode: t_dfg->nodes) {
+    vector<bool> tiles(rows*columns, false);
+    t_cgra->getSupportingNodes(dfgNode, &supportingNodes);
+    for (CGRANode* tile: supportingNodes) {
+      tiles[tile->getY()*columns+tile->getX()] = true;
     }
+    int occupancy = 1;
+    if (!t_cgra->getSupportInclusive()) {
+      occupancy = dfgNode->getExecLatency(dfgNode->getDVFSLatencyMultiple());
+    }
+    classDemand[tiles] += occupancy;
+    classOpts[tiles].insert(dfgNode->getOpcodeName());
   }
-  distance[m_mapping[t_srcDFGNode]] = 0;
-  while (searchPool.size() != 0) {
-    int minCost = m_maxMappingCycle + 1;
-    CGRANode* minNode;
-    for (CGRANode* currentNode: searchPool) {
-      if (distance[currentNode] < minCost) {
-        minCost = distance[currentNode];
-        minNode = currentNode;
+
+  int ResMII = 0;
+  for (auto& capabilityClass: classDemand) {
+    const vector<bool>& tiles = capabilityClass.first;
+    int tileCount = count(tiles.begin(), tiles.end(), true);
+    // Unsupported nodes are reported by canMap instead.
+    if (tileCount == 0) continue;
+    int demand = 0;
+    for (auto& subClass: classDemand) {
+      bool contained = true;
+      for (int i=0; i<(int)tiles.size(); ++i) {
+        if (subClass.first[i] and !tiles[i]) {
+          contained = false;
+          break;
+        }
       }
+      if (contained) demand += subClass.second;
     }
-    assert(minNode != NULL);
-    searchPool.remove(minNode);
-    // found the target point in the shortest path
-    if (minNode == t_dstCGRANode) {
-      timing[t_dstCGRANode] = minNode->getMinIdleCycle(t_targetDFGNode, timing[minNode], t_II);
-      break;
-    }
-    list<CGRANode*>* currentNeighbors = minNode->getNeighbors();
-//    cout<<"DEBUG no need?"<<endl;
-
-    for (CGRANode* neighbor: *currentNeighbors) {
-      int cycle = timing[minNode];
-      while (1) {
-        CGRALink* currentLink = minNode->getOutLink(neighbor);
-        // TODO: should also consider the cost of the register file
-        if (currentLink->canOccupy(t_srcDFGNode, srcCGRANode, cycle, t_II)) {
-          // rough estimate the cost based on the suspend cycle
-          int cost = distance[minNode] + (cycle - timing[minNode]) + 1;
-          if (cost < distance[neighbor]) {
-            distance[neighbor] = cost;
-            timing[neighbor] = cycle + 1;
-            previous[neighbor] = minNode;
-          }
-          break;
+    int classMII = ceil(float(demand) / tileCount);
+    if (classMII > ResMII) {
+      ResMII = classMII;
+      if (t_limitingClass != NULL) {
+        *t_limitingClass = "";
+        for (string opt: classOpts[tiles]) {
+          *t_limitingClass += opt + " ";
         }
-        ++cycle;
-        if(cycle > m_maxMappingCycle)
-          break;
+        *t_limitingClass += "on " + to_string(tileCount) + " tiles";
       }
     }
   }
 
-  // Get the shortest path.
-  map<CGRANode*, int>* path = new map<CGRANode*, int>();
-  CGRANode* u = t_dstCGRANode;
-  if (previous[u] != NULL or u == m_mapping[t_srcDFGNode]) {
-    while (u != NULL) {
-      (*path)[u] = timing[u];
-      u = previous[u];
+  // For exclusive strategy, the II max be not less than the maximum execution latency.
+  int max_exec_latency = t_dfg->getMaxExecLatency();
+  if (!t_cgra->getSupportInclusive() && max_exec_latency > ResMII) {
+    ResMII = max_exec_latency;
+    if (t_limitingClass != NULL) {
+      *t_limitingClass = "exec latency";
     }
   }
-  if (timing[t_dstCGRANode] > m_maxMappingCycle or
-      !t_dstCGRANode->canOccupy(t_targetDFGNode,
-      timing[t_dstCGRANode], t_II)) {
-//    path.clear();
-    delete path;
-    return NULL;
-  }
-  return path;
+  return ResMII;
 }
 
-list<map<CGRANode*, int>*>* Mapper::getOrderedPotentialPaths(CGRA* t_cgra,
-    DFG* t_dfg, int t_II, DFGNode* t_dfgNode, list<map<CGRANode*, int>*>* t_paths) {
-  map<map<CGRANode*, int>*, float>* pathsWithCost =
-      new map<map<CGRANode*, int>*, float>();
-  for (list<map<CGRANode*, int>*>::iterator path=t_paths->begin();
-      path!=t_paths->end(); ++path) {
-    if ((*path)->size() == 0)
-      continue;
-
-    map<int, CGRANode*>* reorderPath = getReorderPath(*path);
-//    for (map<CGRANode*, int>::iterator rp=(*path)->begin(); rp!=(*path)->end(); ++rp)
-//      reorderPath[(*rp).second] = (*rp).first;
-//    assert(reorderPath.size() == (*path)->size());
-
-    map<int, CGRANode*>::reverse_iterator riter=reorderPath->rbegin();
-
-    int distanceCost = (*riter).first;
-    CGRANode* targetCGRANode = (*riter).second;
-    int targetCycle = (*riter).first;
-    if (distanceCost >= m_maxMappingCycle)
-      continue;
-//    if (t_dfgNode->getID() == 2 or t_dfgNode->getID() == 1) {
-//      cout<<"DEBUG what?! distance: "<<distanceCost<<"; target CGRA node: "<<targetCGRANode->getID()<<endl;
-//    }
-    // Consider the cost of the distance.
-    float cost = distanceCost + 1;
-
-    // Consider the same tile mapped with continuously two DFG nodes.
-    map<int, CGRANode*>::iterator lastCGRANodeItr=reorderPath->begin();
-    for (map<int, CGRANode*>::iterator cgraNodeItr=reorderPath->begin();
-        cgraNodeItr!=reorderPath->end(); ++cgraNodeItr) {
-      if (cgraNodeItr != reorderPath->begin()) {
-        int lastCycle = (*lastCGRANodeItr).first;
-        int currentCycle = (*cgraNodeItr).first;
-        int delta = currentCycle - lastCycle;
-        if (delta > 1) {
-          cost = cost + 1.5;
-        }
+// Checks whether no recurrence of the DFG needs more than t_II cycles per
+// iteration, i.e., no cycle has a positive total weight when each edge
+// weighs latency(src) - t_II * distance(src, dst). The positive cycles are
+// detected with the longest-path variant of Bellman-Ford.
+static bool fitsRecurrences(int t_nodeCount, vector<int>& t_src,
+    vector<int>& t_dst, vector<int>& t_latency, vector<int>& t_distance,
+    int t_II) {
+  vector<long> length(t_nodeCount, 0);
+  for (int round = 0; round < t_nodeCount; ++round) {
+    bool relaxed = false;
+    for (int e = 0; e < (int)t_src.size(); ++e) {
+      long candidate = length[t_src[e]] + t_latency[e] - (long)t_II * t_distance[e];
+      if (candidate > length[t_dst[e]]) {
+        length[t_dst[e]] = candidate;
+        relaxed = true;
       }
-      lastCGRANodeItr = cgraNodeItr;
     }
+    if (!relaxed) return true;
+  }
+  return false;
+}
 
-    // Consider the single tile that processes everything. FIXME: this is
-    // actually a bug because we use map<CGRANode*, int> rather than
-    // map<int, CGRANode*>, in which case the different cycles's execution
-    // will be wrongly merged into one.
-    if (reorderPath->size() == 1) {
-      cost += 2;
-    }
+// RecMII = MAX (delay(c) / distance(c)) over all the cycles c of the DFG,
+// where the delay sums up the execution latency of the nodes along the
+// cycle and the distance counts its loop-carried edges. Following the
+// sequential execution order, an edge going to a node that is not behind
+// its source carries the value into the next iteration. Rather than
+// enumerating the cycles, the smallest integer II that all the cycles fit
+// into is binary searched, which is exactly the ceiled maximum ratio.
+int Mapper::getRecMII(DFG* t_dfg) {
+  ScopedTimer timer("mapper.RecMII");
+  map<DFGNode*, int> nodeIndex;
+  for (DFGNode* dfgNode: t_dfg->nodes) {
+    int index = nodeIndex.size();
+    nodeIndex[dfgNode] = index;
+  }
+  vector<int> src;
+  vector<int> dst;
+  vector<int> latency;
+  vector<int> distance;
+  int totalLatency = 0;
+  for (DFGNode* dfgNode: t_dfg->nodes) {
+    totalLatency += dfgNode->getExecLatency(dfgNode->getDVFSLatencyMultiple());
+  }
+  for (DFGEdge* edge: *(t_dfg->getDFGEdges())) {
+    DFGNode* srcNode = edge->getSrc();
+    DFGNode* dstNode = edge->getDst();
+    // The partners of a fused pattern are represented by their root.
+    if (nodeIndex.find(srcNode) == nodeIndex.end() and srcNode->hasCombined())
+      srcNode = srcNode->getPatternRoot();
+    if (nodeIndex.find(dstNode) == nodeIndex.end() and dstNode->hasCombined())
+      dstNode = dstNode->getPatternRoot();
+    if (nodeIndex.find(srcNode) == nodeIndex.end() or
+        nodeIndex.find(dstNode) == nodeIndex.end())
+      continue;
+    src.push_back(nodeIndex[srcNode]);
+    dst.push_back(nodeIndex[dstNode]);
+    latency.push_back(srcNode->getExecLatency(srcNode->getDVFSLatencyMultiple()));
+    distance.push_back(dstNode->getID() <= srcNode->getID() ? 1 : 0);
+  }
 
-    // Consider the cost of the utilization of contrl memory.
-    if (m_DVFSAwareMapping) {
-      cost += targetCGRANode->getCurrentCtrlMemItems() / 2;
+  int lowerII = 0;
+  int upperII = totalLatency;
+  while (lowerII < upperII) {
+    int II = (lowerII + upperII) / 2;
+    if (fitsRecurrences(nodeIndex.size(), src, dst, latency, distance, II)) {
+      upperII = II;
     } else {
-      cost += targetCGRANode->getCurrentCtrlMemItems();
-    }
-
-    // Consider the cost of the outgoing ports.
-    if (t_dfgNode->getSuccNodes()->size() > 1) {
-      cost += 4 - targetCGRANode->getOutLinks()->size() +
-          abs(t_cgra->getColumns()/2-targetCGRANode->getX()) +
-          abs(t_cgra->getRows()/2-targetCGRANode->getY());
-    }
-    if (t_dfgNode->getPredNodes()->size() > 0) {
-      list<DFGNode*>* tempPredNodes = t_dfgNode->getPredNodes();
-      for (DFGNode* predDFGNode: *tempPredNodes) {
-        if (predDFGNode->getSuccNodes()->size() > 2
-            and m_mapping.find(predDFGNode) != m_mapping.end()) {
-          if (m_mapping[predDFGNode] == targetCGRANode)
-            cost -= 0.5;
-        }
-      }
-    }
-
-    // Considers the island for DVFS.
-    // Better to put the DFGNode inside the CGRA island with the
-    // matched DVFS level. A special case is by default the DVFS
-    // level is 1, but the island mapped with DFG node has the
-    // real DVFS level 1, which has the highest priority. The unmapped
-    // island has lower priority though its DVFS level is also shown
-    // as 1.
-    if (m_DVFSAwareMapping) {
-      if (targetCGRANode->isMapped()) {
-        cost -= 0.3;
-      }
-      if (targetCGRANode->isSynced() and
-          targetCGRANode->getDVFSLatencyMultiple() == t_dfgNode->getDVFSLatencyMultiple()) {
-        cost -= 1.0;
-      } else if (!targetCGRANode->isSynced()) {
-        cost -= 0.2;
-      }
+      lowerII = II + 1;
     }
+  }
+  return lowerII;
+}
 
-    /*
-    // Prefer to map the DFG nodes from left to right rather than
-    // always picking CGRA node at left.
-    if (t_dfgNode->getPredNodes()->size() > 0) {
-      list<DFGNode*>* tempPredNodes = t_dfgNode->getPredNodes();
-      for (DFGNode* predDFGNode: *tempPredNodes) {
-        if (m_mapping.find(predDFGNode) != m_mapping.end()) {
-          if (m_mapping[predDFGNode]->getX() > targetCGRANode->getX() or
-              m_mapping[predDFGNode]->getY() > targetCGRANode->getY()) {
-            cost += 0.5;
-          }
-        }
-      }
-    }
-    */
-
-    // Consider the cost of that the DFG node with multiple successor
-    // might potentially occupy the surrounding CGRA nodes.
-    list<CGRANode*>* neighbors = targetCGRANode->getNeighbors();
-    for (CGRANode* neighbor: *neighbors) {
-      list<DFGNode*>* dfgNodes = getMappedDFGNodes(t_dfg, neighbor);
-      for (DFGNode* dfgNode: *dfgNodes) {
-        if (dfgNode->getSuccNodes()->size() > 2) {
-          cost += 0.4;
-        }
-      }
-    }
+int Mapper::getExpandableII(DFG* t_dfg, int t_ii) {
+  int rec_mii = getRecMII(t_dfg);
+  int ceiled = ceil((float)t_ii / 2.0);
+  return std::max(rec_mii, ceiled);
+}
 
-    // Consider the cost of occupying the leftmost (rightmost) CGRA
-    // nodes that are reserved for load.
-    if ((!t_dfgNode->isLoad() and targetCGRANode->canLoad()) or
-        (!t_dfgNode->isStore() and targetCGRANode->canStore())) {
-      cost += 2;
+void Mapper::constructMRRG(DFG* t_dfg, CGRA* t_cgra, int t_II) {
+  ScopedTimer timer("mrrg.construct");
+  freezeDFG(t_dfg);
+  m_mappedTiles.assign(m_view->getNodeCount(), NULL);
+  m_mappedCycles.assign(m_view->getNodeCount(), -1);
+  m_tileNodes.assign(t_cgra->getFUCount(), vector<int>());
+  m_tileFanoutCounts.assign(t_cgra->getFUCount(), 0);
+  t_cgra->constructMRRG(t_II);
+  m_maxMappingCycle = t_cgra->getFUCount()*t_II*t_II;
+  // The probes share the DFG, so only the mapper owning the final
+  // mapping marks its DFG nodes.
+  if (m_lowestMappedII == NULL) {
+    for (DFGNode* dfgNode: t_dfg->nodes) {
+      dfgNode->clearMapped();
     }
+  }
+}
 
-    // Consider the bonus of reusing the same link for delivery the
-    // same data to different destination CGRA nodes (multicast).
-    lastCGRANodeItr=reorderPath->begin();
-    for (map<int, CGRANode*>::iterator cgraNodeItr=reorderPath->begin();
-        cgraNodeItr!=reorderPath->end(); ++cgraNodeItr) {
-      if (cgraNodeItr != reorderPath->begin()) {
-        CGRANode* left = (*lastCGRANodeItr).second;
-        CGRANode* right = (*cgraNodeItr).second;
-        int leftCycle = (*lastCGRANodeItr).first;
-//        cout<<"$$$$$$$$$$ wrong?! left node: "<<left->getID()<<" -> right node: "<<right->getID()<<endl;
-        CGRALink* l = left->getOutLink(right);
-        if (l != NULL and l->isReused(leftCycle)) {
-          cost -= 0.5;
-        }
-      }
-      lastCGRANodeItr = cgraNodeItr;
+// Routes the output of each mapped predecessor of the DFG node towards
+// all the tiles at once. The candidate tiles of the DFG node then read
+// their paths from the same search trees (see getShortestPath()) rather
+// than searching again from the same source for every tile. The placement
+// of the predecessors is captured up front (without inserting anything
+// into the mapping), so the searches themselves only read the MRRG and
+// can run concurrently.
+RoutingContext* Mapper::createRoutingContext(CGRA* t_cgra, int t_II,
+    DFGNode* t_dfgNode) {
+  RoutingContext* context =
+      new RoutingContext(t_dfgNode, t_II, m_maxMappingCycle);
+  vector<DFGNode*> mappedPredNodes;
+  vector<CGRANode*> mappedTiles;
+  vector<int> mappedCycles;
+  int index = m_view->getIndex(t_dfgNode);
+  const int* preds = m_view->getPreds(index);
+  for (int p=0; p<m_view->getPredCount(index); ++p) {
+    DFGNode* pre = m_view->getNode(preds[p]);
+    if (m_mappedTiles[preds[p]] == NULL or
+        find(mappedPredNodes.begin(), mappedPredNodes.end(), pre) != mappedPredNodes.end()) {
+      continue;
     }
+    mappedPredNodes.push_back(pre);
+    mappedTiles.push_back(m_mappedTiles[preds[p]]);
+    mappedCycles.push_back(m_mappedCycles[preds[p]]);
+  }
 
-    // Consider the bonus of available links on the target CGRA nodes.
-    cost -= targetCGRANode->getOccupiableInLinks(targetCycle, t_II)->size()*0.3 +
-        targetCGRANode->getOccupiableOutLinks(targetCycle, t_II)->size()*0.3;
-
-    (*pathsWithCost)[*path] = cost;
+  int predCount = mappedPredNodes.size();
+  vector<Router*> routers(predCount, NULL);
+  #pragma omp parallel for if(predCount > 1)
+  for (int i=0; i<predCount; ++i) {
+    routers[i] = new Router(t_cgra);
+    routers[i]->search(mappedPredNodes[i], mappedTiles[i], mappedCycles[i],
+                       t_II, m_maxMappingCycle, NULL);
   }
+  for (Router* router: routers) {
+    context->addRouter(router);
+  }
+  return context;
+}
 
-  list<map<CGRANode*, int>*>* potentialPaths = new list<map<CGRANode*, int>*>();
-  while(pathsWithCost->size() != 0) {
-    float minCost = (*pathsWithCost->begin()).second;
-    map<CGRANode*, int>* currentPath = (*pathsWithCost->begin()).first;
-    for (map<map<CGRANode*, int>*, float>::iterator pathItr=pathsWithCost->begin();
-        pathItr!=pathsWithCost->end(); ++pathItr) {
-      if ((*pathItr).second < minCost) {
-        minCost = (*pathItr).second;
-        currentPath = (*pathItr).first;
-      }
-    }
-    pathsWithCost->erase(currentPath);
-    potentialPaths->push_back(currentPath);
+// The arriving data can stay inside the input buffer
+bool Mapper::getShortestPath(RoutingContext* t_context,
+    Router* t_router, CGRANode* t_dstCGRANode, Route* t_route) {
+  DFGNode* targetDFGNode = t_context->getDFGNode();
+  int II = t_context->getII();
+  int dstTiming = t_dstCGRANode->getMinIdleCycle(targetDFGNode,
+      t_router->getTiming(t_dstCGRANode), II);
+
+  // Get the shortest path.
+  t_router->getRoute(t_dstCGRANode, dstTiming, t_route);
+  if (t_route->isEmpty() or dstTiming > t_context->getMaxMappingCycle() or
+      !t_dstCGRANode->canOccupy(targetDFGNode, dstTiming, II)) {
+    t_route->clear();
+    return false;
   }
+  return true;
+}
 
-  delete pathsWithCost;
-  return potentialPaths;
+// The cost of mapping the DFG node onto the last tile of the path. It only
+// reads the mapping and the MRRG, so the paths are costed concurrently.
+float Mapper::getPathCost(CGRA* t_cgra, int t_II, DFGNode* t_dfgNode,
+    Route* t_path) {
+  PathCostContext context;
+  context.cgra = t_cgra;
+  context.II = t_II;
+  context.view = m_view;
+  context.index = m_view->getIndex(t_dfgNode);
+  context.dfgNode = t_dfgNode;
+  context.path = t_path;
+  context.tile = t_path->getLastHop()->tile;
+  context.cycle = t_path->getLastHop()->cycle;
+  context.DVFSAwareMapping = m_DVFSAwareMapping;
+  context.mappedTiles = &m_mappedTiles;
+  context.tileFanoutCounts = &m_tileFanoutCounts;
+  return m_costModel.getCost(&context);
 }
 
-map<CGRANode*, int>* Mapper::getPathWithMinCostAndConstraints(CGRA* t_cgra,
-    DFG* t_dfg, int t_II, DFGNode* t_dfgNode, list<map<CGRANode*, int>*>* t_paths) {
+// Each path is cheap to cost, so only a CGRA with many candidate tiles
+// is worth forking the threads for.
+#define PARALLEL_COST_PATHS 32
+
+// Costs all the paths within the mapping bound in one pass, the paths
+// being kept in the order of the candidates.
+void Mapper::getPathCosts(CGRA* t_cgra, int t_II, DFGNode* t_dfgNode,
+    vector<Route*>* t_paths, vector<Route*>* t_candidatePaths,
+    vector<float>* t_costs) {
+  t_candidatePaths->clear();
+  for (Route* path: *t_paths) {
+    if (!path->isEmpty() and path->getLastHop()->cycle < m_maxMappingCycle)
+      t_candidatePaths->push_back(path);
+  }
+  int pathCount = t_candidatePaths->size();
+  Counters::add(COUNTER_PLACEMENTS);
+  Counters::add(COUNTER_CANDIDATE_PATHS, pathCount);
+  t_costs->assign(pathCount, 0);
+  #pragma omp parallel for if(pathCount > PARALLEL_COST_PATHS)
+  for (int i=0; i<pathCount; ++i) {
+    (*t_costs)[i] = getPathCost(t_cgra, t_II, t_dfgNode, (*t_candidatePaths)[i]);
+  }
+}
 
-  list<map<CGRANode*, int>*>* potentialPaths =
-      getOrderedPotentialPaths(t_cgra, t_dfg, t_II, t_dfgNode, t_paths);
+void Mapper::getOrderedPotentialPaths(CGRA* t_cgra, DFG* t_dfg, int t_II,
+    DFGNode* t_dfgNode, vector<Route*>* t_paths, vector<Route*>* t_orderedPaths) {
+  vector<Route*> candidatePaths;
+  vector<float> costs;
+  getPathCosts(t_cgra, t_II, t_dfgNode, t_paths, &candidatePaths, &costs);
 
-  // The paths are already ordered well based on the cost in getPotentialPaths().
-  list<map<CGRANode*, int>*>::iterator pathItr=potentialPaths->begin();
-  return (*pathItr);
+  // The paths with the same cost keep the order of the candidates.
+  vector<int> order(candidatePaths.size());
+  for (int i=0; i<(int)order.size(); ++i) {
+    order[i] = i;
+  }
+  stable_sort(order.begin(), order.end(), [&costs](int a, int b) {
+    return costs[a] < costs[b];
+  });
+  t_orderedPaths->clear();
+  for (int i: order) {
+    t_orderedPaths->push_back(candidatePaths[i]);
+  }
 }
 
-list<DFGNode*>* Mapper::getMappedDFGNodes(DFG* t_dfg, CGRANode* t_cgraNode) {
-  list<DFGNode*>* dfgNodes = new list<DFGNode*>();
-  for (DFGNode* dfgNode: t_dfg->nodes) {
-    if (m_mapping.find(dfgNode) != m_mapping.end())
-      if ( m_mapping[dfgNode] == t_cgraNode)
-        dfgNodes->push_back(dfgNode);
+// Only the cheapest path is needed, i.e., the first one in the order of
+// getOrderedPotentialPaths().
+Route* Mapper::getPathWithMinCostAndConstraints(CGRA* t_cgra, DFG* t_dfg,
+    int t_II, DFGNode* t_dfgNode, vector<Route*>* t_paths) {
+  vector<Route*> candidatePaths;
+  vector<float> costs;
+  getPathCosts(t_cgra, t_II, t_dfgNode, t_paths, &candidatePaths, &costs);
+
+  int minPath = -1;
+  for (int i=0; i<(int)candidatePaths.size(); ++i) {
+    if (minPath == -1 or costs[i] < costs[minPath])
+      minPath = i;
   }
-  return dfgNodes;
+  if (minPath == -1)
+    return NULL;
+  return candidatePaths[minPath];
+}
+
+vector<int>* Mapper::getMappedDFGNodes(CGRANode* t_cgraNode) {
+  return &m_tileNodes[t_cgraNode->getID()];
 }
 
 // TODO: will grant award for the overuse the same link for the
 //       same data delivery
-map<CGRANode*, int>* Mapper::calculateCost(CGRA* t_cgra, DFG* t_dfg,
-    int t_II, DFGNode* t_dfgNode, CGRANode* t_fu) {
+bool Mapper::calculateCost(CGRA* t_cgra, DFG* t_dfg, CGRANode* t_fu,
+    RoutingContext* t_context, Route* t_path) {
+  DFGNode* t_dfgNode = t_context->getDFGNode();
+  int t_II = t_context->getII();
+  int maxMappingCycle = t_context->getMaxMappingCycle();
   //cout<<"...calculateCost() for dfgNode "<<t_dfgNode->getID()<<" on tile "<<t_fu->getID()<<endl;
-  map<CGRANode*, int>* path = NULL;
-  list<DFGNode*>* predNodes = t_dfgNode->getPredNodes();
+  t_path->clear();
   int latest = -1;
   bool isAnyPredDFGNodeMapped = false;
 
-  for(DFGNode* pre: *predNodes) {
-//      cout<<"[DEBUG] how dare to pre node: "<<pre->getID()<<"; CGRA node: "<<t_fu->getID()<<endl;
-    if(m_mapping.find(pre) != m_mapping.end()) {
-      // Leverage Dijkstra algorithm to search the shortest path between
-      // the mapped 'CGRANode' of the 'pre' and the target 'fu'.
-      map<CGRANode*, int>* tempPath = NULL;
-      if (t_fu->canSupport(t_dfgNode))
-        tempPath = dijkstra_search(t_cgra, t_dfg, t_II, pre,
-            t_dfgNode, t_fu);
-      if (tempPath == NULL)
-        return NULL;
-      else if ((*tempPath)[t_fu] >= m_maxMappingCycle) {
-        delete tempPath;
-        return NULL;
-      }
-      if ((*tempPath)[t_fu] > latest) {
-        latest = (*tempPath)[t_fu];
-        path = tempPath;
-      }
-      isAnyPredDFGNodeMapped = true;
+  // One router per mapped predecessor, see createRoutingContext().
+  Route tempPath;
+  for (int i=0; i<t_context->getRouterCount(); ++i) {
+    // The shortest path between the mapped 'CGRANode' of the
+    // predecessor and the target 'fu' is read from the search tree.
+    if (!t_fu->canSupport(t_dfgNode) or
+        !getShortestPath(t_context, t_context->getRouter(i), t_fu, &tempPath) or
+        tempPath.getLastHop()->cycle >= maxMappingCycle) {
+      t_path->clear();
+      return false;
     }
+    if (tempPath.getLastHop()->cycle > latest) {
+      latest = tempPath.getLastHop()->cycle;
+      *t_path = tempPath;
+    }
+    isAnyPredDFGNodeMapped = true;
   }
   // TODO: should not be any CGRA node, should consider the memory access.
   // TODO  A DFG node can be mapped onto any CGRA node if no predecessor
@@ -395,47 +444,46 @@ map<CGRANode*, int>* Mapper::calculateCost(CGRA* t_cgra, DFG* t_dfg,
   // TODO: should also consider the current config mem iterms.
   if (!isAnyPredDFGNodeMapped) {
     if (!t_fu->canSupport(t_dfgNode))
-      return NULL;
+      return false;
     int cycle = 0;
-    while (cycle < m_maxMappingCycle) {
+    while (cycle < maxMappingCycle and cycle < t_II) {
       if (t_fu->canOccupy(t_dfgNode, cycle, t_II)) {
-        path = new map<CGRANode*, int>();
-        (*path)[t_fu] = cycle;
+        t_path->push(t_fu, cycle);
         //cout<<"DEBUG how dare to map DFG node: "<<t_dfgNode->getID()<<"; CGRA node: "<<t_fu->getID()<<" at cycle "<< cycle<<endl;
-        return path;
+        return true;
       }
       ++cycle;
     }
 //    cout << "DEBUG: failed in mapping the starting DFG node "<<t_dfg->getID(t_dfgNode)<<" on CGRA node "<<t_fu->getID()<<endl;
   }
 //  cout<<".....in calculate cost path"<<endl;
-//  for (map<CGRANode*, int>::iterator iter=path->begin();
-//        iter!=path->end(); ++iter) {
-//    cout<<"(tile:"<<(*iter).first->getID()<<", cycle:"<<(*iter).second<<") --";
+//  for (int h=0; h<t_path->size(); ++h) {
+//    cout<<"(tile:"<<t_path->getHop(h)->tile->getID()<<", cycle:"<<t_path->getHop(h)->cycle<<") --";
 //  }
 //  cout<<endl;
-  return path;
+  return !t_path->isEmpty();
 }
 
 // Schedule is based on the modulo II, the 'path' contains one
 // predecessor that can be definitely mapped, but the pathes
 // containing other predecessors have possibility to fail in mapping.
 bool Mapper::schedule(CGRA* t_cgra, DFG* t_dfg, int t_II,
-    DFGNode* t_dfgNode, map<CGRANode*, int>* t_path, bool t_isStaticElasticCGRA) {
+    DFGNode* t_dfgNode, Route* t_path, bool t_isStaticElasticCGRA) {
+  ScopedTimer timer("mapper.schedule", false);
+  Counters::add(COUNTER_SCHEDULES);
 
-  map<int, CGRANode*>* reorderPath = getReorderPath(t_path);
-//
-//  // Since cycle on path increases gradually, re-order will not miss anything.
-//  for (map<CGRANode*, int>::iterator iter=t_path->begin(); iter!=t_path->end(); ++iter)
-//    reorderPath[(*iter).second] = (*iter).first;
-//  assert(reorderPath.size() == t_path->size());
+  CGRANode* fu = t_path->getLastHop()->tile;
+  int fuCycle = t_path->getLastHop()->cycle;
+  CGRA_LOG(LOG_MAPPER, LOG_DEBUG)<<"[DEBUG] schedule dfg node["<<t_dfg->getID(t_dfgNode)<<"] onto fu["<<fu->getID()<<"] at cycle "<<fuCycle<<" within II: "<<t_II<<"\n";
 
-  map<int, CGRANode*>::reverse_iterator ri = reorderPath->rbegin();
-  CGRANode* fu = (*ri).second;
-  cout<<"[DEBUG] schedule dfg node["<<t_dfg->getID(t_dfgNode)<<"] onto fu["<<fu->getID()<<"] at cycle "<<(*t_path)[fu]<<" within II: "<<t_II<<endl;
+  // Every write below is journaled, so that a failed schedule (e.g., a
+  // later predecessor cannot be routed) takes back the partial routes.
+  UndoLog* undoLog = t_cgra->getUndoLog();
+  int checkpoint = undoLog->getMark();
 
   // Map the DFG node onto the CGRA nodes across cycles.
-  m_mapping[t_dfgNode] = fu;
+  int index = m_view->getIndex(t_dfgNode);
+  setMapping(index, fu, fuCycle, undoLog);
 
   // FIXME: Checks DVFS-related stuff around the canOccupy(). 1. Make sure the same island has
   // the same DVFS level. 2. The level matches the targeting DFG node. 3. Or no DFG node in the
@@ -445,66 +493,58 @@ bool Mapper::schedule(CGRA* t_cgra, DFG* t_dfg, int t_II,
   if (fu->isDVFSEnabled()) {
     // assert(t_dfgNode->getDVFSLatencyMultiple() == fu->getDVFSLatencyMultiple());
   }
-  fu->setDFGNode(t_dfgNode, (*t_path)[fu], t_II, t_isStaticElasticCGRA);
+  fu->setDFGNode(t_dfgNode, fuCycle, t_II, t_isStaticElasticCGRA);
 
   // FIXME: Handles DVFS-related stuff here.
   t_cgra->syncDVFSIsland(fu);
 
-  m_mappingTiming[t_dfgNode] = (*t_path)[fu];
+  if (m_lowestMappedII == NULL) {
+    undoLog->recordMapped(t_dfgNode);
+    t_dfgNode->setMapped();
+  }
 
   // Route the dataflow onto the CGRA links across cycles.
-  CGRANode* onePredCGRANode;
-  int onePredCGRANodeTiming;
-  map<int, CGRANode*>::iterator previousIter;
-  map<int, CGRANode*>::iterator next;
-  if (reorderPath->size() > 0) {
-    next = reorderPath->begin();
-    if (next != reorderPath->end())
-      ++next;
-  }
-  map<int, CGRANode*>::reverse_iterator riter=reorderPath->rbegin();
+  CGRANode* onePredCGRANode = t_path->getFirstHop()->tile;
+  int onePredCGRANodeTiming = t_path->getFirstHop()->cycle;
   bool generatedOut = true;
-  for (map<int, CGRANode*>::iterator iter=reorderPath->begin();
-      iter!=reorderPath->end(); ++iter) {
-    if (iter != reorderPath->begin()) {
-      CGRANode* srcCGRANode = (*(reorderPath->begin())).second;
-      int srcCycle = (*(reorderPath->begin())).first;
-      CGRALink* l = t_cgra->getLink((*previousIter).second, (*iter).second);
-
-      // Distinguish the bypassed and utilized data delivery on xbar.
-      bool isBypass = false;
-      int duration = (t_II+((*iter).first-(*previousIter).first)%t_II)%t_II;
-      if ((*riter).second != (*iter).second and
-          (*previousIter).first+1 == (*iter).first)
-        isBypass = true;
-      else
-        duration = (m_mappingTiming[t_dfgNode]-(*previousIter).first)%t_II;
-      l->occupy(srcCGRANode->getMappedDFGNode(srcCycle),
-                (*previousIter).first, duration,
-                t_II, isBypass, generatedOut, t_isStaticElasticCGRA);
-      generatedOut = false;
-    } else {
-      onePredCGRANode = (*iter).second;
-      onePredCGRANodeTiming = (*iter).first;
-    }
-    previousIter = iter;
+  for (int h=1; h<t_path->size(); ++h) {
+    RouteHop* previous = t_path->getHop(h-1);
+    RouteHop* current = t_path->getHop(h);
+    // The data just stays on the tile.
+    if (current->link == NULL)
+      continue;
+
+    // Distinguish the bypassed and utilized data delivery on xbar.
+    bool isBypass = false;
+    int duration = (t_II+(current->cycle-previous->cycle)%t_II)%t_II;
+    if (fu != current->tile and previous->cycle+1 == current->cycle)
+      isBypass = true;
+    else
+      duration = (m_mappedCycles[index]-previous->cycle)%t_II;
+    current->link->occupy(onePredCGRANode->getMappedDFGNode(onePredCGRANodeTiming),
+                          previous->cycle, duration,
+                          t_II, isBypass, generatedOut, t_isStaticElasticCGRA);
+    generatedOut = false;
   }
-  delete reorderPath;
 
   // Try to route the path with other predecessors.
   // TODO: should consider the timing for static CGRA (two branches should
   //       joint at the same time or the register file size equals to 1)
-  for (DFGNode* node: *t_dfgNode->getPredNodes()) {
-    if (m_mapping.find(node) != m_mapping.end()) {
-      if (m_mapping[(node)] == onePredCGRANode and
+  const int* preds = m_view->getPreds(index);
+  for (int p=0; p<m_view->getPredCount(index); ++p) {
+    DFGNode* node = m_view->getNode(preds[p]);
+    if (m_mappedTiles[preds[p]] != NULL) {
+      if (m_mappedTiles[preds[p]] == onePredCGRANode and
           onePredCGRANode->getMappedDFGNode(onePredCGRANodeTiming)==node) {
-        cout<<"[DEBUG] skip predecessor routing -- dfgNode: "<<node->getID()<<"\n";
+        CGRA_LOG(LOG_ROUTE, LOG_TRACE)<<"[DEBUG] skip predecessor routing -- dfgNode: "<<node->getID()<<"\n";
         continue;
       }
 //      if (m_mapping[(node)] != onePredCGRANode) {
-      if (!tryToRoute(t_cgra, t_dfg, t_II, node, m_mapping[node], t_dfgNode, fu,
-          m_mappingTiming[t_dfgNode], false, t_isStaticElasticCGRA)){
-        cout<<"DEBUG target DFG node: "<<t_dfgNode->getID()<<" on fu: "<<fu->getID()<<" failed, mapped pred DFG node: "<<node->getID()<<"; return false\n";
+      if (!tryToRoute(t_cgra, t_dfg, t_II, node, m_mappedTiles[preds[p]], t_dfgNode, fu,
+          m_mappedCycles[index], false, t_isStaticElasticCGRA)){
+        CGRA_LOG(LOG_MAPPER, LOG_DEBUG)<<"DEBUG target DFG node: "<<t_dfgNode->getID()<<" on fu: "<<fu->getID()<<" failed, mapped pred DFG node: "<<node->getID()<<"; return false\n";
+        Counters::add(COUNTER_SCHEDULE_FAILS_PRED_ROUTE);
+        undoLog->rollback(checkpoint);
         return false;
       }
 //    }
@@ -513,18 +553,22 @@ bool Mapper::schedule(CGRA* t_cgra, DFG* t_dfg, int t_II,
 
   // Try to route the path with the mapped successors that are only in
   // certain cycle.
-  for (DFGNode* node: *t_dfgNode->getSuccNodes()) {
-    if (m_mapping.find(node) != m_mapping.end()) {
+  const int* succs = m_view->getSuccs(index);
+  for (int s=0; s<m_view->getSuccCount(index); ++s) {
+    DFGNode* node = m_view->getNode(succs[s]);
+    if (m_mappedTiles[succs[s]] != NULL) {
       bool bothNodesInCycle = false;
-      if (node->shareSameCycle(t_dfgNode) and
-          node->isCritical() and t_dfgNode->isCritical()) {//getCycleID() != -1 and
+      if (m_view->shareSameCycle(succs[s], index) and
+          m_view->isCritical(succs[s]) and m_view->isCritical(index)) {//getCycleID() != -1 and
 //          node->isCritical() and t_dfgNode->isCritical() and
 //          node->getCycleID() == t_dfgNode->getCycleID()) {
         bothNodesInCycle = true;
       }
-      if (!tryToRoute(t_cgra, t_dfg, t_II, t_dfgNode, fu, node, m_mapping[node],
-          m_mappingTiming[node], bothNodesInCycle, t_isStaticElasticCGRA)) {
-        cout<<"DEBUG target DFG node: "<<t_dfgNode->getID()<<" on fu: "<<fu->getID()<<" failed, mapped succ DFG node: "<<node->getID()<<"; return false\n";
+      if (!tryToRoute(t_cgra, t_dfg, t_II, t_dfgNode, fu, node, m_mappedTiles[succs[s]],
+          m_mappedCycles[succs[s]], bothNodesInCycle, t_isStaticElasticCGRA)) {
+        CGRA_LOG(LOG_MAPPER, LOG_DEBUG)<<"DEBUG target DFG node: "<<t_dfgNode->getID()<<" on fu: "<<fu->getID()<<" failed, mapped succ DFG node: "<<node->getID()<<"; return false\n";
+        Counters::add(COUNTER_SCHEDULE_FAILS_SUCC_ROUTE);
+        undoLog->rollback(checkpoint);
         return false;
       }
     }
@@ -539,6 +583,7 @@ int Mapper::getMaxMappingCycle() {
 void Mapper::showUtilization(CGRA* t_cgra, DFG* t_dfg, int t_II,
 		             bool t_isStaticElasticCGRA,
 			     bool t_enablePowerGating) {
+  ScopedTimer timer("output.utilization");
 
   // Indicates the busy cycles of the functional units inside the
   // tile.
@@ -681,8 +726,8 @@ void Mapper::showUtilization(CGRA* t_cgra, DFG* t_dfg, int t_II,
   avg_tile_xbar_utilization /= total_active_tiles;
   //max_tile_overall_utilization /= total_active_tiles;
 
-  cout << "tile avg fu utilization: " << avg_tile_fu_utilization*100 << "%; avg xbar utilization: " << avg_tile_xbar_utilization*100 << "%; avg overall utilization: " << avg_tile_overall_utilization*t_II*100 << "%" << endl;
-  cout << "max overall utilization: " << max_tile_overall_utilization*t_II*100 << "%" << endl;
+  CGRA_LOG(LOG_MAPPER, LOG_INFO) << "tile avg fu utilization: " << avg_tile_fu_utilization*100 << "%; avg xbar utilization: " << avg_tile_xbar_utilization*100 << "%; avg overall utilization: " << avg_tile_overall_utilization*t_II*100 << "%\n";
+  CGRA_LOG(LOG_MAPPER, LOG_INFO) << "max overall utilization: " << max_tile_overall_utilization*t_II*100 << "%\n";
 
   // Collects the histogram of tiles' utilization.
   // Histogram for the number of tiles that have utilization of 0%.
@@ -736,10 +781,10 @@ void Mapper::showUtilization(CGRA* t_cgra, DFG* t_dfg, int t_II,
     }
   }
 
-  std::cout << "histogram 0% tile utilization: " << tile_count_0 << endl;
-  std::cout << "histogram (0%, 25%] tile utilization: " << tile_count_0_to_25 << endl;
-  std::cout << "histogram (25%, 50%] tile utilization: " << tile_count_25_to_50 << endl;
-  std::cout << "histogram (50%, 100%] tile utilization: " << tile_count_50_to_100 << endl;
+  CGRA_LOG(LOG_MAPPER, LOG_INFO) << "histogram 0% tile utilization: " << tile_count_0 << "\n";
+  CGRA_LOG(LOG_MAPPER, LOG_INFO) << "histogram (0%, 25%] tile utilization: " << tile_count_0_to_25 << "\n";
+  CGRA_LOG(LOG_MAPPER, LOG_INFO) << "histogram (25%, 50%] tile utilization: " << tile_count_25_to_50 << "\n";
+  CGRA_LOG(LOG_MAPPER, LOG_INFO) << "histogram (50%, 100%] tile utilization: " << tile_count_50_to_100 << "\n";
 
   // std::cout << "histogram [0%, 25%] island utilization: " << island_count_0_to_25 << endl;
   // std::cout << "histogram (25%, 50%] island utilization: " << island_count_25_to_50 << endl;
@@ -803,7 +848,7 @@ void Mapper::showUtilization(CGRA* t_cgra, DFG* t_dfg, int t_II,
   float avg_tile_dvfs_ratio = 0.0;
   for (auto const& tile_ratio : tile_dvfs_ratio) {
     avg_tile_dvfs_ratio += tile_ratio.second;
-    cout << "tile " << tile_ratio.first << " DVFS frequency level: " << tile_ratio.second * 100 << "%" << endl;
+    CGRA_LOG(LOG_DVFS, LOG_INFO) << "tile " << tile_ratio.first << " DVFS frequency level: " << tile_ratio.second * 100 << "%\n";
   }
 
   if (avg_tile_dvfs_ratio == 0) {
@@ -840,20 +885,21 @@ void Mapper::showUtilization(CGRA* t_cgra, DFG* t_dfg, int t_II,
     }
   }
 
-  std::cout << "histogram 0% tile DVFS frequency ratio: " << tile_count_dvfs_ratio_0 << endl;
-  std::cout << "histogram 25% tile DVFS frequency ratio: " << tile_count_dvfs_ratio_25 << endl;
-  std::cout << "histogram 50% tile DVFS frequency ratio: " << tile_count_dvfs_ratio_50 << endl;
+  CGRA_LOG(LOG_DVFS, LOG_INFO) << "histogram 0% tile DVFS frequency ratio: " << tile_count_dvfs_ratio_0 << "\n";
+  CGRA_LOG(LOG_DVFS, LOG_INFO) << "histogram 25% tile DVFS frequency ratio: " << tile_count_dvfs_ratio_25 << "\n";
+  CGRA_LOG(LOG_DVFS, LOG_INFO) << "histogram 50% tile DVFS frequency ratio: " << tile_count_dvfs_ratio_50 << "\n";
   if (avg_tile_dvfs_ratio == 0) {
     // Indicates DVFS mode is not enabled. Then, by default, the DVFS level is 100% for all the tiles.
     // I don't think this will be executed.
-    std::cout << "histogram 100% tile DVFS frequency ratio: " << t_cgra->getFUCount() << endl;
+    CGRA_LOG(LOG_DVFS, LOG_INFO) << "histogram 100% tile DVFS frequency ratio: " << t_cgra->getFUCount() << "\n";
   } else {
-    std::cout << "histogram 100% tile DVFS frequency ratio: " << tile_count_dvfs_ratio_100 << endl;
+    CGRA_LOG(LOG_DVFS, LOG_INFO) << "histogram 100% tile DVFS frequency ratio: " << tile_count_dvfs_ratio_100 << "\n";
   }
 }
 
 void Mapper::showSchedule(CGRA* t_cgra, DFG* t_dfg, int t_II,
     bool t_isStaticElasticCGRA, bool t_parameterizableCGRA) {
+  ScopedTimer timer("output.schedule");
 
   // tiles and links are in different formats (only used for
   // parameterizable CGRA, i.e., CGRA-Flow mapping demonstration).
@@ -903,23 +949,23 @@ void Mapper::showSchedule(CGRA* t_cgra, DFG* t_dfg, int t_II,
       }
     }
 
-    cout<<"--------------------------- cycle:"<<cycle<<" ---------------------------"<<endl;
+    CGRA_LOG(LOG_MAPPER, LOG_INFO)<<"--------------------------- cycle:"<<cycle<<" ---------------------------\n";
     for (int i=0; i<t_cgra->getRows(); ++i) {
       for (int j=0; j<t_cgra->getColumns(); ++j) {
 
         // Display the CGRA node occupancy.
         bool fu_occupied = false;
         DFGNode* dfgNode;
-        for (DFGNode* currentDFGNode: t_dfg->nodes) {
-          if (m_mappingTiming[currentDFGNode] == cycle and
-              m_mapping[currentDFGNode] == t_cgra->nodes[i][j]) {
+        for (int mapped: *getMappedDFGNodes(t_cgra->nodes[i][j])) {
+          DFGNode* currentDFGNode = m_view->getNode(mapped);
+          if (m_mappedCycles[mapped] == cycle) {
             fu_occupied = true;
             dfgNode = currentDFGNode;
             break;
-          } else if (m_mapping[currentDFGNode] == t_cgra->nodes[i][j]) {
+          } else {
             int temp_cycle = cycle - t_II;
             while (temp_cycle >= 0) {
-              if (m_mappingTiming[currentDFGNode] == temp_cycle) {
+              if (m_mappedCycles[mapped] == temp_cycle) {
                 fu_occupied = true;
                 dfgNode = currentDFGNode;
                 break;
@@ -1005,7 +1051,7 @@ void Mapper::showSchedule(CGRA* t_cgra, DFG* t_dfg, int t_II,
 //    for (int i=0; i<displayRows; ++i) {
     for (int i=displayRows-1; i>=0; --i) {
       for (int j=0; j<displayColumns; ++j) {
-        cout<<display[i][j];
+        CGRA_LOG(LOG_MAPPER, LOG_INFO)<<display[i][j];
       }
     }
     ++cycle;
@@ -1024,6 +1070,7 @@ void Mapper::showSchedule(CGRA* t_cgra, DFG* t_dfg, int t_II,
 
 void Mapper::generateJSON(CGRA* t_cgra, DFG* t_dfg, int t_II,
     bool t_isStaticElasticCGRA) {
+  ScopedTimer timer("output.config");
   ofstream jsonFile;
   jsonFile.open("config.json");
   jsonFile<<"[\n";
@@ -1035,10 +1082,9 @@ void Mapper::generateJSON(CGRA* t_cgra, DFG* t_dfg, int t_II,
         for (int j=0; j<t_cgra->getColumns(); ++j) {
           CGRANode* currentCGRANode = t_cgra->nodes[i][j];
           DFGNode* targetDFGNode = NULL;
-          for (DFGNode* dfgNode: t_dfg->nodes) {
-            if (m_mapping[dfgNode] == currentCGRANode and
-                currentCGRANode->getMappedDFGNode(t) == dfgNode) {
-              targetDFGNode = dfgNode;
+          for (int mapped: *getMappedDFGNodes(currentCGRANode)) {
+            if (currentCGRANode->getMappedDFGNode(t) == m_view->getNode(mapped)) {
+              targetDFGNode = m_view->getNode(mapped);
               break;
             }
           }
@@ -1169,9 +1215,10 @@ void Mapper::generateJSON(CGRA* t_cgra, DFG* t_dfg, int t_II,
                   if (il->isOccupied(t_tmp, t_II, t_isStaticElasticCGRA) and
                       il->isBypass(t_tmp) and
                       il->getMappedDFGNode(t_tmp) == ol->getMappedDFGNode(next_t)) {
-                    cout<<"[DEBUG] inside roi for CGRA node "<<currentCGRANode->getID()<<"...\n";
-                    if (il->getMappedDFGNode(t_tmp) == NULL)
-                      cout<<"[DEBUG] none..."<<il->getMappedDFGNode(t_tmp)<<"\n";
+                    CGRA_LOG(LOG_MAPPER, LOG_DEBUG)<<"[DEBUG] inside roi for CGRA node "<<currentCGRANode->getID()<<"...\n";
+                    if (il->getMappedDFGNode(t_tmp) == NULL) {
+                      CGRA_LOG(LOG_MAPPER, LOG_DEBUG)<<"[DEBUG] none..."<<il->getMappedDFGNode(t_tmp)<<"\n";
+                    }
                     stringDst[outIndex] = to_string(il->getDirectionID(currentCGRANode));//+"; t_tmp: "+to_string(t_tmp)+"; dfg node: " + to_string(il->getMappedDFGNode(t_tmp)->getID());
                   }
                 }
@@ -1200,11 +1247,9 @@ void Mapper::generateJSON(CGRA* t_cgra, DFG* t_dfg, int t_II,
     for (int j=0; j<t_cgra->getColumns(); ++j) {
       CGRANode* currentCGRANode = t_cgra->nodes[i][j];
       DFGNode* targetDFGNode = NULL;
-      for (DFGNode* dfgNode: t_dfg->nodes) {
-        if (m_mapping[dfgNode] == currentCGRANode) {
-          targetDFGNode = dfgNode;
-          break;
-        }
+      vector<int>* mappedNodes = getMappedDFGNodes(currentCGRANode);
+      if (!mappedNodes->empty()) {
+        targetDFGNode = m_view->getNode(mappedNodes->front());
       }
       list<CGRALink*>* inLinks = currentCGRANode->getInLinks();
       list<CGRALink*>* outLinks = currentCGRANode->getOutLinks();
@@ -1361,31 +1406,30 @@ bool Mapper::tryToRoute(CGRA* t_cgra, DFG* t_dfg, int t_II,
     DFGNode* t_srcDFGNode, CGRANode* t_srcCGRANode, DFGNode* t_dstDFGNode,
     CGRANode* t_dstCGRANode, int t_dstCycle, bool t_isBackedge,
     bool t_isStaticElasticCGRA) {
-  cout<<"[DEBUG] tryToRoute -- srcDFGNode: "<<t_srcDFGNode->getID()<<", srcCGRANode: "<<t_srcCGRANode->getID()<<"; dstDFGNode: "<<t_dstDFGNode->getID()<<", dstCGRANode: "<<t_dstCGRANode->getID()<<"; backEdge: "<<t_isBackedge<<endl;
-  list<CGRANode*> searchPool;
-  map<CGRANode*, int> distance;
-  map<CGRANode*, int> timing;
-  map<CGRANode*, CGRANode*> previous;
-  timing[t_srcCGRANode] = m_mappingTiming[t_srcDFGNode];
+  ScopedTimer timer("route.tryToRoute", false);
+  Counters::add(COUNTER_TRY_TO_ROUTE);
+  CGRA_LOG(LOG_ROUTE, LOG_DEBUG)<<"[DEBUG] tryToRoute -- srcDFGNode: "<<t_srcDFGNode->getID()<<", srcCGRANode: "<<t_srcCGRANode->getID()<<"; dstDFGNode: "<<t_dstDFGNode->getID()<<", dstCGRANode: "<<t_dstCGRANode->getID()<<"; backEdge: "<<t_isBackedge<<"\n";
   // Check whether the II is violated on each cycle.
-  if (t_srcDFGNode->shareSameCycle(t_dstDFGNode)) {
-    list<list<DFGNode*>*>* dfgNodeCycles = t_dfg->getCycleLists();
-    for (list<DFGNode*>* cycle: *dfgNodeCycles) {
-      bool foundSrc = (find(cycle->begin(), cycle->end(), t_srcDFGNode) != cycle->end());
-      bool foundDst = (find(cycle->begin(), cycle->end(), t_dstDFGNode) != cycle->end());
-      if (!foundSrc or !foundDst) {
-        continue;
-      }
+  int srcIndex = m_view->getIndex(t_srcDFGNode);
+  int dstIndex = m_view->getIndex(t_dstDFGNode);
+  if (m_view->shareSameCycle(srcIndex, dstIndex)) {
+    vector<int> commonCycles;
+    m_view->getCommonCycles(srcIndex, dstIndex, &commonCycles);
+    for (int c: commonCycles) {
+      const int* cycle = m_view->getCycle(c);
+      int cycleSize = m_view->getCycleSize(c);
       int totalTime = 0;
-      DFGNode* lastDFGNode = cycle->back();
-      for (DFGNode* dfgNode: *cycle) {
-        if (m_mappingTiming.find(dfgNode) == m_mappingTiming.end() or
-            m_mappingTiming.find(lastDFGNode) == m_mappingTiming.end()) {
+      // The nodes no longer in the DFG (-1) are never mapped.
+      int lastDFGNode = cycle[cycleSize-1];
+      for (int k=0; k<cycleSize; ++k) {
+        int dfgNode = cycle[k];
+        if (dfgNode == -1 or m_mappedCycles[dfgNode] == -1 or
+            lastDFGNode == -1 or m_mappedCycles[lastDFGNode] == -1) {
           totalTime = 0;
           break;
         } else {
-          int t1 = m_mappingTiming[lastDFGNode];
-          int t2 = m_mappingTiming[dfgNode];
+          int t1 = m_mappedCycles[lastDFGNode];
+          int t2 = m_mappedCycles[dfgNode];
           while (t1 >= t2) {
             t2 += t_II;
           }
@@ -1394,141 +1438,80 @@ bool Mapper::tryToRoute(CGRA* t_cgra, DFG* t_dfg, int t_II,
         lastDFGNode = dfgNode;
       }
       if (totalTime > t_II) {
-        cout<<"[DEBUG] cannot route due to II is violated for backward cycle"<<endl;
+        CGRA_LOG(LOG_ROUTE, LOG_DEBUG)<<"[DEBUG] cannot route due to II is violated for backward cycle\n";
+        Counters::add(COUNTER_ROUTE_FAILS_II_VIOLATION);
         return false;
       }
     }
   }
-  for (int i=0; i<t_cgra->getRows(); ++i) {
-    for (int j=0; j<t_cgra->getColumns(); ++j) {
-      CGRANode* node = t_cgra->nodes[i][j];
-      distance[node] = m_maxMappingCycle;
-      timing[node] = timing[t_srcCGRANode];
-      timing[node] += t_srcDFGNode->getExecLatency(node->getDVFSLatencyMultiple()) - 1;
-//      if (t_srcDFGNode->isLoad() or t_srcDFGNode->isStore()) {
-//        timing[node] += 1;
-//      }
-      previous[node] = NULL;
-      searchPool.push_back(t_cgra->nodes[i][j]);
-    }
-  }
-  distance[t_srcCGRANode] = 0;
-  while (searchPool.size()!=0) {
-    int minCost = m_maxMappingCycle + 1;
-    CGRANode* minNode;
-    for (CGRANode* currentNode: searchPool) {
-      if (distance[currentNode] < minCost) {
-        minCost = distance[currentNode];
-        minNode = currentNode;
-      }
-    }
-    searchPool.remove(minNode);
-    // found the target point in the shortest path
-    if (minNode == t_dstCGRANode) {
-      if (previous[minNode] == NULL)
-        break;
-    }
-    list<CGRANode*>* currentNeighbors = minNode->getNeighbors();
-
-    for (CGRANode* neighbor: *currentNeighbors) {
-      int cycle = timing[minNode];
-      while (1) {
-        CGRALink* currentLink = minNode->getOutLink(neighbor);
-        // TODO: should also consider the cost of the register file
-        if (currentLink->canOccupy(t_srcDFGNode, t_srcCGRANode, cycle, t_II)) {
-          // rough estimate the cost based on the suspend cycle
-          int cost = distance[minNode] + (cycle - timing[minNode]) + 1;
-          if (cost < distance[neighbor]) {
-            distance[neighbor] = cost;
-            timing[neighbor] = cycle + 1;
-            previous[neighbor] = minNode;
-          }
-          break;
-        }
-        ++cycle;
-        if(cycle > m_maxMappingCycle)
-          break;
-      }
-    }
-  }
+  Router router(t_cgra);
+  router.search(t_srcDFGNode, t_srcCGRANode, m_mappedCycles[srcIndex],
+                t_II, m_maxMappingCycle, t_dstCGRANode);
 
   // Construct the shortest path for routing.
-  map<CGRANode*, int> path;
-  CGRANode* u = t_dstCGRANode;
-  if (previous[u] != NULL or u == t_srcCGRANode) {
-    while (u != NULL) {
-      path[u] = timing[u];
-      u = previous[u];
-    }
-  } else {
-    cout<<"[DEBUG] cannot route due to a path cannot be constructed"<<endl;
+  Route path;
+  router.getRoute(t_dstCGRANode, router.getTiming(t_dstCGRANode), &path);
+  if (path.isEmpty()) {
+    CGRA_LOG(LOG_ROUTE, LOG_DEBUG)<<"[DEBUG] cannot route due to a path cannot be constructed\n";
+    Counters::add(COUNTER_ROUTE_FAILS_NO_PATH);
     return false;
   }
 
   // Not a valid mapping if it exceeds the 'm_maxMappingCycle'.
   // I don't think we need check II here.
-  if(timing[t_dstCGRANode] > m_maxMappingCycle) {
+  if(router.getTiming(t_dstCGRANode) > m_maxMappingCycle) {
     // timing[t_dstCGRANode] - timing[t_srcCGRANode] > t_II) {
     // cout<<"[DEBUG] cannot route due to II violation case 2: timing[CGRANode "<<t_dstCGRANode->getID()<<"] "<<timing[t_dstCGRANode]<<" - timing[CGRANode "<<t_srcCGRANode->getID()<<"] "<<timing[t_srcCGRANode]<<" > II "<<t_II<<endl;
+    Counters::add(COUNTER_ROUTE_FAILS_TOO_LATE);
     return false;
   }
 
 
 //  if (timing[t_dstCGRANode]%t_II >= t_dstCycle%t_II)
   // Try to route the data flow.
-  map<int, CGRANode*>* reorderPath = getReorderPath(&path);
-//  //Since the cycle on path increases gradually, re-order will not miss anything.
-//  for(map<CGRANode*, int>::iterator iter=path.begin(); iter!=path.end(); ++iter) {
-//    reorderPath[(*iter).second] = (*iter).first;
-//  }
-//  assert(reorderPath.size() == path.size());
-
-  map<int, CGRANode*>::iterator previousIter;
-  map<int, CGRANode*>::reverse_iterator riter = reorderPath->rbegin();
-  cout<<"[DEBUG] check route size: "<<reorderPath->size()<<"\n";
-  if (reorderPath->size() == 1) {
-    int duration = (t_II+(t_dstCycle-(*riter).first)%t_II)%t_II;
-    cout<<"[DEBUG] allocate for local reg maintain... duration="<<duration<<" last cycle: "<<(*riter).first<<"\n";
-    (*riter).second->allocateReg(4, (*riter).first, duration, t_II);
+  RouteHop* lastHop = path.getLastHop();
+  CGRA_LOG(LOG_ROUTE, LOG_TRACE)<<"[DEBUG] check route size: "<<path.size()<<"\n";
+  if (path.isLocal()) {
+    int duration = (t_II+(t_dstCycle-lastHop->cycle)%t_II)%t_II;
+    CGRA_LOG(LOG_ROUTE, LOG_TRACE)<<"[DEBUG] allocate for local reg maintain... duration="<<duration<<" last cycle: "<<lastHop->cycle<<"\n";
+    lastHop->tile->allocateReg(4, lastHop->cycle, duration, t_II);
   }
   bool generatedOut = true;
-  for (map<int, CGRANode*>::iterator iter = reorderPath->begin();
-      iter!=reorderPath->end(); ++iter) {
-    if (iter != reorderPath->begin()) {
-      CGRALink* l = t_cgra->getLink((*previousIter).second, (*iter).second);
-      bool isBypass = false;
-      int duration = ((*iter).first-(*previousIter).first)%t_II;
-      if ((*riter).second != (*iter).second and
-          (*previousIter).first+1 == (*iter).first)
-        isBypass = true;
-      else {
-        duration = (t_II+(t_dstCycle-(*previousIter).first)%t_II)%t_II;
-        cout<<"[DEBUG] reset duration: "<<duration<<" t_dstCycle: "<<t_dstCycle<<" previous: "<<(*previousIter).first<<" II: "<<t_II<<"\n";
-      }
-      if (duration == 0) {
-        cout<<"[DEBUG] reset duration is 0...\n";
-        // The successor can only be done within an interval of II, otherwise
-        // the II is no longer II but II*2.
-        if (t_isBackedge) {
-          cout<<"[DEBUG] cannot route due to backedge"<<endl;
-          return false;
-        }
-        duration = t_II;
+  for (int h=1; h<path.size(); ++h) {
+    RouteHop* previous = path.getHop(h-1);
+    RouteHop* current = path.getHop(h);
+    if (current->link == NULL)
+      continue;
+    bool isBypass = false;
+    int duration = (current->cycle-previous->cycle)%t_II;
+    if (lastHop->tile != current->tile and
+        previous->cycle+1 == current->cycle)
+      isBypass = true;
+    else {
+      duration = (t_II+(t_dstCycle-previous->cycle)%t_II)%t_II;
+      CGRA_LOG(LOG_ROUTE, LOG_TRACE)<<"[DEBUG] reset duration: "<<duration<<" t_dstCycle: "<<t_dstCycle<<" previous: "<<previous->cycle<<" II: "<<t_II<<"\n";
+    }
+    if (duration == 0) {
+      CGRA_LOG(LOG_ROUTE, LOG_TRACE)<<"[DEBUG] reset duration is 0...\n";
+      // The successor can only be done within an interval of II, otherwise
+      // the II is no longer II but II*2.
+      if (t_isBackedge) {
+        CGRA_LOG(LOG_ROUTE, LOG_DEBUG)<<"[DEBUG] cannot route due to backedge\n";
+        Counters::add(COUNTER_ROUTE_FAILS_BACKEDGE);
+        return false;
       }
-      l->occupy(t_srcDFGNode, (*previousIter).first,
-                duration, t_II, isBypass, generatedOut, t_isStaticElasticCGRA);
-      generatedOut = false;
+      duration = t_II;
     }
-    previousIter = iter;
+    current->link->occupy(t_srcDFGNode, previous->cycle,
+                          duration, t_II, isBypass, generatedOut, t_isStaticElasticCGRA);
+    generatedOut = false;
   }
 
-  map<int, CGRANode*>::iterator begin = reorderPath->begin();
-  map<int, CGRANode*>::reverse_iterator end = reorderPath->rbegin();
-
   // Check whether the backward data can be delivered within II.
   if (!t_isStaticElasticCGRA) {
-    if (t_isBackedge and (*end).first - (*begin).first >= t_II) {
-      cout<<"[DEBUG] cannot route due to backedge data cannot be delivered in time"<<endl;
+    if (t_isBackedge and lastHop->cycle - path.getFirstHop()->cycle >= t_II) {
+      CGRA_LOG(LOG_ROUTE, LOG_DEBUG)<<"[DEBUG] cannot route due to backedge data cannot be delivered in time\n";
+      Counters::add(COUNTER_ROUTE_FAILS_BACKEDGE);
       return false;
     }
   }
@@ -1537,85 +1520,87 @@ bool Mapper::tryToRoute(CGRA* t_cgra, DFG* t_dfg, int t_II,
 
 int Mapper::heuristicMap(CGRA* t_cgra, DFG* t_dfg, int t_II,
     bool t_isStaticElasticCGRA) {
-  bool fail = false;
   while (1) {
-    cout<<"----------------------------------------\n";
-    cout<<"[DEBUG] start heuristic algorithm with II="<<t_II<<"\n";
-    int cycle = 0;
-    constructMRRG(t_dfg, t_cgra, t_II);
-    fail = false;
-    for (list<DFGNode*>::iterator dfgNode=t_dfg->nodes.begin();
-        dfgNode!=t_dfg->nodes.end(); ++dfgNode) {
-      
-      list<map<CGRANode*, int>*> paths;
-
-      #pragma omp parallel
-      {
-          list<map<CGRANode*, int>*> paths_private;
-          #pragma omp for collapse(2) nowait
-          for (int i=0; i<t_cgra->getRows(); ++i) {
-            for (int j=0; j<t_cgra->getColumns(); ++j) {
-              CGRANode* fu = t_cgra->nodes[i][j];
-              map<CGRANode*, int>* tempPath =
-                  calculateCost(t_cgra, t_dfg, t_II, *dfgNode, fu);
-              if(tempPath != NULL && tempPath->size() != 0) {
-                paths_private.push_back(tempPath);
-              }
-            }
-          }
-          #pragma omp critical
-          {
-              paths.splice(paths.end(), paths_private);
-          }
-      }
-      // Found some potential mappings.
-      if (paths.size() != 0) {
-        map<CGRANode*, int>* optimalPath =
-            getPathWithMinCostAndConstraints(t_cgra, t_dfg, t_II, *dfgNode, &paths);
-        if (optimalPath->size() != 0) {
-          if (!schedule(t_cgra, t_dfg, t_II, *dfgNode, optimalPath,
-              t_isStaticElasticCGRA)) {
-            cout<<"[DEBUG] fail1 in schedule() II: "<<t_II<<"\n";
-            for (map<CGRANode*,int>::iterator iter = optimalPath->begin();
-                iter!=optimalPath->end(); ++iter) {
-              cout<<"[DEBUG] the failed path -- cycle: "<<(*iter).second<<" CGRANode: "<<(*iter).first->getID()<<"\n";
-            }
+    if (heuristicMapII(t_cgra, t_dfg, t_II, t_isStaticElasticCGRA))
+      return t_II;
+    else if (t_isStaticElasticCGRA)
+      return -1;
+    ++t_II;
+  }
+}
 
-            fail = true;
-            break;
+// One attempt of the heuristic mapping with the given II.
+bool Mapper::heuristicMapII(CGRA* t_cgra, DFG* t_dfg, int t_II,
+    bool t_isStaticElasticCGRA) {
+  CGRA_LOG(LOG_MAPPER, LOG_INFO)<<"----------------------------------------\n";
+  CGRA_LOG(LOG_MAPPER, LOG_INFO)<<"[DEBUG] start heuristic algorithm with II="<<t_II<<"\n";
+  ScopedTimer timer("mapper.heuristicII", true, t_II);
+  constructMRRG(t_dfg, t_cgra, t_II);
+  for (list<DFGNode*>::iterator dfgNode=t_dfg->nodes.begin();
+      dfgNode!=t_dfg->nodes.end(); ++dfgNode) {
+    if (isProbeCancelled(t_II))
+      return false;
+
+    RoutingContext* context = createRoutingContext(t_cgra, t_II, *dfgNode);
+
+    // Only the tiles supporting the DFG node are candidates. Each one
+    // writes its own slot, the paths are then collected in tile order so
+    // that the result does not depend on the number of threads or on how
+    // they are scheduled.
+    vector<CGRANode*> candidates;
+    t_cgra->getSupportingNodes(*dfgNode, &candidates);
+    vector<Route> tilePaths(candidates.size());
+    {
+      ScopedTimer routeTimer("route.candidates", false);
+      #pragma omp parallel for
+      for (int i=0; i<(int)candidates.size(); ++i) {
+        calculateCost(t_cgra, t_dfg, candidates[i], context, &tilePaths[i]);
+      }
+    }
+    delete context;
+    vector<Route*> paths;
+    for (Route& tempPath: tilePaths) {
+      if (!tempPath.isEmpty()) {
+        paths.push_back(&tempPath);
+      }
+    }
+    // Found some potential mappings.
+    if (paths.size() != 0) {
+      Route* optimalPath =
+          getPathWithMinCostAndConstraints(t_cgra, t_dfg, t_II, *dfgNode, &paths);
+      if (optimalPath != NULL) {
+        if (!schedule(t_cgra, t_dfg, t_II, *dfgNode, optimalPath,
+            t_isStaticElasticCGRA)) {
+          CGRA_LOG(LOG_MAPPER, LOG_DEBUG)<<"[DEBUG] fail1 in schedule() II: "<<t_II<<"\n";
+          for (int h=0; h<optimalPath->size(); ++h) {
+            CGRA_LOG(LOG_MAPPER, LOG_DEBUG)<<"[DEBUG] the failed path -- cycle: "<<optimalPath->getHop(h)->cycle<<" CGRANode: "<<optimalPath->getHop(h)->tile->getID()<<"\n";
           }
-          cout<<"[DEBUG] success in schedule()\n";
-        } else {
-          cout<<"[DEBUG] fail2 in schedule() II: "<<t_II<<"\n";
-          fail = true;
-          break;
+          return false;
         }
+        CGRA_LOG(LOG_MAPPER, LOG_DEBUG)<<"[DEBUG] success in schedule()\n";
       } else {
-        fail = true;
-        cout<<"[DEBUG] *else* no available path for DFG node "<<(*dfgNode)->getID()
-            <<" within II "<<t_II<<".\n";
-        break;
+        CGRA_LOG(LOG_MAPPER, LOG_DEBUG)<<"[DEBUG] fail2 in schedule() II: "<<t_II<<"\n";
+        return false;
       }
+    } else {
+      CGRA_LOG(LOG_MAPPER, LOG_DEBUG)<<"[DEBUG] *else* no available path for DFG node "<<(*dfgNode)->getID()
+          <<" within II "<<t_II<<".\n";
+      return false;
     }
-    if (!fail)
-      break;
-    else if (t_isStaticElasticCGRA) {
-      break;
-    }
-    ++t_II;
   }
-  if (!fail)
-    return t_II;
-  else
-    return -1;
+  timer.setSuccess(true);
+  return true;
 }
 
 int Mapper::exhaustiveMap(CGRA* t_cgra, DFG* t_dfg, int t_II,
     bool t_isStaticElasticCGRA) {
-  list<map<CGRANode*, int>*>* exhaustivePaths = new list<map<CGRANode*, int>*>();
-  list<DFGNode*>* mappedDFGNodes = new list<DFGNode*>();
-  bool success = DFSMap(t_cgra, t_dfg, t_II, mappedDFGNodes,
-      exhaustivePaths, t_isStaticElasticCGRA);
+  list<Route> exhaustivePaths;
+  list<DFGNode*> mappedDFGNodes;
+  ScopedTimer timer("mapper.exhaustiveII", true, t_II);
+  constructMRRG(t_dfg, t_cgra, t_II);
+  bool success = DFSMap(t_cgra, t_dfg, t_II, &mappedDFGNodes,
+      &exhaustivePaths, t_isStaticElasticCGRA);
+  timer.setSuccess(success);
   if (success)
     return t_II;
   else
@@ -1624,110 +1609,72 @@ int Mapper::exhaustiveMap(CGRA* t_cgra, DFG* t_dfg, int t_II,
 
 bool Mapper::DFSMap(CGRA* t_cgra, DFG* t_dfg, int t_II,
     list<DFGNode*>* t_mappedDFGNodes,
-    list<map<CGRANode*, int>*>* t_exhaustivePaths,
+    list<Route>* t_exhaustivePaths,
     bool t_isStaticElasticCGRA) {
 //  , DFGNode* t_badMappedDFGNode) {
 
-//  list<map<CGRANode*, int>*>* exhaustivePaths = t_exhaustivePaths;
-
-  constructMRRG(t_dfg, t_cgra, t_II);
-
-//  list<DFGNode*> dfgNodeSearchPool;
-//  for (list<DFGNode*>::iterator dfgNodeItr=dfg->nodes.begin();
-//      dfgNodeItr!=dfg->nodes.end(); ++dfgNodeItr) {
-//    dfgNodeSearchPool.push_back(*dfgNodeItr);
-//  }
 
-  list<DFGNode*>::iterator mappedDFGNodeItr = t_mappedDFGNodes->begin();
-  list<DFGNode*>::iterator dfgNodeItr = t_dfg->nodes.begin();
-//  list<DFGNode*>::iterator dfgNodeItr = t_dfg->getDFSOrderedNodes()->begin();
-  for (map<CGRANode*, int>* path: *t_exhaustivePaths) {
-    if (!schedule(t_cgra, t_dfg, t_II, *mappedDFGNodeItr, path,
-        t_isStaticElasticCGRA)) {
-      cout<<"DEBUG <this is impossible> fail3 in DFS() II: "<<t_II<<"\n";
-      assert(0);
-      break;
-    }
-    ++mappedDFGNodeItr;
-//    dfgNodeSearchPool.remove(*dfgNodeItr);
-    ++dfgNodeItr;
-  }
-//  if (dfgNodeSearchPool.size() == 0) {
-  if (dfgNodeItr == t_dfg->nodes.end())
+  // The MRRG already holds the schedules of the mapped DFG nodes, the
+  // search continues with the next DFG node in order.
+  if (t_mappedDFGNodes->size() == t_dfg->nodes.size())
     return true;
-//  }
+  list<DFGNode*>::iterator dfgNodeItr = t_dfg->nodes.begin();
+  advance(dfgNodeItr, t_mappedDFGNodes->size());
 
   DFGNode* targetDFGNode = *dfgNodeItr;
 
-  list<map<CGRANode*, int>*> paths;
-  for (int i=0; i<t_cgra->getRows(); ++i) {
-    for (int j=0; j<t_cgra->getColumns(); ++j) {
-      CGRANode* fu = t_cgra->nodes[i][j];
-      map<CGRANode*, int>* tempPath =
-          calculateCost(t_cgra, t_dfg, t_II, targetDFGNode, fu);
-      if(tempPath != NULL and tempPath->size() != 0) {
-        paths.push_back(tempPath);
+  RoutingContext* context =
+      createRoutingContext(t_cgra, t_II, targetDFGNode);
+  vector<CGRANode*> candidates;
+  t_cgra->getSupportingNodes(targetDFGNode, &candidates);
+  vector<Route> tilePaths(candidates.size());
+  vector<Route*> paths;
+  {
+    ScopedTimer routeTimer("route.candidates", false);
+    for (int i=0; i<(int)candidates.size(); ++i) {
+      if (calculateCost(t_cgra, t_dfg, candidates[i], context, &tilePaths[i])) {
+        paths.push_back(&tilePaths[i]);
       }
     }
   }
+  delete context;
 
-  list<map<CGRANode*, int>*>* potentialPaths =
-      getOrderedPotentialPaths(t_cgra, t_dfg, t_II, targetDFGNode, &paths);
+  vector<Route*> potentialPaths;
+  getOrderedPotentialPaths(t_cgra, t_dfg, t_II, targetDFGNode, &paths,
+                           &potentialPaths);
   bool success = false;
-  while (potentialPaths->size() != 0) {
-    map<CGRANode*, int>* currentPath = potentialPaths->front();
-    potentialPaths->pop_front();
-    assert(currentPath->size() != 0);
+  for (Route* currentPath: potentialPaths) {
+    assert(!currentPath->isEmpty());
+    int checkpoint = t_cgra->getUndoLog()->getMark();
     if (schedule(t_cgra, t_dfg, t_II, targetDFGNode, currentPath,
         t_isStaticElasticCGRA)) {
-      t_exhaustivePaths->push_back(currentPath);
+      t_exhaustivePaths->push_back(*currentPath);
       t_mappedDFGNodes->push_back(targetDFGNode);
       success = DFSMap(t_cgra, t_dfg, t_II, t_mappedDFGNodes,
           t_exhaustivePaths, t_isStaticElasticCGRA);
       if (success)
         return true;
     }
-    // If the schedule fails and need to try the other schedule,
-    // should re-construct m_mapping and m_mappingTiming.
-    constructMRRG(t_dfg, t_cgra, t_II);
-    list<DFGNode*>::iterator mappedDFGNodeItr = t_mappedDFGNodes->begin();
-    for (map<CGRANode*, int>* path: *t_exhaustivePaths) {
-      if (!schedule(t_cgra, t_dfg, t_II, *mappedDFGNodeItr, path,
-          t_isStaticElasticCGRA)) {
-        cout<<"DEBUG <this is impossible> fail7 in DFS() II: "<<t_II<<"\n";
-        assert(0);
-        break;
-      }
-      ++mappedDFGNodeItr;
-    }
+    // If the schedule fails and need to try the other schedule, takes
+    // back everything scheduled since the checkpoint (including the
+    // mapping of the deeper DFG nodes).
+    t_cgra->getUndoLog()->rollback(checkpoint);
   }
   if (t_exhaustivePaths->size() != 0) {
-    cout<<"======= go backward one step ======== popped DFG node ["<<t_mappedDFGNodes->back()->getID()<<"] from CGRA node ["<<m_mapping[t_mappedDFGNodes->back()]->getID()<<"]\n";
+    CGRA_LOG(LOG_MAPPER, LOG_DEBUG)<<"======= go backward one step ======== popped DFG node ["<<t_mappedDFGNodes->back()->getID()<<"] from CGRA node ["<<getMappedTile(t_mappedDFGNodes->back())->getID()<<"]\n";
     t_mappedDFGNodes->pop_back();
     t_exhaustivePaths->pop_back();
+    Counters::add(COUNTER_DFS_BACKTRACKS);
 //    m_exit++;
 //    if (m_exit == 2)
 //      exit(0);
   }
-  delete potentialPaths;
   return false;
 }
 
-// This helper function assume the cycle for each mapped CGRANode increases
-// gradually along the path. Otherwise, the map struct will get conflict key.
-map<int, CGRANode*>* Mapper::getReorderPath(map<CGRANode*, int>* t_path) {
-  map<int, CGRANode*>* reorderPath = new map<int, CGRANode*>();
-  for (map<CGRANode*, int>::iterator iter=t_path->begin();
-      iter!=t_path->end(); ++iter) {
-    assert(reorderPath->find((*iter).second) == reorderPath->end());
-    (*reorderPath)[(*iter).second] = (*iter).first;
-  }
-  assert(reorderPath->size() == t_path->size());
-  return reorderPath;
-}
-
 // Saves the mapping results to json file for subsequent incremental mapping.
 void Mapper::generateJSON4IncrementalMap(CGRA* t_cgra, DFG* t_dfg){
+  ScopedTimer timer("output.incremental");
   ofstream jsonFile("increMapInput.json", ios::out);
   jsonFile<<"{"<<endl;
   jsonFile<<"     \"Opt2TileXY\":{"<<endl;
@@ -1737,9 +1684,9 @@ void Mapper::generateJSON4IncrementalMap(CGRA* t_cgra, DFG* t_dfg){
     // opt id.
     jsonFile<<"             \""<<dfgNode->getID()<<"\": {"<<endl;
     // opt mapped tile x coordinate.
-    jsonFile<<"                     \"x\":"<<m_mapping[dfgNode]->getX()<<","<<endl;
+    jsonFile<<"                     \"x\":"<<getMappedTile(dfgNode)->getX()<<","<<endl;
     // opt mapped tile y coordinate.
-    jsonFile<<"                     \"y\":"<<m_mapping[dfgNode]->getY()<<endl;
+    jsonFile<<"                     \"y\":"<<getMappedTile(dfgNode)->getY()<<endl;
     idx += 1;
     if (idx < t_dfg->nodes.size()) jsonFile<<"             },"<<endl;
     else jsonFile<<"        }"<<endl;
@@ -1854,14 +1801,15 @@ void Mapper::sortAllocTilesByLevel(CGRA* t_cgra){
 list<CGRANode*> Mapper::placementGen(CGRA* t_cgra,  DFGNode* t_dfgNode){
   list<CGRANode*> placementRecommList;
   CGRANode* refCGRANode = refMapRes[t_dfgNode];
-  list<DFGNode*>* predNodes = t_dfgNode->getPredNodes();
+  int index = m_view->getIndex(t_dfgNode);
+  const int* preds = m_view->getPreds(index);
   // The level is used to ordering the CGRANodes based on the FanIO.
   // Though FanIO of each CGRANode would change for different CGRA architectures,
   // the DFGNode prefers to being mapped onto the CGRANode with same level.
   int refLevel = CGRANodeID2Level[refCGRANode->getID()];
   int level = refLevel;
   int maxLevel = CGRANodes_sortedByLevel.size() - 1;
-  cout<<t_dfgNode->getOpcodeName()<<t_dfgNode->getID()<<" is mapped to Tile "<<refCGRANode->getID()<<" in the referenced mapping results, refLevel="<<refLevel<<endl;
+  CGRA_LOG(LOG_MAPPER, LOG_DEBUG)<<t_dfgNode->getOpcodeName()<<t_dfgNode->getID()<<" is mapped to Tile "<<refCGRANode->getID()<<" in the referenced mapping results, refLevel="<<refLevel<<"\n";
 
   int initLevel = level;
   while (true) {
@@ -1872,9 +1820,9 @@ list<CGRANode*> Mapper::placementGen(CGRA* t_cgra,  DFGNode* t_dfgNode){
     int xdiff, ydiff;
     for (auto curCGRANode : CGRANodes_sortedByLevel[level]) {
       int numBypass = 0;
-      for (DFGNode* pre: *predNodes) {
-        if (m_mapping.find(pre) != m_mapping.end()) {
-          CGRANode* preCGRANode = m_mapping[pre];
+      for (int p=0; p<m_view->getPredCount(index); ++p) {
+        if (m_mappedTiles[preds[p]] != NULL) {
+          CGRANode* preCGRANode = m_mappedTiles[preds[p]];
           xdiff = abs(curCGRANode->getX() - preCGRANode->getX());
           ydiff = abs(curCGRANode->getY() - preCGRANode->getY());
           numBypass += (xdiff + ydiff);
@@ -1908,49 +1856,143 @@ int Mapper::incrementalMap(CGRA* t_cgra, DFG* t_dfg, int t_II){
   if (readRefMapRes(t_cgra, t_dfg) == -1) return -1;
   sortAllocTilesByLevel(t_cgra);
 
-  bool dfgNodeMapFailed;
   while (1) {
-    cout<<"----------------------------------------\n";
-    cout<<"[DEBUG] start incremental mapping  with II="<<t_II<<"\n";
-    int cycle = 0;
-    constructMRRG(t_dfg, t_cgra, t_II);
-    for (list<DFGNode*>::iterator dfgNode=t_dfg->nodes.begin(); dfgNode!=t_dfg->nodes.end(); dfgNode++) {
-      list<CGRANode*> placementRecommList = placementGen(t_cgra, *dfgNode);
-      dfgNodeMapFailed = true;
-      for (auto fu : placementRecommList) {
-        map<CGRANode*, int>* path = calculateCost(t_cgra, t_dfg, t_II, *dfgNode, fu);
-        if (path == NULL) {
-          // Switches to the next tile.
-          cout<<"[DEBUG] no available path for DFG node "<<(*dfgNode)->getID()<<" on CGRA node "<<fu->getID()<<" within II "<<t_II<<endl;
-          continue;
+    if (incrementalMapII(t_cgra, t_dfg, t_II)) {
+      CGRA_LOG(LOG_MAPPER, LOG_DEBUG)<<"[DEBUG] success in schedule() under II: "<<t_II<<"\n";
+      return t_II;
+    }
+    // Increases II and restart if any DFGNode fails the mapping.
+    CGRA_LOG(LOG_MAPPER, LOG_DEBUG)<<"[DEBUG] fail in schedule() under II: "<<t_II<<"\n";
+    t_II++;
+  }
+
+  return -1;
+}
+
+// One attempt of the incremental mapping with the given II.
+bool Mapper::incrementalMapII(CGRA* t_cgra, DFG* t_dfg, int t_II){
+  CGRA_LOG(LOG_MAPPER, LOG_INFO)<<"----------------------------------------\n";
+  CGRA_LOG(LOG_MAPPER, LOG_INFO)<<"[DEBUG] start incremental mapping  with II="<<t_II<<"\n";
+  ScopedTimer timer("mapper.incrementalII", true, t_II);
+  constructMRRG(t_dfg, t_cgra, t_II);
+  for (list<DFGNode*>::iterator dfgNode=t_dfg->nodes.begin(); dfgNode!=t_dfg->nodes.end(); dfgNode++) {
+    if (isProbeCancelled(t_II))
+      return false;
+    list<CGRANode*> placementRecommList = placementGen(t_cgra, *dfgNode);
+    vector<CGRANode*> candidates;
+    t_cgra->getSupportingNodes(*dfgNode, &candidates);
+    bool dfgNodeMapFailed = true;
+    RoutingContext* context = createRoutingContext(t_cgra, t_II, *dfgNode);
+    for (auto fu : placementRecommList) {
+      // Skips the recommended tiles that cannot support the DFG node.
+      if (find(candidates.begin(), candidates.end(), fu) == candidates.end())
+        continue;
+      Route path;
+      if (!calculateCost(t_cgra, t_dfg, fu, context, &path)) {
+        // Switches to the next tile.
+        CGRA_LOG(LOG_MAPPER, LOG_DEBUG)<<"[DEBUG] no available path for DFG node "<<(*dfgNode)->getID()<<" on CGRA node "<<fu->getID()<<" within II "<<t_II<<"\n";
+        continue;
+      }
+      else {
+        if (schedule(t_cgra, t_dfg, t_II, *dfgNode, &path, false)) {
+          // Current DFGNode is scheduled successfully, moves to the next DFGNode.
+          dfgNodeMapFailed = false;
+          break;
         }
         else {
-          if (schedule(t_cgra, t_dfg, t_II, *dfgNode, path, false)) {
-            // Current DFGNode is scheduled successfully, moves to the next DFGNode.
-            dfgNodeMapFailed = false;
-            break;
-          }
-          else {
-            // Switches to the next tile.
-            cout<<"[DEBUG] no available path to schedule DFG node "<<(*dfgNode)->getID()<<" on CGRA node "<<fu->getID()<<" within II "<<t_II<<endl;
-            continue;
-          }
+          // Switches to the next tile. The failed schedule has been
+          // rolled back, so the routes are still valid.
+          CGRA_LOG(LOG_MAPPER, LOG_DEBUG)<<"[DEBUG] no available path to schedule DFG node "<<(*dfgNode)->getID()<<" on CGRA node "<<fu->getID()<<" within II "<<t_II<<"\n";
+          continue;
         }
       }
-      // Increases II and restart if current DFGNode fails the mapping.
-      if (dfgNodeMapFailed) break;
     }
+    delete context;
+    if (dfgNodeMapFailed) return false;
+  }
+  timer.setSuccess(true);
+  return true;
+}
+
+// Maps the DFG with t_probeWidth consecutive IIs at once, each on an idle
+// clone of the CGRA by a mapper of its own. The lowest successful II wins,
+// the attempts with higher IIs are cancelled once an II succeeds, and the
+// next t_probeWidth IIs are probed if none succeeds. As every attempt
+// starts from an idle MRRG, mapping the winning II again onto the given
+// CGRA reproduces the mapping of the winning probe.
+int Mapper::probeMap(CGRA* t_cgra, DFG* t_dfg, int t_II, int t_probeWidth,
+    bool t_incremental) {
+  if (t_incremental) {
+    if (readRefMapRes(t_cgra, t_dfg) == -1) return -1;
+    sortAllocTilesByLevel(t_cgra);
+  }
 
-    if (dfgNodeMapFailed) {
-      cout<<"[DEBUG] fail in schedule() under II: "<<t_II<<"\n";
-      t_II++;
+  // The probes share the snapshot rather than each forcing the lazily
+  // built node lists of the same DFG concurrently.
+  freezeDFG(t_dfg);
+  while (1) {
+    CGRA_LOG(LOG_MAPPER, LOG_INFO)<<"----------------------------------------\n";
+    CGRA_LOG(LOG_MAPPER, LOG_INFO)<<"[DEBUG] probe II from "<<t_II<<" to "<<t_II+t_probeWidth-1<<"\n";
+    atomic<int> lowestMappedII(INT_MAX);
+    vector<CGRA*> probeCGRAs(t_probeWidth);
+    vector<Mapper*> probeMappers(t_probeWidth);
+    for (int k=0; k<t_probeWidth; ++k) {
+      probeCGRAs[k] = t_cgra->clone();
+      probeMappers[k] = new Mapper(m_DVFSAwareMapping);
+      probeMappers[k]->m_lowestMappedII = &lowestMappedII;
+      probeMappers[k]->m_view = m_view;
+      probeMappers[k]->m_costModel = m_costModel;
+      if (t_incremental) {
+        probeMappers[k]->readRefMapRes(probeCGRAs[k], t_dfg);
+        probeMappers[k]->sortAllocTilesByLevel(probeCGRAs[k]);
+      }
     }
-    else {
-      cout<<"[DEBUG] success in schedule() under II: "<<t_II<<"\n";
-      return t_II;
+
+    #pragma omp parallel for schedule(dynamic, 1) num_threads(t_probeWidth)
+    for (int k=0; k<t_probeWidth; ++k) {
+      int II = t_II + k;
+      bool success = false;
+      if (t_incremental) {
+        success = probeMappers[k]->incrementalMapII(probeCGRAs[k], t_dfg, II);
+      } else {
+        success = probeMappers[k]->heuristicMapII(probeCGRAs[k], t_dfg, II, false);
+      }
+      if (success) {
+        int lowest = lowestMappedII.load();
+        while (II < lowest and
+               !lowestMappedII.compare_exchange_weak(lowest, II)) {
+        }
+      }
+    }
+
+    for (int k=0; k<t_probeWidth; ++k) {
+      delete probeMappers[k];
+      delete probeCGRAs[k];
     }
+
+    int II = lowestMappedII.load();
+    if (II != INT_MAX) {
+      CGRA_LOG(LOG_MAPPER, LOG_INFO)<<"[DEBUG] lowest successful probe II="<<II<<"\n";
+      bool success = false;
+      if (t_incremental) {
+        success = incrementalMapII(t_cgra, t_dfg, II);
+      } else {
+        success = heuristicMapII(t_cgra, t_dfg, II, false);
+      }
+      assert(success);
+      return II;
+    }
+    t_II += t_probeWidth;
   }
 
   return -1;
 }
 
+// A probe gives up once a lower II has been mapped by another probe.
+bool Mapper::isProbeCancelled(int t_II) {
+  if (m_lowestMappedII == NULL or m_lowestMappedII->load() >= t_II)
+    return false;
+  CGRA_LOG(LOG_MAPPER, LOG_INFO)<<"[DEBUG] cancel probing II="<<t_II<<" as II="<<m_lowestMappedII->load()<<" is mapped\n";
+  return true;
+}
+
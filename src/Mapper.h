@@ -10,22 +10,44 @@
 
 #include "DFG.h"
 #include "CGRA.h"
+#include "Router.h"
+#include "DFGView.h"
+#include "CostModel.h"
+#include <atomic>
 
 class Mapper {
   private:
     int m_maxMappingCycle;
-    map<DFGNode*, CGRANode*> m_mapping;
-    map<DFGNode*, int> m_mappingTiming;
-    map<CGRANode*, int>* dijkstra_search(CGRA*, DFG*, int, DFGNode*,
-                                         DFGNode*, CGRANode*);
+    // Snapshot of the DFG being mapped, shared with the probes.
+    DFGView* m_view;
+    bool m_ownsView;
+    void freezeDFG(DFG*);
+    // The tile (or NULL) and the cycle (or -1) each DFG node is mapped
+    // onto, indexed as in m_view, and the nodes mapped onto each tile
+    // (indexed by tile ID) in the order of m_view.
+    vector<CGRANode*> m_mappedTiles;
+    vector<int> m_mappedCycles;
+    vector<vector<int>> m_tileNodes;
+    // The number of nodes with more than two successors mapped onto each
+    // tile, which the cost of the neighboring tiles is based on.
+    vector<int> m_tileFanoutCounts;
+    CostModel m_costModel;
+    void setMapping(int, CGRANode*, int, UndoLog*);
+    CGRANode* getMappedTile(DFGNode*);
+    int getMappedCycle(DFGNode*);
+    RoutingContext* createRoutingContext(CGRA*, int, DFGNode*);
+    bool getShortestPath(RoutingContext*, Router*, CGRANode*, Route*);
     int getMaxMappingCycle();
     bool tryToRoute(CGRA*, DFG*, int, DFGNode*, CGRANode*,
                     DFGNode*, CGRANode*, int, bool, bool);
-    list<DFGNode*>* getMappedDFGNodes(DFG*, CGRANode*);
-    map<int, CGRANode*>* getReorderPath(map<CGRANode*, int>*);
-    bool DFSMap(CGRA*, DFG*, int, list<DFGNode*>*, list<map<CGRANode*, int>*>*, bool);
-    list<map<CGRANode*, int>*>* getOrderedPotentialPaths(CGRA*, DFG*, int,
-        DFGNode*, list<map<CGRANode*, int>*>*);
+    vector<int>* getMappedDFGNodes(CGRANode*);
+    bool DFSMap(CGRA*, DFG*, int, list<DFGNode*>*, list<Route>*, bool);
+    float getPathCost(CGRA*, int, DFGNode*, Route*);
+    void getPathCosts(CGRA*, int, DFGNode*, vector<Route*>*, vector<Route*>*,
+        vector<float>*);
+    // Fills the given paths ordered by their costs.
+    void getOrderedPotentialPaths(CGRA*, DFG*, int, DFGNode*, vector<Route*>*,
+        vector<Route*>*);
     // The mapping relationship referenced by incrementalMap, read from increMapInput.json file
     map<DFGNode*, CGRANode*> refMapRes;
     // One to one relationship between CGRANode and its level
@@ -33,19 +55,29 @@ class Mapper {
     // The list of CGRANodes sorted by levels
     vector<vector<CGRANode*>> CGRANodes_sortedByLevel;
     bool m_DVFSAwareMapping;
+    // Only set for the mappers probing an II, see probeMap().
+    atomic<int>* m_lowestMappedII;
+    bool isProbeCancelled(int);
+    bool heuristicMapII(CGRA*, DFG*, int, bool);
+    bool incrementalMapII(CGRA*, DFG*, int);
 
   public:
     Mapper(bool);
-    int getResMII(DFG*, CGRA*);
+    ~Mapper();
+    // The weights and terms of the placement cost, which the probes copy.
+    CostModel* getCostModel();
+    int getResMII(DFG*, CGRA*, string* t_limitingClass=NULL);
     int getRecMII(DFG*);
     int getExpandableII(DFG*, int);
     void constructMRRG(DFG*, CGRA*, int);
     int heuristicMap(CGRA*, DFG*, int, bool);
     int exhaustiveMap(CGRA*, DFG*, int, bool);
-    map<CGRANode*, int>* calculateCost(CGRA*, DFG*, int, DFGNode*, CGRANode*);
-    map<CGRANode*, int>* getPathWithMinCostAndConstraints(CGRA*, DFG*, int,
-        DFGNode*, list<map<CGRANode*, int>*>*);
-    bool schedule(CGRA*, DFG*, int, DFGNode*, map<CGRANode*, int>*, bool);
+    // Fills the path of the DFG node onto the tile, returns whether there
+    // is one.
+    bool calculateCost(CGRA*, DFG*, CGRANode*, RoutingContext*, Route*);
+    Route* getPathWithMinCostAndConstraints(CGRA*, DFG*, int, DFGNode*,
+        vector<Route*>*);
+    bool schedule(CGRA*, DFG*, int, DFGNode*, Route*, bool);
     void showSchedule(CGRA*, DFG*, int, bool, bool);
     void showUtilization(CGRA*, DFG*, int, bool, bool);
     void generateJSON(CGRA*, DFG*, int, bool);
@@ -54,4 +86,5 @@ class Mapper {
     void sortAllocTilesByLevel(CGRA*);
     list<CGRANode*> placementGen(CGRA*, DFGNode*);
     int incrementalMap(CGRA*, DFG*, int);
+    int probeMap(CGRA*, DFG*, int, int, bool);
 };
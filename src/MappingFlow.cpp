@@ -0,0 +1,421 @@
+/*
+ * ======================================================================
+ * MappingFlow.cpp
+ * ======================================================================
+ * Mapping flow shared by the pass and the standalone mapper
+ * implementation.
+ *
+ * Date : October 16, 2026
+ */
+
+#include <fstream>
+#include <iostream>
+#include <set>
+#include <vector>
+#include <cassert>
+#include <chrono>
+
+#include "json.hpp"
+#include "MappingFlow.h"
+#include "Mapper.h"
+#include "Log.h"
+#include "Profiler.h"
+#include "Counters.h"
+
+using json = nlohmann::json;
+
+MappingParam::MappingParam() {
+  rows                    = 4;
+  columns                 = 4;
+  targetEntireFunction    = false;
+  targetNested            = false;
+  doCGRAMapping           = true;
+  isStaticElasticCGRA     = false;
+  isTrimmedDemo           = true;
+  ctrlMemConstraint       = 200;
+  bypassConstraint        = 4;
+  regConstraint           = 8;
+  precisionAware          = false;
+  vectorizationMode       = "all";
+  heuristicMapping        = true;
+  parameterizableCGRA     = false;
+  incrementalMapping      = false;
+  probeWidth              = 1;
+  supportDVFS             = false;
+  DVFSAwareMapping        = false;
+  DVFSIslandDim           = 2;
+  enablePowerGating       = false;
+  enableExpandableMapping = false;
+  vectorFactorForIdiv     = 1;
+  maxCycleCount           = 0;
+  mappingOrder            = "longest";
+  multiCycleStrategy      = "exclusive";
+  testingOpcodeOffset     = 0;
+  execLatency             = new map<string, int>();
+  pipelinedOpt            = new list<string>();
+  fusionStrategy          = new list<string>();
+  additionalFunc          = new map<string, list<int>*>();
+  fusionPattern           = new map<string, list<string>*>();
+  profile                 = false;
+  costWeights             = new map<string, double>();
+  kernel                  = "";
+  functionWithLoop        = new map<string, list<int>*>();
+}
+
+bool readMappingParam(string t_fileName, MappingParam* t_param) {
+  ifstream i(t_fileName);
+  if (!i.good()) {
+    cout<< "=============================================================\n";
+    cout<<"\033[0;31mPlease provide a valid <param.json> in the current directory."<<endl;
+    cout<<"A set of default parameters is leveraged.\033[0m"<<endl;
+    cout<< "=============================================================\n";
+    Log::configureFromEnvironment();
+    return false;
+  }
+  json param;
+  i >> param;
+
+  // Check param exist or not.
+  set<string> paramKeys;
+  paramKeys.insert("row");
+  paramKeys.insert("column");
+  paramKeys.insert("targetFunction");
+  paramKeys.insert("kernel");
+  paramKeys.insert("targetNested");
+  paramKeys.insert("targetLoopsID");
+  paramKeys.insert("isTrimmedDemo");
+  paramKeys.insert("doCGRAMapping");
+  paramKeys.insert("isStaticElasticCGRA");
+  paramKeys.insert("ctrlMemConstraint");
+  paramKeys.insert("bypassConstraint");
+  paramKeys.insert("regConstraint");
+  paramKeys.insert("precisionAware");
+  paramKeys.insert("vectorizationMode");
+  paramKeys.insert("fusionStrategy");
+  paramKeys.insert("heuristicMapping");
+  paramKeys.insert("parameterizableCGRA");
+
+  try {
+    for (auto &k : paramKeys) {
+      param.at(k);
+    }
+  } catch (json::out_of_range& e) {
+    cout<<"Please include related parameter in param.json: "<<e.what()<<endl;
+    exit(0);
+  }
+
+  t_param->kernel = param["kernel"];
+  (*t_param->functionWithLoop)[t_param->kernel] = new list<int>();
+  json loops = param["targetLoopsID"];
+  for (int idx = 0; idx < (int)loops.size(); ++idx) {
+    (*t_param->functionWithLoop)[t_param->kernel]->push_back(loops[idx]);
+  }
+
+  // Configuration for customizable CGRA.
+  t_param->rows                 = param["row"];
+  t_param->columns              = param["column"];
+  t_param->targetEntireFunction = param["targetFunction"];
+  t_param->targetNested         = param["targetNested"];
+  t_param->doCGRAMapping        = param["doCGRAMapping"];
+  t_param->isStaticElasticCGRA  = param["isStaticElasticCGRA"];
+  t_param->isTrimmedDemo        = param["isTrimmedDemo"];
+  t_param->ctrlMemConstraint    = param["ctrlMemConstraint"];
+  t_param->bypassConstraint     = param["bypassConstraint"];
+  t_param->regConstraint        = param["regConstraint"];
+  t_param->precisionAware       = param["precisionAware"];
+  t_param->vectorizationMode    = param["vectorizationMode"];
+  t_param->heuristicMapping     = param["heuristicMapping"];
+  t_param->parameterizableCGRA  = param["parameterizableCGRA"];
+
+  if (param.find("incrementalMapping") != param.end()) {
+    t_param->incrementalMapping = param["incrementalMapping"];
+  }
+  if (param.find("probeWidth") != param.end()) {
+    t_param->probeWidth = param["probeWidth"];
+  }
+  if (param.find("supportDVFS") != param.end()) {
+    t_param->supportDVFS = param["supportDVFS"];
+  }
+  if (param.find("DVFSAwareMapping") != param.end()) {
+    t_param->DVFSAwareMapping = param["DVFSAwareMapping"];
+  }
+  if (param.find("DVFSIslandDim") != param.end()) {
+    t_param->DVFSIslandDim = param["DVFSIslandDim"];
+  }
+  if (param.find("enablePowerGating") != param.end()) {
+    t_param->enablePowerGating = param["enablePowerGating"];
+  }
+  if (param.find("expandableMapping") != param.end()) {
+    t_param->enableExpandableMapping = param["expandableMapping"];
+  }
+
+  // NOTE: original code had a trailing space in the key "vectorFactorForIdiv "
+  if (param.find("vectorFactorForIdiv ") != param.end()) {
+    t_param->vectorFactorForIdiv = param["vectorFactorForIdiv "];
+  }
+  if (param.find("mappingOrder") != param.end()) {
+    t_param->mappingOrder = param["mappingOrder"];
+  }
+  if (param.find("maxCycleCount") != param.end()) {
+    t_param->maxCycleCount = param["maxCycleCount"];
+  }
+  if (param.find("profile") != param.end()) {
+    t_param->profile = param["profile"];
+  }
+  if (param.find("costWeights") != param.end()) {
+    for (auto& weight : param["costWeights"].items()) {
+      (*t_param->costWeights)[weight.key()] = weight.value();
+    }
+  }
+  if (param.find("testingOpcodeOffset") != param.end()) {
+    t_param->testingOpcodeOffset = param["testingOpcodeOffset"];
+  }
+  if (param.find("multiCycleStrategy") != param.end()) {
+    t_param->multiCycleStrategy = param["multiCycleStrategy"];
+    // Strategy Definition:
+    // Exclusive: Multi-cycle ops occupy tiles exclusively.
+    // Distributed: Multi-cycle ops split into multiple single-cycle ops.
+    // Inclusive: Multi-cycle ops may overlap with other ops on same tile.
+    assert(t_param->multiCycleStrategy == "exclusive" ||
+           t_param->multiCycleStrategy == "distributed" ||
+           t_param->multiCycleStrategy == "inclusive");
+  }
+
+  // The logging is set up before anything below is printed, the
+  // environment taking precedence over param.json.
+  if (param.find("logLevel") != param.end()) {
+    Log::configure(param["logLevel"]);
+  }
+  Log::configureFromEnvironment();
+
+  CGRA_LOG(LOG_MAPPER, LOG_INFO)<<"Initialize opt latency for DFG nodes: \n";
+  for (auto& opt : param["optLatency"].items()) {
+    CGRA_LOG(LOG_MAPPER, LOG_INFO)<<opt.key()<<" : "<<opt.value()<<"\n";
+    (*t_param->execLatency)[opt.key()] = opt.value();
+  }
+
+  json pipeOpt = param["optPipelined"];
+  for (int idx = 0; idx < (int)pipeOpt.size(); ++idx) {
+    t_param->pipelinedOpt->push_back(pipeOpt[idx]);
+  }
+
+  CGRA_LOG(LOG_MAPPER, LOG_INFO)<<"Deciding fusion strategy for DFG nodes: \n";
+  for (auto& opt : param["fusionStrategy"].items()) {
+    t_param->fusionStrategy->push_back(opt.value());
+  }
+
+  CGRA_LOG(LOG_MAPPER, LOG_INFO)<<"Initialize additional functionality on CGRA nodes: \n";
+  for (auto& opt : param["additionalFunc"].items()) {
+    (*t_param->additionalFunc)[opt.key()] = new list<int>();
+    CGRA_LOG(LOG_MAPPER, LOG_INFO)<<opt.key()<<" : "<<opt.value()<<": ";
+    for (int idx = 0; idx < (int)opt.value().size(); ++idx) {
+      (*t_param->additionalFunc)[opt.key()]->push_back(opt.value()[idx]);
+      CGRA_LOG(LOG_MAPPER, LOG_INFO)<<opt.value()[idx]<<" ";
+    }
+    CGRA_LOG(LOG_MAPPER, LOG_INFO)<<"\n";
+  }
+
+  CGRA_LOG(LOG_MAPPER, LOG_INFO)<<"Finding fusion pattern for DFG: \n";
+  for (auto& opt : param["fusionPattern"].items()) {
+    (*t_param->fusionPattern)[opt.key()] = new list<string>();
+    CGRA_LOG(LOG_MAPPER, LOG_INFO)<<opt.key()<<" : "<<opt.value()<<": ";
+    for (int idx = 0; idx < (int)opt.value().size(); ++idx) {
+      (*t_param->fusionPattern)[opt.key()]->push_back(opt.value()[idx]);
+      CGRA_LOG(LOG_MAPPER, LOG_INFO)<<opt.value()[idx]<<" ";
+    }
+    CGRA_LOG(LOG_MAPPER, LOG_INFO)<<"\n";
+  }
+  return true;
+}
+
+/*
+ * Early exit if mapping is not possible when no FU can support certain DFG op.
+ * Lists all the missing fus.
+ */
+static bool canMap(CGRA* t_cgra, DFG* t_dfg) {
+  set<string> missing_fus;
+
+  vector<CGRANode*> supportingNodes;
+  for (auto it = t_dfg->nodes.begin(); it != t_dfg->nodes.end(); ++it) {
+    DFGNode* node = *it;
+    t_cgra->getSupportingNodes(node, &supportingNodes);
+
+    if (supportingNodes.empty()) {
+      missing_fus.insert(node->getOpcodeName());
+    }
+  }
+
+  if (!missing_fus.empty()) {
+    cout << "[canMap] Missing functional units: ";
+    for (const auto& op : missing_fus) {
+      cout << op << " ";
+    }
+    cout << endl;
+    return false;
+  }
+
+  return true;
+}
+
+int runMapping(DFG* t_dfg, MappingParam* t_param, string t_kernel,
+               bool t_outputDFG) {
+  const bool enableMultipleOps = (t_param->multiCycleStrategy == "inclusive");
+  int probeWidth = t_param->probeWidth;
+
+  CGRA* cgra = new CGRA(t_param->rows, t_param->columns,
+                        t_param->vectorizationMode, t_param->fusionStrategy,
+                        t_param->parameterizableCGRA, t_param->additionalFunc,
+                        t_param->supportDVFS, t_param->DVFSIslandDim,
+                        enableMultipleOps);
+  cgra->setRegConstraint(t_param->regConstraint);
+  cgra->setCtrlMemConstraint(t_param->ctrlMemConstraint);
+  cgra->setBypassConstraint(t_param->bypassConstraint);
+
+  Mapper* mapper = new Mapper(t_param->DVFSAwareMapping);
+  for (auto& weight : *t_param->costWeights) {
+    if (mapper->getCostModel()->setWeight(weight.first, weight.second)) {
+      CGRA_LOG(LOG_MAPPER, LOG_INFO) << "[cost weight] " << weight.first << ": " << weight.second << "\n";
+    } else {
+      cout << "Error: Unknown cost term '" << weight.first << "'\n";
+    }
+  }
+
+  // Show the count of different opcodes (IRs).
+  CGRA_LOG(LOG_MAPPER, LOG_INFO) << "==================================\n";
+  CGRA_LOG(LOG_MAPPER, LOG_INFO) << "[show opcode count]\n";
+  t_dfg->showOpcodeDistribution();
+
+  if (t_outputDFG) {
+    // Generate the DFG dot file.
+    CGRA_LOG(LOG_MAPPER, LOG_INFO) << "==================================\n";
+    CGRA_LOG(LOG_MAPPER, LOG_INFO) << "[generate dot for DFG]\n";
+    t_dfg->generateDot(t_kernel, t_param->isTrimmedDemo);
+
+    // Generate the DFG JSON file.
+    CGRA_LOG(LOG_MAPPER, LOG_INFO) << "==================================\n";
+    CGRA_LOG(LOG_MAPPER, LOG_INFO) << "[generate JSON for DFG]\n";
+    t_dfg->generateJSON();
+
+    // Serialize the DFG as it is about to be mapped, i.e., before the
+    // DVFS levels are assigned, to be mapped again by cgra-map.
+    CGRA_LOG(LOG_MAPPER, LOG_INFO) << "==================================\n";
+    CGRA_LOG(LOG_MAPPER, LOG_INFO) << "[serialize DFG]\n";
+    if (!t_dfg->saveDFG("dfg.full.json") or !t_dfg->saveDFG("dfg.bin")) {
+      cerr << "Error: cannot write the serialized DFG\n";
+    }
+  }
+
+  // Initialize the II.
+  string ResMIIClass;
+  int ResMII = mapper->getResMII(t_dfg, cgra, &ResMIIClass);
+  CGRA_LOG(LOG_MAPPER, LOG_INFO) << "==================================\n";
+  CGRA_LOG(LOG_MAPPER, LOG_INFO) << "[ResMII: " << ResMII << "]\n";
+  CGRA_LOG(LOG_MAPPER, LOG_INFO) << "[ResMII limited by: " << ResMIIClass << "]\n";
+  int RecMII = mapper->getRecMII(t_dfg);
+  CGRA_LOG(LOG_MAPPER, LOG_INFO) << "==================================\n";
+  CGRA_LOG(LOG_MAPPER, LOG_INFO) << "[RecMII: " << RecMII << "]\n";
+
+  int II = ResMII;
+  if (II < RecMII) II = RecMII;
+
+  if (t_param->supportDVFS) {
+    t_dfg->initDVFSLatencyMultiple(II, t_param->DVFSIslandDim, cgra->getFUCount());
+  }
+
+  if (!t_param->doCGRAMapping) {
+    cout << "==================================\n";
+    return II;
+  }
+  if (!canMap(cgra, t_dfg)) {
+    cout << "==================================\n";
+    cout << "[Mapping Fail]\n";
+    return -1;
+  }
+
+  bool success = false;
+  bool isStaticElasticCGRA = t_param->isStaticElasticCGRA;
+
+  // Heuristic algorithm (hill climbing) to get a valid mapping within a acceptable II.
+  if (!isStaticElasticCGRA) {
+    CGRA_LOG(LOG_MAPPER, LOG_INFO) << "==================================\n";
+    using Clock = chrono::high_resolution_clock;
+    auto t1 = Clock::now();
+
+    // The DVFS islands keep the levels settled by the previous attempts,
+    // i.e., the IIs cannot be probed independently with DVFS.
+    if (probeWidth > 1 and t_param->supportDVFS) {
+      CGRA_LOG(LOG_MAPPER, LOG_INFO) << "[probe width is ignored as DVFS is supported]\n";
+      probeWidth = 1;
+    }
+    if (t_param->heuristicMapping) {
+      if (probeWidth > 1) {
+        CGRA_LOG(LOG_MAPPER, LOG_INFO) << (t_param->incrementalMapping ? "[Incremental]\n" : "[heuristic]\n");
+        CGRA_LOG(LOG_MAPPER, LOG_INFO) << "[probe width: " << probeWidth << "]\n";
+        II = mapper->probeMap(cgra, t_dfg, II, probeWidth, t_param->incrementalMapping);
+      } else if (t_param->incrementalMapping) {
+        II = mapper->incrementalMap(cgra, t_dfg, II);
+        CGRA_LOG(LOG_MAPPER, LOG_INFO) << "[Incremental]\n";
+      } else {
+        CGRA_LOG(LOG_MAPPER, LOG_INFO) << "[heuristic]\n";
+        II = mapper->heuristicMap(cgra, t_dfg, II, isStaticElasticCGRA);
+      }
+    } else {
+      CGRA_LOG(LOG_MAPPER, LOG_INFO) << "[exhaustive]\n";
+      II = mapper->exhaustiveMap(cgra, t_dfg, II, isStaticElasticCGRA);
+    }
+
+    auto t2 = Clock::now();
+    int elapsedTime =
+      chrono::duration_cast<chrono::nanoseconds>(t2 - t1).count() / 1000000;
+    cout <<"Mapping algorithm elapsed time="<<elapsedTime <<"ms"<< '\n';
+  }
+
+  // Partially exhaustive search to try to map the DFG onto the static elastic CGRA.
+  if (isStaticElasticCGRA && !success) {
+    CGRA_LOG(LOG_MAPPER, LOG_INFO) << "==================================\n";
+    CGRA_LOG(LOG_MAPPER, LOG_INFO) << "[exhaustive]\n";
+    II = mapper->exhaustiveMap(cgra, t_dfg, II, isStaticElasticCGRA);
+  }
+
+  CGRA_LOG(LOG_MAPPER, LOG_INFO) << "[MRRG arena high-water mark: "
+       << cgra->getArena()->getHighWaterMark() << " bytes]\n";
+
+  // Show the mapping and routing results with JSON output.
+  if (II == -1) {
+    cout << "[fail]\n";
+  } else {
+    mapper->showSchedule(cgra, t_dfg, II, isStaticElasticCGRA, t_param->parameterizableCGRA);
+    cout << "[Mapping Success]\n";
+    CGRA_LOG(LOG_MAPPER, LOG_INFO) << "==================================\n";
+    if (t_param->enableExpandableMapping) {
+      cout << "[ExpandableII: " << mapper->getExpandableII(t_dfg, II) << "]\n";
+      CGRA_LOG(LOG_MAPPER, LOG_INFO) << "==================================\n";
+    }
+    CGRA_LOG(LOG_MAPPER, LOG_INFO) << "[Utilization & DVFS stats]\n";
+    mapper->showUtilization(cgra, t_dfg, II, isStaticElasticCGRA, t_param->enablePowerGating);
+    CGRA_LOG(LOG_MAPPER, LOG_INFO) << "==================================\n";
+    mapper->generateJSON(cgra, t_dfg, II, isStaticElasticCGRA);
+    CGRA_LOG(LOG_MAPPER, LOG_INFO) << "[Output Json]\n";
+
+    // save mapping results json file for possible incremental mapping
+    if (!t_param->incrementalMapping) {
+      mapper->generateJSON4IncrementalMap(cgra, t_dfg);
+      CGRA_LOG(LOG_MAPPER, LOG_INFO) << "[Output Json for Incremental Mapping]\n";
+    }
+  }
+
+  if (t_param->profile) {
+    Profiler::writeTrace("timeline.json");
+    Profiler::writeSummary("timing.json", t_kernel, II);
+    CGRA_LOG(LOG_MAPPER, LOG_INFO) << "[Output timeline.json and timing.json]\n";
+  }
+
+  CGRA_LOG(LOG_MAPPER, LOG_INFO) << "[Search counters]\n";
+  if (CGRA_LOG_ENABLED(LOG_MAPPER, LOG_INFO)) {
+    Counters::dump(Log::stream());
+  }
+
+  CGRA_LOG(LOG_MAPPER, LOG_INFO) << "==================================\n";
+  Log::flush();
+  return II;
+}
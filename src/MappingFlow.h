@@ -0,0 +1,100 @@
+/*
+ * ======================================================================
+ * MappingFlow.h
+ * ======================================================================
+ * Mapping flow shared by the pass and the standalone mapper header file.
+ *
+ * Date : October 16, 2026
+ */
+
+#ifndef MappingFlow_H
+#define MappingFlow_H
+
+#include <string>
+#include <list>
+#include <map>
+
+using namespace std;
+
+class DFG;
+
+// The parameters of the DFG construction and of the mapping, see
+// param.json.
+struct MappingParam {
+  int rows;
+  int columns;
+  bool targetEntireFunction;
+  bool targetNested;
+  bool doCGRAMapping;
+  bool isStaticElasticCGRA;
+  bool isTrimmedDemo;
+  int ctrlMemConstraint;
+  int bypassConstraint;
+  int regConstraint;
+  bool precisionAware;
+  string vectorizationMode;
+  bool heuristicMapping;
+  bool parameterizableCGRA;
+
+  // Incremental mapping related:
+  // https://github.com/tancheng/CGRA-Mapper/pull/24
+  bool incrementalMapping;
+
+  // Number of IIs mapped concurrently by the heuristic/incremental
+  // mapping, 1 maps the IIs one after another.
+  int probeWidth;
+
+  // DVFS-related options.
+  bool supportDVFS;
+  bool DVFSAwareMapping;
+  int DVFSIslandDim;
+  bool enablePowerGating;
+  bool enableExpandableMapping;
+
+  // Option used to split one integer division into 4.
+  // https://github.com/tancheng/CGRA-Mapper/pull/27#issuecomment-2480362586
+  int vectorFactorForIdiv;
+
+  // Bounds the number of DFG cycles enumerated, 0 enumerates all of them.
+  int maxCycleCount;
+
+  // The order in which the DFG nodes are mapped, i.e., "longest" (along
+  // with the longest path), "dfs", or "bfs".
+  string mappingOrder;
+  string multiCycleStrategy;
+
+  // Used to workaround the mis-interpret of LLVM opcode in github
+  // testing infra, only applies to the DFG constructed from the LLVM IR.
+  int testingOpcodeOffset;
+
+  map<string, int>* execLatency;
+  list<string>* pipelinedOpt;
+  list<string>* fusionStrategy;
+  map<string, list<int>*>* additionalFunc;
+  map<string, list<string>*>* fusionPattern;
+
+  // Writes the time spent in each phase into timeline.json (Chrome
+  // trace) and timing.json (summary), see Profiler.
+  bool profile;
+
+  // Overrides the weights of the placement cost terms (see CostModel).
+  map<string, double>* costWeights;
+
+  // The target functions and their target loops.
+  string kernel;
+  map<string, list<int>*>* functionWithLoop;
+
+  MappingParam();
+};
+
+// Reads the parameters, and sets up the logging. Leaves the defaults if
+// the file is missing (and returns false), exits if it lacks any of the
+// required parameters.
+bool readMappingParam(string, MappingParam*);
+
+// Maps the DFG onto the CGRA described by the parameters, and writes the
+// results (the DFG itself as well if asked). Returns the II, -1 if the
+// DFG cannot be mapped.
+int runMapping(DFG*, MappingParam*, string t_kernel, bool t_outputDFG);
+
+#endif
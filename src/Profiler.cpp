@@ -0,0 +1,140 @@
+/*
+ * ======================================================================
+ * Profiler.cpp
+ * ======================================================================
+ * Scoped timers of the mapping phases implementation.
+ *
+ * Date : October 16, 2026
+ */
+
+#include "Profiler.h"
+#include <fstream>
+#include <iomanip>
+#include <omp.h>
+
+bool Profiler::s_enabled = false;
+chrono::steady_clock::time_point Profiler::s_origin;
+mutex Profiler::s_mutex;
+vector<ProfileEvent> Profiler::s_events;
+map<string, ProfilePhase> Profiler::s_phases;
+
+void Profiler::enable() {
+  s_events.clear();
+  s_phases.clear();
+  s_origin = chrono::steady_clock::now();
+  s_enabled = true;
+}
+
+long Profiler::now() {
+  return chrono::duration_cast<chrono::microseconds>(
+      chrono::steady_clock::now() - s_origin).count();
+}
+
+void Profiler::record(const char* t_name, long t_start, long t_duration,
+    bool t_onTimeline, int t_II, bool t_success) {
+  int thread = omp_get_thread_num();
+  lock_guard<mutex> guard(s_mutex);
+  ProfilePhase& phase = s_phases[t_name];
+  ++phase.count;
+  phase.duration += t_duration;
+  if (t_onTimeline) {
+    ProfileEvent event;
+    event.name = t_name;
+    event.start = t_start;
+    event.duration = t_duration;
+    event.thread = thread;
+    event.II = t_II;
+    event.success = t_success;
+    s_events.push_back(event);
+  }
+}
+
+static string getCategory(string t_name) {
+  return t_name.substr(0, t_name.find('.'));
+}
+
+static double toMs(long t_us) {
+  return t_us / 1000.0;
+}
+
+bool Profiler::writeTrace(string t_path) {
+  ofstream jsonFile(t_path);
+  if (!jsonFile.good())
+    return false;
+  lock_guard<mutex> guard(s_mutex);
+  jsonFile<<"{\n";
+  jsonFile<<"  \"displayTimeUnit\": \"ms\",\n";
+  jsonFile<<"  \"traceEvents\": [";
+  for (int i=0; i<(int)s_events.size(); ++i) {
+    ProfileEvent& event = s_events[i];
+    jsonFile<<(i == 0 ? "\n" : ",\n");
+    jsonFile<<"    {\"name\": \""<<event.name<<"\", \"cat\": \""
+            <<getCategory(event.name)<<"\", \"ph\": \"X\", \"ts\": "
+            <<event.start<<", \"dur\": "<<event.duration
+            <<", \"pid\": 1, \"tid\": "<<event.thread;
+    if (event.II != -1) {
+      jsonFile<<", \"args\": {\"II\": "<<event.II<<", \"success\": "
+              <<(event.success ? "true" : "false")<<"}";
+    }
+    jsonFile<<"}";
+  }
+  jsonFile<<"\n  ]\n";
+  jsonFile<<"}\n";
+  return true;
+}
+
+bool Profiler::writeSummary(string t_path, string t_kernel, int t_II) {
+  ofstream jsonFile(t_path);
+  if (!jsonFile.good())
+    return false;
+  long total = now();
+  lock_guard<mutex> guard(s_mutex);
+  jsonFile<<fixed<<setprecision(3);
+  jsonFile<<"{\n";
+  jsonFile<<"  \"kernel\": \""<<t_kernel<<"\",\n";
+  jsonFile<<"  \"II\": "<<t_II<<",\n";
+  jsonFile<<"  \"success\": "<<(t_II != -1 ? "true" : "false")<<",\n";
+  jsonFile<<"  \"totalMs\": "<<toMs(total)<<",\n";
+  jsonFile<<"  \"phases\": {";
+  bool first = true;
+  for (auto& phase: s_phases) {
+    jsonFile<<(first ? "\n" : ",\n");
+    jsonFile<<"    \""<<phase.first<<"\": {\"count\": "<<phase.second.count
+            <<", \"totalMs\": "<<toMs(phase.second.duration)<<"}";
+    first = false;
+  }
+  jsonFile<<"\n  },\n";
+  jsonFile<<"  \"attempts\": [";
+  first = true;
+  for (ProfileEvent& event: s_events) {
+    if (event.II == -1)
+      continue;
+    jsonFile<<(first ? "\n" : ",\n");
+    jsonFile<<"    {\"name\": \""<<event.name<<"\", \"II\": "<<event.II
+            <<", \"ms\": "<<toMs(event.duration)<<", \"success\": "
+            <<(event.success ? "true" : "false")<<"}";
+    first = false;
+  }
+  jsonFile<<"\n  ]\n";
+  jsonFile<<"}\n";
+  return true;
+}
+
+ScopedTimer::ScopedTimer(const char* t_name, bool t_onTimeline, int t_II) {
+  m_name = t_name;
+  m_start = Profiler::isEnabled() ? Profiler::now() : -1;
+  m_onTimeline = t_onTimeline;
+  m_II = t_II;
+  m_success = false;
+}
+
+ScopedTimer::~ScopedTimer() {
+  if (m_start == -1)
+    return;
+  Profiler::record(m_name, m_start, Profiler::now() - m_start, m_onTimeline,
+                   m_II, m_success);
+}
+
+void ScopedTimer::setSuccess(bool t_success) {
+  m_success = t_success;
+}
@@ -0,0 +1,81 @@
+/*
+ * ======================================================================
+ * Profiler.h
+ * ======================================================================
+ * Scoped timers of the mapping phases header file.
+ *
+ * Date : October 16, 2026
+ */
+
+#ifndef Profiler_H
+#define Profiler_H
+
+#include <chrono>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+// One timed scope on the timeline, in microseconds since profiling was
+// enabled.
+struct ProfileEvent {
+  const char* name;
+  long start;
+  long duration;
+  int thread;
+  // The II attempted (or -1) and whether the attempt succeeded.
+  int II;
+  bool success;
+};
+
+// The accumulated time of all the scopes with the same name.
+struct ProfilePhase {
+  long count;
+  long duration;
+};
+
+// Collects the time spent in each phase of the mapping (see ScopedTimer),
+// which is written as a Chrome/Perfetto trace (chrome://tracing or
+// ui.perfetto.dev) and as a per-run summary. Nothing is recorded unless
+// enabled, e.g., with "profile" in param.json.
+class Profiler {
+  private:
+    static bool s_enabled;
+    static chrono::steady_clock::time_point s_origin;
+    static mutex s_mutex;
+    static vector<ProfileEvent> s_events;
+    static map<string, ProfilePhase> s_phases;
+
+  public:
+    static void enable();
+    static bool isEnabled() {
+      return s_enabled;
+    }
+    static long now();
+    static void record(const char*, long, long, bool, int, bool);
+    static bool writeTrace(string);
+    static bool writeSummary(string, string, int);
+};
+
+// Times the enclosing scope under the name, e.g., "mrrg.construct", the
+// part before the dot being the category on the timeline. The scopes
+// entered too often to be shown one by one (e.g., each routing) only add
+// to the summary. A disabled timer costs a flag check.
+class ScopedTimer {
+  private:
+    const char* m_name;
+    long m_start;
+    bool m_onTimeline;
+    int m_II;
+    bool m_success;
+
+  public:
+    ScopedTimer(const char*, bool t_onTimeline=true, int t_II=-1);
+    ~ScopedTimer();
+    // Marks the II attempt being timed as successful.
+    void setSuccess(bool);
+};
+
+#endif
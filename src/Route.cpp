@@ -0,0 +1,115 @@
+/*
+ * ======================================================================
+ * Route.cpp
+ * ======================================================================
+ * Route of a data flow across the tiles implementation.
+ *
+ * Date : October 16, 2026
+ */
+
+#include "Route.h"
+#include "CGRANode.h"
+#include <assert.h>
+
+Route::Route() {
+  m_hops = m_inline;
+  m_size = 0;
+  m_capacity = INLINE_HOPS;
+}
+
+Route::Route(const Route& t_route) {
+  m_hops = m_inline;
+  m_size = 0;
+  m_capacity = INLINE_HOPS;
+  *this = t_route;
+}
+
+Route& Route::operator=(const Route& t_route) {
+  if (this == &t_route)
+    return *this;
+  reserve(t_route.m_size);
+  for (int i=0; i<t_route.m_size; ++i) {
+    m_hops[i] = t_route.m_hops[i];
+  }
+  m_size = t_route.m_size;
+  return *this;
+}
+
+Route::~Route() {
+  if (m_hops != m_inline)
+    delete[] m_hops;
+}
+
+void Route::reserve(int t_capacity) {
+  if (t_capacity <= m_capacity)
+    return;
+  int capacity = m_capacity;
+  while (capacity < t_capacity) {
+    capacity *= 2;
+  }
+  RouteHop* hops = new RouteHop[capacity];
+  for (int i=0; i<m_size; ++i) {
+    hops[i] = m_hops[i];
+  }
+  if (m_hops != m_inline)
+    delete[] m_hops;
+  m_hops = hops;
+  m_capacity = capacity;
+}
+
+void Route::clear() {
+  m_size = 0;
+}
+
+void Route::push(CGRANode* t_tile, int t_cycle) {
+  reserve(m_size + 1);
+  m_hops[m_size].tile = t_tile;
+  m_hops[m_size].cycle = t_cycle;
+  m_hops[m_size].link = NULL;
+  ++m_size;
+}
+
+void Route::order() {
+  for (int i=0, j=m_size-1; i<j; ++i, --j) {
+    RouteHop hop = m_hops[i];
+    m_hops[i] = m_hops[j];
+    m_hops[j] = hop;
+  }
+  for (int i=0; i<m_size; ++i) {
+    m_hops[i].link = NULL;
+    if (i > 0) {
+      // The data never goes back in time along a route.
+      assert(m_hops[i-1].cycle < m_hops[i].cycle);
+      if (m_hops[i-1].tile != m_hops[i].tile)
+        m_hops[i].link = m_hops[i-1].tile->getOutLink(m_hops[i].tile);
+    }
+  }
+}
+
+int Route::size() {
+  return m_size;
+}
+
+bool Route::isEmpty() {
+  return m_size == 0;
+}
+
+RouteHop* Route::getHop(int t_index) {
+  return &m_hops[t_index];
+}
+
+RouteHop* Route::getFirstHop() {
+  return &m_hops[0];
+}
+
+RouteHop* Route::getLastHop() {
+  return &m_hops[m_size-1];
+}
+
+bool Route::isLocal() {
+  for (int i=1; i<m_size; ++i) {
+    if (m_hops[i].tile != m_hops[0].tile)
+      return false;
+  }
+  return true;
+}
@@ -0,0 +1,59 @@
+/*
+ * ======================================================================
+ * Route.h
+ * ======================================================================
+ * Route of a data flow across the tiles header file.
+ *
+ * Date : October 16, 2026
+ */
+
+#ifndef Route_H
+#define Route_H
+
+class CGRANode;
+class CGRALink;
+
+// One step of a route: the tile the data is at, the cycle it arrives
+// there, and the link it arrives through (NULL on the first hop or if it
+// stays on the same tile).
+struct RouteHop {
+  CGRANode* tile;
+  int cycle;
+  CGRALink* link;
+};
+
+// The hops of a route in time order, the last hop being the tile the
+// destination DFG node is placed onto. Unlike a map keyed by the tile, a
+// route revisiting a tile keeps each visit as its own hop. The first few
+// hops are stored inline, so a route owned by the caller (or reused
+// across the candidates) usually does not allocate at all.
+class Route {
+  private:
+    static const int INLINE_HOPS = 8;
+    RouteHop m_inline[INLINE_HOPS];
+    RouteHop* m_hops;
+    int m_size;
+    int m_capacity;
+    void reserve(int);
+
+  public:
+    Route();
+    Route(const Route&);
+    Route& operator=(const Route&);
+    ~Route();
+    void clear();
+    // Appends a hop without any link, see order().
+    void push(CGRANode*, int);
+    // Puts the hops that were traced back from the destination in time
+    // order and attaches the links between the consecutive tiles.
+    void order();
+    int size();
+    bool isEmpty();
+    RouteHop* getHop(int);
+    RouteHop* getFirstHop();
+    RouteHop* getLastHop();
+    // Whether all the hops are on the same tile, i.e., nothing is routed.
+    bool isLocal();
+};
+
+#endif
@@ -0,0 +1,219 @@
+/*
+ * ======================================================================
+ * Router.cpp
+ * ======================================================================
+ * Single-source router on the MRRG implementation.
+ *
+ * Date : October 16, 2026
+ */
+
+#include "Router.h"
+#include "CGRA.h"
+#include "Counters.h"
+
+Router::Router(CGRA* t_cgra) {
+  m_tileCount = t_cgra->getFUCount();
+  m_tiles.assign(m_tileCount, NULL);
+  for (int i=0; i<t_cgra->getRows(); ++i) {
+    for (int j=0; j<t_cgra->getColumns(); ++j) {
+      CGRANode* tile = t_cgra->nodes[i][j];
+      m_tiles[tile->getID()] = tile;
+    }
+  }
+  m_distance.assign(m_tileCount, 0);
+  m_timing.assign(m_tileCount, 0);
+  m_previous.assign(m_tileCount, -1);
+  m_reached.assign(m_tileCount, false);
+  m_heapPos.assign(m_tileCount, -1);
+  m_heap.reserve(m_tileCount);
+  m_srcDFGNode = NULL;
+  m_srcCGRANode = NULL;
+  m_srcCycle = 0;
+}
+
+bool Router::heapLess(int t_a, int t_b) {
+  if (m_distance[t_a] != m_distance[t_b])
+    return m_distance[t_a] < m_distance[t_b];
+  return t_a < t_b;
+}
+
+void Router::heapSiftUp(int t_pos) {
+  int tile = m_heap[t_pos];
+  while (t_pos > 0) {
+    int parent = (t_pos - 1) / 2;
+    if (!heapLess(tile, m_heap[parent]))
+      break;
+    m_heap[t_pos] = m_heap[parent];
+    m_heapPos[m_heap[t_pos]] = t_pos;
+    t_pos = parent;
+  }
+  m_heap[t_pos] = tile;
+  m_heapPos[tile] = t_pos;
+}
+
+void Router::heapSiftDown(int t_pos) {
+  int tile = m_heap[t_pos];
+  int size = m_heap.size();
+  while (true) {
+    int child = 2 * t_pos + 1;
+    if (child >= size)
+      break;
+    if (child + 1 < size and heapLess(m_heap[child + 1], m_heap[child]))
+      ++child;
+    if (!heapLess(m_heap[child], tile))
+      break;
+    m_heap[t_pos] = m_heap[child];
+    m_heapPos[m_heap[t_pos]] = t_pos;
+    t_pos = child;
+  }
+  m_heap[t_pos] = tile;
+  m_heapPos[tile] = t_pos;
+}
+
+void Router::heapPushOrDecrease(int t_tile) {
+  if (m_heapPos[t_tile] == -1) {
+    m_heap.push_back(t_tile);
+    m_heapPos[t_tile] = m_heap.size() - 1;
+  }
+  heapSiftUp(m_heapPos[t_tile]);
+}
+
+int Router::heapPop() {
+  int top = m_heap.front();
+  m_heapPos[top] = -1;
+  int last = m_heap.back();
+  m_heap.pop_back();
+  if (!m_heap.empty()) {
+    m_heap[0] = last;
+    m_heapPos[last] = 0;
+    heapSiftDown(0);
+  }
+  return top;
+}
+
+void Router::search(DFGNode* t_srcDFGNode, CGRANode* t_srcCGRANode,
+    int t_srcCycle, int t_II, int t_maxCycle, CGRANode* t_dstCGRANode) {
+  Counters::add(COUNTER_ROUTER_SEARCHES);
+  m_srcDFGNode = t_srcDFGNode;
+  m_srcCGRANode = t_srcCGRANode;
+  m_srcCycle = t_srcCycle;
+  for (int i=0; i<m_tileCount; ++i) {
+    m_distance[i] = t_maxCycle;
+    m_previous[i] = -1;
+    m_reached[i] = false;
+    m_heapPos[i] = -1;
+  }
+  m_heap.clear();
+
+  // The tiles that are never reached keep the initial distance, so they
+  // can not improve any other tile and are left out of the heap.
+  int src = t_srcCGRANode->getID();
+  m_distance[src] = 0;
+  m_timing[src] = getTiming(t_srcCGRANode);
+  m_reached[src] = true;
+  heapPushOrDecrease(src);
+  while (!m_heap.empty()) {
+    int minTile = heapPop();
+    CGRANode* minNode = m_tiles[minTile];
+    // found the target point in the shortest path
+    if (minNode == t_dstCGRANode)
+      break;
+    for (CGRANode* neighbor: *(minNode->getNeighbors())) {
+      int next = neighbor->getID();
+      int cycle = m_timing[minTile];
+      CGRALink* currentLink = minNode->getOutLink(neighbor);
+      while (1) {
+        // TODO: should also consider the cost of the register file
+        if (currentLink->canOccupy(t_srcDFGNode, t_srcCGRANode, cycle, t_II)) {
+          // rough estimate the cost based on the suspend cycle
+          int cost = m_distance[minTile] + (cycle - m_timing[minTile]) + 1;
+          if (cost < m_distance[next]) {
+            m_distance[next] = cost;
+            m_timing[next] = cycle + 1;
+            m_previous[next] = minTile;
+            m_reached[next] = true;
+            heapPushOrDecrease(next);
+          }
+          break;
+        }
+        ++cycle;
+        // The link occupancy repeats every II cycles.
+        if (cycle > t_maxCycle or cycle >= m_timing[minTile] + t_II)
+          break;
+      }
+    }
+  }
+}
+
+bool Router::isReached(CGRANode* t_node) {
+  return m_reached[t_node->getID()];
+}
+
+int Router::getDistance(CGRANode* t_node) {
+  return m_distance[t_node->getID()];
+}
+
+int Router::getTiming(CGRANode* t_node) {
+  if (m_reached[t_node->getID()])
+    return m_timing[t_node->getID()];
+  return m_srcCycle +
+      m_srcDFGNode->getExecLatency(t_node->getDVFSLatencyMultiple()) - 1;
+}
+
+CGRANode* Router::getPrevious(CGRANode* t_node) {
+  int previous = m_previous[t_node->getID()];
+  if (previous == -1)
+    return NULL;
+  return m_tiles[previous];
+}
+
+void Router::getRoute(CGRANode* t_dstCGRANode, int t_dstCycle,
+    Route* t_route) {
+  t_route->clear();
+  if (!isReached(t_dstCGRANode))
+    return;
+  t_route->push(t_dstCGRANode, t_dstCycle);
+  CGRANode* u = getPrevious(t_dstCGRANode);
+  while (u != NULL) {
+    t_route->push(u, getTiming(u));
+    u = getPrevious(u);
+  }
+  t_route->order();
+}
+
+RoutingContext::RoutingContext(DFGNode* t_dfgNode, int t_II,
+    int t_maxMappingCycle) {
+  m_dfgNode = t_dfgNode;
+  m_II = t_II;
+  m_maxMappingCycle = t_maxMappingCycle;
+}
+
+RoutingContext::~RoutingContext() {
+  for (Router* router: m_routers) {
+    delete router;
+  }
+}
+
+void RoutingContext::addRouter(Router* t_router) {
+  m_routers.push_back(t_router);
+}
+
+DFGNode* RoutingContext::getDFGNode() {
+  return m_dfgNode;
+}
+
+int RoutingContext::getII() {
+  return m_II;
+}
+
+int RoutingContext::getMaxMappingCycle() {
+  return m_maxMappingCycle;
+}
+
+int RoutingContext::getRouterCount() {
+  return m_routers.size();
+}
+
+Router* RoutingContext::getRouter(int t_index) {
+  return m_routers[t_index];
+}
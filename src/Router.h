@@ -0,0 +1,91 @@
+/*
+ * ======================================================================
+ * Router.h
+ * ======================================================================
+ * Single-source router on the MRRG header file.
+ *
+ * Date : October 16, 2026
+ */
+
+#ifndef Router_H
+#define Router_H
+
+#include "CGRANode.h"
+#include "Route.h"
+#include <vector>
+
+using namespace std;
+
+class CGRA;
+
+// Dijkstra-like search that delivers the output of a mapped DFG node
+// from its tile to the other tiles, waiting on a tile whenever the
+// outgoing link is not available at the current cycle. The search state
+// is kept in dense arrays indexed by the tile ID and the frontier is an
+// indexed binary heap ordered by (distance, tile ID), which pops the
+// tiles in exactly the same order as a linear scan over the row-major
+// tile list would.
+class Router {
+  private:
+    int m_tileCount;
+    vector<CGRANode*> m_tiles;
+    vector<int> m_distance;
+    vector<int> m_timing;
+    vector<int> m_previous;
+    vector<bool> m_reached;
+    vector<int> m_heap;
+    vector<int> m_heapPos;
+    DFGNode* m_srcDFGNode;
+    CGRANode* m_srcCGRANode;
+    int m_srcCycle;
+    bool heapLess(int, int);
+    void heapSiftUp(int);
+    void heapSiftDown(int);
+    void heapPushOrDecrease(int);
+    int heapPop();
+
+  public:
+    Router(CGRA*);
+    // Searches the routes of the output of the given DFG node starting at
+    // the given tile and cycle. The search stops once the destination tile
+    // (if any) is settled.
+    void search(DFGNode*, CGRANode*, int, int, int, CGRANode*);
+    // Whether there is a route to the tile (the source tile is trivially
+    // reached).
+    bool isReached(CGRANode*);
+    int getDistance(CGRANode*);
+    // The cycle the data arrives at the tile, or the cycle the data is
+    // ready on the source tile if the tile is not reached.
+    int getTiming(CGRANode*);
+    CGRANode* getPrevious(CGRANode*);
+    // Fills the route to the tile (traced back to the source tile), the
+    // data being taken on the tile at the given cycle. The route is left
+    // empty if the tile is not reached.
+    void getRoute(CGRANode*, int, Route*);
+};
+
+// Immutable snapshot of one mapping step: the DFG node to be placed, the
+// II and the mapping bound, and the routes of its mapped predecessors
+// captured before the candidate tiles are evaluated. Evaluating a
+// candidate only reads the snapshot and the MRRG, so the candidates can
+// be evaluated concurrently as long as nothing is scheduled meanwhile.
+class RoutingContext {
+  private:
+    DFGNode* m_dfgNode;
+    int m_II;
+    int m_maxMappingCycle;
+    vector<Router*> m_routers;
+
+  public:
+    RoutingContext(DFGNode*, int, int);
+    ~RoutingContext();
+    // Takes the ownership of the router.
+    void addRouter(Router*);
+    DFGNode* getDFGNode();
+    int getII();
+    int getMaxMappingCycle();
+    int getRouterCount();
+    Router* getRouter(int);
+};
+
+#endif
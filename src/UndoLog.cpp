@@ -0,0 +1,102 @@
+/*
+ * ======================================================================
+ * UndoLog.cpp
+ * ======================================================================
+ * Undo journal of the MRRG and mapping implementation.
+ *
+ * Date : October 16, 2026
+ */
+
+#include "UndoLog.h"
+#include "DFGNode.h"
+#include <assert.h>
+#include <algorithm>
+
+UndoLog::UndoLog() {
+}
+
+void UndoLog::recordValue(void* t_field, int t_size) {
+  UndoEntry entry;
+  entry.kind = UNDO_VALUE;
+  entry.size = t_size;
+  entry.target = t_field;
+  entry.key = NULL;
+  memcpy(entry.value, t_field, t_size);
+  m_entries.push_back(entry);
+}
+
+void UndoLog::recordMapped(DFGNode* t_dfgNode) {
+  UndoEntry entry;
+  entry.kind = UNDO_DFG_MAPPED;
+  entry.size = 0;
+  entry.target = t_dfgNode;
+  entry.key = NULL;
+  entry.value[0] = t_dfgNode->isMapped();
+  m_entries.push_back(entry);
+}
+
+void UndoLog::recordInsert(vector<int>* t_index, int t_value) {
+  UndoEntry entry;
+  entry.kind = UNDO_INDEX_INSERT;
+  entry.size = 0;
+  entry.target = t_index;
+  entry.key = NULL;
+  memcpy(entry.value, &t_value, sizeof(int));
+  m_entries.push_back(entry);
+}
+
+void UndoLog::recordErase(vector<int>* t_index, int t_value,
+    int t_position) {
+  UndoEntry entry;
+  entry.kind = UNDO_INDEX_ERASE;
+  entry.size = 0;
+  entry.target = t_index;
+  entry.key = NULL;
+  memcpy(entry.value, &t_value, sizeof(int));
+  memcpy(entry.value + sizeof(int), &t_position, sizeof(int));
+  m_entries.push_back(entry);
+}
+
+int UndoLog::getMark() {
+  return m_entries.size();
+}
+
+// Reverts the writes recorded after the mark, latest first.
+void UndoLog::rollback(int t_mark) {
+  assert(t_mark <= (int)m_entries.size());
+  while ((int)m_entries.size() > t_mark) {
+    UndoEntry& entry = m_entries.back();
+    switch (entry.kind) {
+      case UNDO_VALUE:
+        memcpy(entry.target, entry.value, entry.size);
+        break;
+      case UNDO_DFG_MAPPED:
+        if (entry.value[0])
+          ((DFGNode*)entry.target)->setMapped();
+        else
+          ((DFGNode*)entry.target)->clearMapped();
+        break;
+      case UNDO_INDEX_INSERT: {
+        vector<int>* index = (vector<int>*)entry.target;
+        int value;
+        memcpy(&value, entry.value, sizeof(int));
+        index->erase(find(index->begin(), index->end(), value));
+        break;
+      }
+      case UNDO_INDEX_ERASE: {
+        vector<int>* index = (vector<int>*)entry.target;
+        int value;
+        int position;
+        memcpy(&value, entry.value, sizeof(int));
+        memcpy(&position, entry.value + sizeof(int), sizeof(int));
+        index->insert(index->begin() + position, value);
+        break;
+      }
+    }
+    m_entries.pop_back();
+  }
+}
+
+void UndoLog::clear() {
+  m_entries.clear();
+}
@@ -0,0 +1,66 @@
+/*
+ * ======================================================================
+ * UndoLog.h
+ * ======================================================================
+ * Undo journal of the MRRG and mapping header file.
+ *
+ * Date : October 16, 2026
+ */
+
+#ifndef UndoLog_H
+#define UndoLog_H
+
+#include <vector>
+#include <map>
+#include <cstring>
+
+using namespace std;
+
+class DFGNode;
+class CGRANode;
+
+// Journal of the writes applied to the MRRG (tile and link reservation
+// tables, registers, ctrl-mem counters, DVFS state) and to the mapping.
+// Each write first records how to revert it, so a schedule can be taken
+// back in time proportional to what it changed by rolling back to a mark
+// obtained before the schedule, rather than re-constructing the MRRG and
+// replaying all the schedules before it.
+class UndoLog {
+  private:
+    enum UndoKind {
+      UNDO_VALUE,
+      UNDO_DFG_MAPPED,
+      UNDO_INDEX_INSERT,
+      UNDO_INDEX_ERASE
+    };
+    struct UndoEntry {
+      int kind;
+      int size;
+      void* target;
+      void* key;
+      unsigned char value[16];
+    };
+    vector<UndoEntry> m_entries;
+
+    void recordValue(void*, int);
+
+  public:
+    UndoLog();
+    // Records the current value of the given field, which is restored on
+    // rollback. Only meant for small trivially copyable fields.
+    template<typename T> void record(T* t_field) {
+      static_assert(sizeof(T) <= 16, "field is too large for the undo log");
+      recordValue(t_field, sizeof(T));
+    }
+    void recordMapped(DFGNode*);
+    // Records a node index inserted into (erased from the given position
+    // of) a per-tile index of the mapped nodes, which is taken back on
+    // rollback.
+    void recordInsert(vector<int>*, int);
+    void recordErase(vector<int>*, int, int);
+    int getMark();
+    void rollback(int);
+    void clear();
+};
+
+#endif
@@ -0,0 +1,52 @@
+/*
+ * ======================================================================
+ * cgraMap.cpp
+ * ======================================================================
+ * Standalone mapper without LLVM implementation.
+ *
+ * Maps the DFG written by the pass (i.e., dfg.full.json, dfg.bin, or the
+ * dfg.json of the simulation) with the same param.json, without loading
+ * any LLVM IR:
+ *   cgra-map [dfg.full.json] [param.json]
+ *
+ * The DFG nodes are mapped in the order of the file. Exits with 1 if the
+ * DFG cannot be read or mapped.
+ *
+ * Date : October 16, 2026
+ */
+
+#include <iostream>
+
+#include "DFG.h"
+#include "MappingFlow.h"
+#include "Log.h"
+#include "Profiler.h"
+#include "Counters.h"
+
+int main(int argc, char* argv[]) {
+  string dfgFileName = argc > 1 ? argv[1] : "dfg.full.json";
+  string paramFileName = argc > 2 ? argv[2] : "param.json";
+
+  MappingParam param;
+  readMappingParam(paramFileName, &param);
+  if (param.profile) {
+    Profiler::enable();
+  }
+  Counters::reset();
+
+  DFG* dfg = new DFG(param.precisionAware, param.supportDVFS,
+                     param.DVFSAwareMapping, param.maxCycleCount);
+  {
+    ScopedTimer timer("dfg.read");
+    if (!dfg->loadDFG(dfgFileName)) {
+      cerr<<"Error: cannot read the DFG from "<<dfgFileName<<"\n";
+      return 1;
+    }
+  }
+  CGRA_LOG(LOG_MAPPER, LOG_INFO) << "==================================\n";
+  CGRA_LOG(LOG_MAPPER, LOG_INFO) << "[read DFG of " << dfg->getNodeCount()
+                                 << " nodes from " << dfgFileName << "]\n";
+
+  int II = runMapping(dfg, &param, param.kernel, false);
+  return II == -1 ? 1 : 0;
+}
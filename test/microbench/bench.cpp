@@ -0,0 +1,105 @@
+/*
+ * ======================================================================
+ * bench.cpp
+ * ======================================================================
+ * Microbenchmark of the DFG node classification queried on the hot
+ * paths of the mapper, i.e., CGRANode::canSupport() for every candidate
+ * tile, DFGNode::shareFU() inside CGRANode::canOccupy(), and
+ * DFGNode::getOpcodeName() used by the cost model and the outputs.
+ *
+ * Date : October 16, 2026
+ */
+
+#include "CGRA.h"
+#include "DFGNode.h"
+#include <llvm/IR/LLVMContext.h>
+#include <llvm/IR/Module.h>
+#include <llvm/IRReader/IRReader.h>
+#include <llvm/Support/SourceMgr.h>
+#include <chrono>
+#include <iostream>
+#include <vector>
+
+using namespace std;
+using namespace llvm;
+
+const int kRounds = 2000;
+
+double elapsedNs(chrono::high_resolution_clock::time_point t_start,
+                 long t_calls) {
+  chrono::duration<double, nano> elapsed =
+      chrono::high_resolution_clock::now() - t_start;
+  return elapsed.count() / t_calls;
+}
+
+int main(int argc, char** argv) {
+  if (argc < 2) {
+    cout << "Usage: " << argv[0] << " kernel.bc\n";
+    return 1;
+  }
+  LLVMContext context;
+  SMDiagnostic err;
+  unique_ptr<Module> module = parseIRFile(argv[1], err, context);
+  if (!module) {
+    err.print(argv[0], errs());
+    return 1;
+  }
+
+  vector<DFGNode*> dfgNodes;
+  for (Function& function: *module) {
+    for (BasicBlock& bb: function) {
+      for (Instruction& inst: bb) {
+        dfgNodes.push_back(new DFGNode(dfgNodes.size(), false, &inst,
+                                       inst.getName().str(), false));
+      }
+    }
+  }
+
+  // 4x4 CGRA with the memory accesses only supported by the left column.
+  map<string, list<int>*>* additionalFunc = new map<string, list<int>*>();
+  (*additionalFunc)["load"] = new list<int>{0, 4, 8, 12};
+  (*additionalFunc)["store"] = new list<int>{0, 4, 8, 12};
+  list<string>* fusionStrategy = new list<string>();
+  CGRA* cgra = new CGRA(4, 4, "all", fusionStrategy, false, additionalFunc,
+                        false, 2, false);
+
+  long sink = 0;
+  long calls = 0;
+  auto start = chrono::high_resolution_clock::now();
+  for (int round=0; round<kRounds; ++round) {
+    for (DFGNode* dfgNode: dfgNodes) {
+      for (int i=0; i<cgra->getRows(); ++i) {
+        for (int j=0; j<cgra->getColumns(); ++j) {
+          sink += cgra->nodes[i][j]->canSupport(dfgNode);
+          ++calls;
+        }
+      }
+    }
+  }
+  cout << "canSupport: " << elapsedNs(start, calls) << " ns/call\n";
+
+  calls = 0;
+  start = chrono::high_resolution_clock::now();
+  for (int round=0; round<kRounds; ++round) {
+    for (DFGNode* dfgNode: dfgNodes) {
+      for (DFGNode* otherNode: dfgNodes) {
+        sink += dfgNode->shareFU(otherNode);
+        ++calls;
+      }
+    }
+  }
+  cout << "shareFU: " << elapsedNs(start, calls) << " ns/call\n";
+
+  calls = 0;
+  start = chrono::high_resolution_clock::now();
+  for (int round=0; round<kRounds; ++round) {
+    for (DFGNode* dfgNode: dfgNodes) {
+      sink += dfgNode->getOpcodeName().size();
+      ++calls;
+    }
+  }
+  cout << "getOpcodeName: " << elapsedNs(start, calls) << " ns/call\n";
+
+  cout << "[checksum: " << sink << " over " << dfgNodes.size() << " DFG nodes]\n";
+  return 0;
+}
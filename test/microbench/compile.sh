@@ -0,0 +1,4 @@
+clang-12 -emit-llvm -fno-unroll-loops -O3 -o kernel.bc -c ../kernels/fir/fir.cpp
+clang++-12 -O3 -std=c++17 -fno-rtti -fopenmp $(llvm-config-12 --cppflags) -I../../src -o bench bench.cpp \
+  ../../src/DFGLLVM.cpp ../../build/src/libmapperCore.a \
+  $(llvm-config-12 --ldflags --libs core irreader analysis demangle support)
@@ -0,0 +1,4 @@
+# Reports the average time of the DFG node queries on the hot paths of
+# the mapper. Compare the numbers across revisions of the mapper, e.g.,
+# before and after a change to DFGNode or CGRANode.
+./bench kernel.bc
@@ -0,0 +1,213 @@
+/*
+ * ======================================================================
+ * check.cpp
+ * ======================================================================
+ * Checks DFG::reorderInLongest() against the original path-enumerating
+ * ordering, i.e., the longest simple path searched by a DFS from every
+ * node, followed by the levelling of the other nodes in the order of
+ * their in-degree. Both orderings are applied to the DFG of every
+ * innermost loop of the given kernels, starting from the initial node
+ * order and from the already reordered one.
+ *
+ * Date : October 16, 2026
+ */
+
+#include "DFG.h"
+#include <llvm/Analysis/LoopInfo.h>
+#include <llvm/IR/Dominators.h>
+#include <llvm/IR/LLVMContext.h>
+#include <llvm/IR/Module.h>
+#include <llvm/IRReader/IRReader.h>
+#include <llvm/Support/SourceMgr.h>
+#include <iostream>
+#include <vector>
+
+using namespace std;
+using namespace llvm;
+
+void referenceDFS(set<DFGNode*>* t_visited, list<DFGNode*>* t_targetPath,
+                  list<DFGNode*>* t_curPath, DFGNode* targetDFGNode) {
+  t_visited->insert(targetDFGNode);
+  t_curPath->push_back(targetDFGNode);
+  if (t_curPath->size() > t_targetPath->size()) {
+    t_targetPath->clear();
+    for (DFGNode* node: *t_curPath) {
+      t_targetPath->push_back(node);
+    }
+  }
+  for (DFGNode* succNode: *(targetDFGNode->getSuccNodes())) {
+    if (t_visited->find(succNode) == t_visited->end()) {
+      referenceDFS(t_visited, t_targetPath, t_curPath, succNode);
+      t_visited->erase(succNode);
+      t_curPath->pop_back();
+    }
+  }
+}
+
+bool isMinimumAndHasNotBeenVisited(list<DFGNode*>* t_nodes,
+    set<DFGNode*>* t_visited, map<DFGNode*, int>* t_map, DFGNode* t_node) {
+  if (t_visited->find(t_node) != t_visited->end()) {
+    return false;
+  }
+  for (DFGNode* e_node: *t_nodes) {
+    if (e_node != t_node and t_visited->find(e_node) == t_visited->end() and
+        (*t_map)[e_node] < (*t_map)[t_node]) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// The ordering DFG::reorderInLongest() used to implement.
+void referenceReorderInLongest(list<DFGNode*>* t_nodes) {
+  list<DFGNode*> longestPath;
+  list<DFGNode*> currentPath;
+  set<DFGNode*> visited;
+  map<DFGNode*, int> indegree;
+  for (DFGNode* node: *t_nodes) {
+    indegree[node] = node->getPredNodes()->size();
+    currentPath.clear();
+    visited.clear();
+    referenceDFS(&visited, &longestPath, &currentPath, node);
+  }
+
+  visited.clear();
+  int level = 0;
+  for (DFGNode* node: longestPath) {
+    node->setLevel(level);
+    visited.insert(node);
+    for (DFGNode* succNode: *(node->getSuccNodes())) {
+      indegree[succNode] -= 1;
+    }
+    level += 1;
+  }
+  int maxLevel = level;
+
+  while (visited.size() < t_nodes->size()) {
+    for (DFGNode* node: *t_nodes) {
+      if (isMinimumAndHasNotBeenVisited(t_nodes, &visited, &indegree, node)) {
+        level = 0;
+        for (DFGNode* preNode: *(node->getPredNodes())) {
+          if (level < preNode->getLevel() + 1) {
+            level = preNode->getLevel() + 1;
+          }
+        }
+        node->setLevel(level);
+        if (maxLevel < level) {
+          maxLevel = level;
+        }
+        visited.insert(node);
+        for (DFGNode* succNode: *(node->getSuccNodes())) {
+          indegree[succNode] -= 1;
+        }
+      }
+    }
+  }
+
+  // Unlike the original, the nodes levelled deeper than the longest path
+  // are kept rather than dropped from the DFG.
+  list<DFGNode*> tempNodes;
+  for (int l=0; l<maxLevel+1; ++l) {
+    for (DFGNode* node: *t_nodes) {
+      if (node->getLevel() == l) {
+        tempNodes.push_back(node);
+      }
+    }
+  }
+  *t_nodes = tempNodes;
+}
+
+string describe(list<DFGNode*>* t_nodes) {
+  string order;
+  for (DFGNode* node: *t_nodes) {
+    order += "(" + to_string(node->getID()) + ", level " +
+             to_string(node->getLevel()) + ") ";
+  }
+  return order;
+}
+
+// Applies both orderings to the given starting node order and levels.
+bool checkOrdering(DFG* t_dfg, list<DFGNode*> t_startNodes,
+                   map<DFGNode*, int> t_startLevels) {
+  for (DFGNode* node: t_startNodes) {
+    node->setLevel(t_startLevels[node]);
+  }
+  list<DFGNode*> expected = t_startNodes;
+  referenceReorderInLongest(&expected);
+  string expectedOrder = describe(&expected);
+
+  for (DFGNode* node: t_startNodes) {
+    node->setLevel(t_startLevels[node]);
+  }
+  t_dfg->nodes = t_startNodes;
+  t_dfg->reorderInLongest();
+  string actualOrder = describe(&t_dfg->nodes);
+  if (expectedOrder != actualOrder) {
+    cout << "[expected] " << expectedOrder << "\n";
+    cout << "[actual]   " << actualOrder << "\n";
+    return false;
+  }
+  return true;
+}
+
+int main(int argc, char** argv) {
+  if (argc < 2) {
+    cout << "Usage: " << argv[0] << " kernel.bc...\n";
+    return 1;
+  }
+  int mismatches = 0;
+  for (int i=1; i<argc; ++i) {
+    LLVMContext context;
+    SMDiagnostic err;
+    unique_ptr<Module> module = parseIRFile(argv[i], err, context);
+    if (!module) {
+      err.print(argv[0], errs());
+      return 1;
+    }
+    for (Function& function: *module) {
+      if (function.isDeclaration()) {
+        continue;
+      }
+      DominatorTree dominatorTree(function);
+      LoopInfo loopInfo(dominatorTree);
+      int loopID = 0;
+      for (Loop* loop: loopInfo.getLoopsInPreorder()) {
+        if (!loop->isInnermost()) {
+          continue;
+        }
+        list<Loop*>* targetLoops = new list<Loop*>();
+        targetLoops->push_back(loop);
+        list<string>* fusionStrategy = new list<string>();
+        DFG* dfg = new DFG(function, targetLoops, false, false,
+                           fusionStrategy, new map<string, int>(),
+                           new list<string>(),
+                           new map<string, list<string>*>(), false, false);
+
+        // From the initial order of the instructions, as in DFG::construct().
+        list<DFGNode*> initialNodes = dfg->nodes;
+        initialNodes.sort([](DFGNode* a, DFGNode* b) {
+          return a->getID() < b->getID();
+        });
+        map<DFGNode*, int> initialLevels;
+        map<DFGNode*, int> currentLevels;
+        for (DFGNode* node: dfg->nodes) {
+          initialLevels[node] = 0;
+          currentLevels[node] = node->getLevel();
+        }
+        // From the reordered one, as in DFG::reorderInCriticalFirst().
+        list<DFGNode*> currentNodes = dfg->nodes;
+
+        bool matched = checkOrdering(dfg, initialNodes, initialLevels) and
+                       checkOrdering(dfg, currentNodes, currentLevels);
+        cout << (matched ? "[ordering matched] " : "[ordering mismatched] ")
+             << argv[i] << " " << function.getName().str() << " loop "
+             << loopID << ": " << dfg->getNodeCount() << " nodes\n";
+        if (!matched) {
+          ++mismatches;
+        }
+        ++loopID;
+      }
+    }
+  }
+  return mismatches == 0 ? 0 : 1;
+}
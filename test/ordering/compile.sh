@@ -0,0 +1,11 @@
+for kernel in bicg/bicg.c conv/conv.c dtw/dtw.cpp fft/fft.c fir/fir.cpp gemm/gemm.c \
+    histogram/histogram.cpp latnrm/latnrm.c mvt/mvt.c relu/relu.c spmv/spmv.c; do
+  clang-12 -emit-llvm -O3 -fno-unroll-loops -o $(dirname $kernel).bc -c ../kernels/$kernel
+done
+# The unrolled loops chain several recurrences into long paths.
+for count in 2 4 8; do
+  opt-12 --loop-unroll --unroll-count=$count fir.bc -o fir_unroll$count.bc
+done
+clang++-12 -O3 -std=c++17 -fno-rtti -fopenmp $(llvm-config-12 --cppflags) -I../../src -o check check.cpp \
+  ../../src/DFGLLVM.cpp ../../build/src/libmapperCore.a \
+  $(llvm-config-12 --ldflags --libs core irreader analysis demangle support)
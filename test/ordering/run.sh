@@ -0,0 +1,6 @@
+# Fails if the longest-path node ordering differs from the reference
+# ordering on any innermost loop of the kernels.
+./check *.bc > check.log 2>&1
+status=$?
+grep -a "\[ordering\|\[expected\]\|\[actual\]" check.log
+exit $status
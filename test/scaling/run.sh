@@ -0,0 +1,10 @@
+# Maps the same kernel with an increasing number of OpenMP threads. The
+# candidate tiles of each DFG node are evaluated in parallel, so the
+# mapping algorithm time should drop with more threads while the mapping
+# itself stays the same.
+for threads in 1 2 4 8 16 32; do
+  OMP_NUM_THREADS=$threads opt-12 -load ../../build/src/libmapperPass.so -mapperPass kernel_unroll.bc > trace_$threads.log
+  mv config.json config_$threads.json
+  elapsed=$(grep -aoP 'Mapping algorithm elapsed time=\K[0-9]+' trace_$threads.log)
+  echo "threads: $threads; mapping algorithm elapsed time: ${elapsed}ms"
+done
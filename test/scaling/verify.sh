@@ -0,0 +1,18 @@
+reference_ii=$(grep -aoP '\[Mapping II: \K[^]]+' trace_1.log)
+
+if [ -z "$reference_ii" ]; then
+    echo "Scaling Test Failed! The kernel cannot be mapped with a single thread."
+    exit 1
+fi
+for threads in 2 4 8 16 32; do
+    mapping_ii=$(grep -aoP '\[Mapping II: \K[^]]+' trace_$threads.log)
+    if [ "$mapping_ii" != "$reference_ii" ]; then
+        echo "Scaling Test Failed! The mapping II with $threads threads should be $reference_ii, but got $mapping_ii."
+        exit 1
+    fi
+    if ! cmp -s config_1.json config_$threads.json; then
+        echo "Scaling Test Failed! The mapping with $threads threads differs from the one with a single thread."
+        exit 1
+    fi
+done
+echo "Scaling Test Pass!"
@@ -0,0 +1 @@
+clang-12 -emit-llvm -fno-unroll-loops -O3 -o kernel.bc -c ../kernels/fir/fir.cpp
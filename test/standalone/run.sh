@@ -0,0 +1,9 @@
+# Maps the kernel with the pass, then maps the DFG written by the pass
+# again with the standalone cgra-map (without LLVM), from each of its
+# encodings.
+opt-12 -load ../../build/src/libmapperPass.so -mapperPass kernel.bc > pass.log
+mv config.json pass_config.json
+for dfg in dfg.full.json dfg.bin dfg.json; do
+  ../../build/src/cgra-map $dfg param.json > trace_$dfg.log
+  mv config.json config_$dfg
+done
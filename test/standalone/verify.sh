@@ -0,0 +1,9 @@
+#!/usr/bin/env bash
+
+for dfg in dfg.full.json dfg.bin dfg.json; do
+  if ! cmp -s pass_config.json config_$dfg; then
+    echo "Standalone Mapper Test Fail! config.json mapped from $dfg differs from the one of the pass"
+    exit 1
+  fi
+done
+echo "Standalone Mapper Test Pass! cgra-map reproduces the mapping of the pass"
@@ -0,0 +1,2 @@
+clang-12 -emit-llvm -O3 -fno-unroll-loops -fno-vectorize -o kernel.bc -c ../kernels/fir/fir.cpp
+opt-12 --loop-unroll --unroll-count=4 kernel.bc -o kernel_unroll.bc
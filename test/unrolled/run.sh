@@ -0,0 +1 @@
+opt-12 -load ../../build/src/libmapperPass.so -mapperPass kernel_unroll.bc | tee trace.log
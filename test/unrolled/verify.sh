@@ -0,0 +1,17 @@
+#!/usr/bin/env bash
+
+# The FIR loop unrolled by 4 has to map (with the expandable mapping on)
+# at an II close to the one of the rolled loop, rather than climbing II
+# after II until the mapping runs out of memory.
+max_ii=8
+mapping_success=$(grep -ao '\[Mapping Success\]' trace.log | wc -l)
+mapping_ii=$(grep -aoP '\[Mapping II: \K[^]]+' trace.log)
+
+if [ "$mapping_success" -eq 1 ] && [ "$mapping_ii" -le "$max_ii" ]; then
+    echo "Unrolled Mapping Test Pass! II: $mapping_ii"
+else
+    echo "Unrolled Mapping Test Fail! Expected a mapping within II $max_ii."
+    echo "mapping_success: $mapping_success"
+    echo "mapping_ii: $mapping_ii"
+    exit 1
+fi